@@ -310,12 +310,23 @@ def addCommonOptions(parser):
                       help="Enable basic block profiling for SimPoints")
     parser.add_option("--simpoint-interval", type="int", default=10000000,
                       help="SimPoint interval in num of instructions")
+    parser.add_option("--simpoint-binary", action="store_true",
+                      help="Write the SimPoint BBVs in binary format")
+    parser.add_option("--simpoint-clusters", type="int", default=0,
+                      help="""Select SimPoints online, clustering the
+                              intervals in this many clusters""")
     parser.add_option("--take-simpoint-checkpoints", action="store", type="string",
         help="<simpoint file,weight file,interval-length,warmup-length>")
     parser.add_option("--restore-simpoint-checkpoint", action="store_true",
         help="restore from a simpoint checkpoint taken with " +
              "--take-simpoint-checkpoints")
 
+    # Branch trace options
+    parser.add_option("--branch-trace", action="store", type="string",
+                      help="""Record the committed branches of a simple CPU
+                              in the given file, for replay with
+                              configs/example/bpred_replay.py""")
+
     # Checkpointing options
     ###Note that performing checkpointing via python script files will override
     ###checkpoint instructions built into binaries.
@@ -350,6 +361,10 @@ def addCommonOptions(parser):
     parser.add_option("-s", "--standard-switch", action="store", type="int",
         default=None,
         help="switch from timing to Detailed CPU after warmup period of <N>")
+    parser.add_option("--switch-keeps-tlbs", action="store_true",
+        default=False,
+        help="Hand the TLB contents over on CPU switches instead of "
+             "flushing them")
     parser.add_option("-p", "--prog-interval", type="str",
         help="CPU Progress Interval")
 
@@ -362,6 +377,10 @@ def addCommonOptions(parser):
     parser.add_option("-F", "--fast-forward", action="store", type="string",
         default=None,
         help="Number of instructions to fast forward before switching")
+    parser.add_option("--functional-warming", action="store_true",
+        default=False,
+        help="Train the branch predictor of the switched-in CPU and serve "
+             "cache hits through direct calls while fast forwarding")
     parser.add_option("-S", "--simpoint", action="store_true", default=False,
         help="""Use workload simpoints as an instruction offset for
                 --checkpoint-restore or --take-checkpoint.""")
@@ -429,6 +448,12 @@ def addSEOptions(parser):
                            "to/host/dir1 --redirects /dir2=/path/to/host/dir2")
     parser.add_option("--wait-gdb", default=False,
                       help="Wait for remote GDB to connect.")
+    parser.add_option("--parallel-se", action="store_true", default=False,
+                      help="Simulate each (atomic) CPU on its own event "
+                           "queue and host thread")
+    parser.add_option("--sim-quantum", type="string", default="10us",
+                      help="Simulation quantum of the parallel simulation "
+                           "(default: %default)")
 
 
 
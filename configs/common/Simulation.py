@@ -488,6 +488,16 @@ def run(options, root, testsys, cpu_class):
                     options.indirect_bp_type)
                 switch_cpus[i].branchPred.indirectBranchPred = \
                     IndirectBPClass()
+            if options.functional_warming:
+                if not isinstance(testsys.cpu[i], AtomicSimpleCPU):
+                    fatal("--functional-warming requires fast forwarding "
+                          "with the atomic CPU")
+                if isinstance(switch_cpus[i].branchPred, BranchPredictor):
+                    testsys.cpu[i].warm_branch_pred = \
+                        switch_cpus[i].branchPred
+                if options.caches:
+                    testsys.cpu[i].warm_icache = testsys.cpu[i].icache
+                    testsys.cpu[i].warm_dcache = testsys.cpu[i].dcache
 
         # If elastic tracing is enabled attach the elastic trace probe
         # to the switch CPUs
@@ -585,6 +595,11 @@ def run(options, root, testsys, cpu_class):
             (switch_cpus[i], switch_cpus_1[i]) for i in range(np)
         ]
 
+    if options.switch_keeps_tlbs:
+        for obj in testsys.descendants():
+            if isinstance(obj, BaseCPU):
+                obj.switch_keeps_tlbs = True
+
     # set the checkpoint in the cpu before m5.instantiate is called
     if options.take_checkpoints != None and \
            (options.simpoint or options.at_instruction):
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Replays a branch trace recorded with the --branch-trace option of se.py
+# or fs.py against one or more branch predictors, without simulating a
+# CPU, and reports the MPKI and host throughput of each predictor.
+#
+# Every --bp option adds a predictor configuration: a BranchPredictor
+# class name, optionally followed by a colon and a comma-separated list
+# of parameter assignments. Parameters of child objects are reached with
+# dotted paths, e.g.
+#
+#   --bp TAGE_SC_L_64KB --bp LTAGE:tage.nHistoryTables=10
+#
+# With --jobs N the configurations are spread over N forked simulator
+# processes that replay the trace in parallel. Each process writes its
+# statistics to its own output directory, job<N> in the output directory.
+
+import argparse
+import os
+import sys
+
+import m5
+from m5.objects import *
+from m5.util import addToPath, fatal
+
+addToPath('../')
+
+from common import ObjectList
+
+parser = argparse.ArgumentParser(
+    description="Replay a branch trace against branch predictors")
+parser.add_argument("trace", help="Branch trace to replay")
+parser.add_argument("--bp", action="append", default=[],
+                    metavar="TYPE[:PARAM=VALUE,...]",
+                    help="Branch predictor configuration to evaluate "
+                         "(can be given several times)")
+parser.add_argument("--list-bp-types", action="store_true",
+                    help="List available branch predictor types")
+parser.add_argument("-j", "--jobs", type=int, default=1,
+                    help="Number of simulator processes to replay with")
+parser.add_argument("--max-branches", type=int, default=0,
+                    help="Number of branches to replay, 0 for all")
+
+args = parser.parse_args()
+
+if args.list_bp_types:
+    ObjectList.bp_list.print()
+    sys.exit(0)
+
+if not args.bp:
+    fatal("No branch predictor given, use --bp")
+
+if args.jobs < 1:
+    fatal("--jobs must be at least 1")
+
+def create_bp(config):
+    bp_type, _, assignments = config.partition(':')
+    bp = ObjectList.bp_list.get(bp_type)()
+    for assignment in filter(None, assignments.split(',')):
+        path, sep, value = assignment.partition('=')
+        if not sep:
+            fatal("Malformed parameter assignment '%s'" % assignment)
+        obj = bp
+        names = path.split('.')
+        for name in names[:-1]:
+            obj = getattr(obj, name)
+        setattr(obj, names[-1], value)
+    return bp
+
+def replay(configs):
+    for i, config in enumerate(configs):
+        print("predictors%d: %s" % (i, config))
+
+    root = Root(full_system=False)
+    root.replay = BranchTraceReplay(
+        trace_file=args.trace,
+        max_branches=args.max_branches,
+        predictors=[create_bp(config) for config in configs])
+
+    m5.instantiate()
+    exit_event = m5.simulate()
+    print('Exiting @ tick %i because %s' %
+          (m5.curTick(), exit_event.getCause()))
+
+# Deal the configurations out to the jobs, a process can only instantiate
+# a single simulated system.
+jobs = [ args.bp[i::args.jobs] for i in range(min(args.jobs, len(args.bp))) ]
+
+if len(jobs) == 1:
+    replay(jobs[0])
+    sys.exit(0)
+
+children = []
+for i, configs in enumerate(jobs):
+    sys.stdout.flush()
+    pid = os.fork()
+    if pid == 0:
+        m5.options.outdir = os.path.join(m5.options.outdir, "job%d" % i)
+        if not os.path.isdir(m5.options.outdir):
+            os.makedirs(m5.options.outdir)
+        m5.core.setOutputDir(m5.options.outdir)
+        replay(configs)
+        sys.exit(0)
+    children.append(pid)
+
+failed = 0
+for pid in children:
+    _, status = os.waitpid(pid, 0)
+    if status != 0:
+        failed += 1
+
+if failed:
+    fatal("%d of %d replay jobs failed" % (failed, len(children)))
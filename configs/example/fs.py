@@ -189,9 +189,19 @@ def build_test_system(np):
             if np > 1:
                 fatal("SimPoint generation not supported with more than one CPUs")
 
+        if options.branch_trace:
+            if not issubclass(TestCPUClass, BaseSimpleCPU):
+                fatal("Branch tracing requires a simple CPU")
+            if np > 1:
+                fatal("Branch tracing not supported with more than one CPUs")
+
         for i in range(np):
             if options.simpoint_profile:
-                test_sys.cpu[i].addSimPointProbe(options.simpoint_interval)
+                test_sys.cpu[i].addSimPointProbe(options.simpoint_interval,
+                    binary_profile=options.simpoint_binary,
+                    clusters=options.simpoint_clusters)
+            if options.branch_trace:
+                test_sys.cpu[i].addBranchTraceProbe(options.branch_trace)
             if options.checker:
                 test_sys.cpu[i].addCheckerCpu()
             if not ObjectList.is_kvm_cpu(TestCPUClass):
@@ -226,7 +226,9 @@ for i in range(np):
         system.cpu[i].workload = multiprocesses[i]
 
     if options.simpoint_profile:
-        system.cpu[i].addSimPointProbe(options.simpoint_interval)
+        system.cpu[i].addSimPointProbe(options.simpoint_interval,
+            binary_profile=options.simpoint_binary,
+            clusters=options.simpoint_clusters)
 
     if options.checker:
         system.cpu[i].addCheckerCpu()
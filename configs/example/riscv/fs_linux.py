@@ -215,7 +215,9 @@ if options.simpoint_profile:
 
 for i in range(np):
     if options.simpoint_profile:
-        system.cpu[i].addSimPointProbe(options.simpoint_interval)
+        system.cpu[i].addSimPointProbe(options.simpoint_interval,
+            binary_profile=options.simpoint_binary,
+            clusters=options.simpoint_clusters)
     if options.checker:
         system.cpu[i].addCheckerCpu()
     if not ObjectList.is_kvm_cpu(CPUClass):
@@ -217,6 +217,12 @@ if options.simpoint_profile:
     if np > 1:
         fatal("SimPoint generation not supported with more than one CPUs")
 
+if options.branch_trace:
+    if not issubclass(CPUClass, BaseSimpleCPU):
+        fatal("Branch tracing requires a simple CPU")
+    if np > 1:
+        fatal("Branch tracing not supported with more than one CPUs")
+
 for i in range(np):
     if options.smt:
         system.cpu[i].workload = multiprocesses
@@ -226,7 +232,12 @@ for i in range(np):
         system.cpu[i].workload = multiprocesses[i]
 
     if options.simpoint_profile:
-        system.cpu[i].addSimPointProbe(options.simpoint_interval)
+        system.cpu[i].addSimPointProbe(options.simpoint_interval,
+            binary_profile=options.simpoint_binary,
+            clusters=options.simpoint_clusters)
+
+    if options.branch_trace:
+        system.cpu[i].addBranchTraceProbe(options.branch_trace)
 
     if options.checker:
         system.cpu[i].addCheckerCpu()
@@ -270,5 +281,32 @@ if options.wait_gdb:
     for cpu in system.cpu:
         cpu.wait_for_remote_gdb = True
 
+if options.parallel_se:
+    if not issubclass(CPUClass, AtomicSimpleCPU) or options.ruby:
+        fatal("Parallel SE mode requires an atomic CPU and the classic "
+              "memory system")
+    if FutureClass or options.standard_switch or options.repeat_switch:
+        fatal("Parallel SE mode doesn't support switching CPUs")
+    # Give each CPU its own event queue, along with the TLBs and MMU it
+    # translates with and that are flushed from that queue. The caches,
+    # the interrupt controllers and the workload are also accessed from
+    # the memory system and the other cores, so they stay on the queue of
+    # the memory system. The CPU serves the hits in its L1 caches itself,
+    # without synchronizing with the other cores.
+    for i, cpu in enumerate(system.cpu):
+        for obj in cpu.descendants():
+            obj.eventq_index = i + 1
+        for obj in cpu.descendants():
+            if isinstance(obj, (BaseCache, BaseInterrupts, Process)):
+                for child in obj.descendants():
+                    child.eventq_index = 0
+
+        if options.caches:
+            cpu.warm_icache = cpu.icache
+            cpu.warm_dcache = cpu.dcache
+
 root = Root(full_system = False, system = system)
+if options.parallel_se:
+    root.sim_quantum = \
+        m5.ticks.fromSeconds(m5.util.convert.anyToLatency(options.sim_quantum))
 Simulation.run(options, root, system, FutureClass)
@@ -80,8 +80,9 @@ class Decoder : public InstDecoder
 
     Enums::DecoderFlavor decoderFlavor;
 
-    /// A cache of decoded instruction objects.
-    static GenericISA::BasicDecodeCache<Decoder, ExtMachInst> defaultCache;
+    /// A cache of decoded instruction objects. Each decoder has its own,
+    /// as cores may be simulated by separate host threads.
+    GenericISA::BasicDecodeCache<Decoder, ExtMachInst> defaultCache;
 
     /**
      * Pre-decode an instruction from the current state of the
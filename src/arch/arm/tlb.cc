@@ -505,6 +505,25 @@ TLB::takeOverFrom(BaseTLB *_otlb)
     }
 }
 
+void
+TLB::takeOverEntriesFrom(BaseTLB *_otlb)
+{
+    TLB *otlb = dynamic_cast<TLB*>(_otlb);
+    panic_if(!otlb, "Incompatible TLB type!");
+
+    // The table is kept in MRU order, so the most recently used
+    // entries survive if we are the smaller TLB.
+    for (int i = 0; i < size; ++i) {
+        if (i < otlb->size)
+            table[i] = otlb->table[i];
+        else
+            table[i].valid = false;
+    }
+
+    if (!isStage2 && stage2Tlb && otlb->stage2Tlb)
+        stage2Tlb->takeOverEntriesFrom(otlb->stage2Tlb);
+}
+
 TLB::TlbStats::TlbStats(Stats::Group *parent)
   : Stats::Group(parent),
     ADD_STAT(instHits, UNIT_COUNT, "ITB inst hits"),
@@ -226,6 +226,7 @@ class TLB : public BaseTLB
     virtual ~TLB();
 
     void takeOverFrom(BaseTLB *otlb) override;
+    void takeOverEntriesFrom(BaseTLB *otlb) override;
 
     /// setup all the back pointers
     void init() override;
@@ -83,18 +83,24 @@ copyRegs(ThreadContext *src, ThreadContext *dest)
     for (int i = 0; i < NumCCRegs; i++)
         dest->setCCReg(i, src->readCCReg(i));
 
+    copyVecRegs(src, dest);
+
+    copyMiscRegs(src, dest);
+
+    // Copy over the PC State
+    dest->pcState(src->pcState());
+}
+
+void
+copyMiscRegs(ThreadContext *src, ThreadContext *dest)
+{
     for (int i = 0; i < NumMiscRegs; i++)
         dest->setMiscRegNoEffect(i, src->readMiscRegNoEffect(i));
 
-    copyVecRegs(src, dest);
-
     // setMiscReg "with effect" will set the misc register mapping correctly.
     // e.g. updateRegMap(val)
     dest->setMiscReg(MISCREG_CPSR, src->readMiscRegNoEffect(MISCREG_CPSR));
 
-    // Copy over the PC State
-    dest->pcState(src->pcState());
-
     // Invalidate the tlb misc register cache
     static_cast<MMU *>(dest->getMMUPtr())->invalidateMiscReg();
 }
@@ -93,12 +93,7 @@ testPredicate(uint32_t nz, uint32_t c, uint32_t v, ConditionCode code)
 }
 
 void copyRegs(ThreadContext *src, ThreadContext *dest);
-
-static inline void
-copyMiscRegs(ThreadContext *src, ThreadContext *dest)
-{
-    panic("Copy Misc. Regs Not Implemented Yet\n");
-}
+void copyMiscRegs(ThreadContext *src, ThreadContext *dest);
 
 /** Send an event (SEV) to a specific PE if there isn't
  * already a pending event */
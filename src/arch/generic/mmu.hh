@@ -105,6 +105,14 @@ class BaseMMU : public SimObject
 
     virtual void takeOverFrom(BaseMMU *old_mmu);
 
+    /** Take over the translations cached by the TLBs of old_mmu */
+    void
+    takeOverEntriesFrom(BaseMMU *old_mmu)
+    {
+        itb->takeOverEntriesFrom(old_mmu->itb);
+        dtb->takeOverEntriesFrom(old_mmu->dtb);
+    }
+
   public:
     BaseTLB* dtb;
     BaseTLB* itb;
@@ -125,6 +125,14 @@ class BaseTLB : public SimObject
      */
     virtual void takeOverFrom(BaseTLB *otlb) = 0;
 
+    /**
+     * Take over the translations cached by an old tlb, replacing any
+     * of our own. TLBs that do not implement this are left as they
+     * are, which is empty in a CPU that was switched out with its TLBs
+     * flushed.
+     */
+    virtual void takeOverEntriesFrom(BaseTLB *otlb) {}
+
     /**
      * Get the table walker port if present. This is used for
      * migrating port connections during a CPU takeOverFrom()
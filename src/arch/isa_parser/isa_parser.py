@@ -264,11 +264,13 @@ class GenCode(object):
     # interwoven by the write_top_level_files().
     def emit(self):
         if self.header_output:
-            self.parser.get_file('header').write(self.header_output)
+            self.parser.get_file('header').write(
+                    self.parser.declareSimpleExecute(self.header_output))
         if self.decoder_output:
             self.parser.get_file('decoder').write(self.decoder_output)
         if self.exec_output:
-            self.parser.get_file('exec').write(self.exec_output)
+            self.parser.get_file('exec').write(
+                    self.parser.defineSimpleExecute(self.exec_output))
         if self.decode_block:
             self.parser.get_file('decode_block').write(self.decode_block)
 
@@ -482,10 +484,16 @@ class InstObjParams(object):
 #
 
 class ISAParser(Grammar):
-    def __init__(self, output_dir):
+    def __init__(self, output_dir, specialize_simple_exec=False):
         super(ISAParser, self).__init__()
         self.output_dir = output_dir
 
+        # Generate execute() variants specialized for the simple CPUs'
+        # SimpleExecContext, and the names of the instruction classes
+        # that declare one so far.
+        self.specializeSimpleExec = specialize_simple_exec
+        self.simpleExecClasses = set()
+
         self.filename = None # for output file watermarking/scaremongering
 
         # variable to hold templates
@@ -528,6 +536,86 @@ class ISAParser(Grammar):
 
         self.maxMiscDestRegs = 0
 
+    #####################################################################
+    #
+    #          Execute variants specialized for the simple CPUs
+    #
+    # With specialize_simple_exec, every instruction class using the
+    # usual execute() declaration gets an executeSimple() twin.  Its code
+    # is a copy of execute()'s, but it takes the final SimpleExecContext
+    # instead of an ExecContext, so the register accesses inline into the
+    # simple CPUs' register file.  The twin is registered with StaticInst,
+    # and a member initializer of the class looks it up while the
+    # instruction is constructed, for StaticInst::simpleExecute() to hand
+    # it out.  Classes without one (templates, hand written execute()s)
+    # keep going through the virtual execute().
+
+    simpleExecDeclRE = re.compile(
+        r'^(?P<indent>[ \t]*)Fault execute\(ExecContext \*, '
+        r'Trace::InstRecord \*\) const(?: override)?;[ \t]*$', re.MULTILINE)
+    simpleExecClassRE = re.compile(r'\b(?:class|struct)\s+(\w+(?:::\w+)*)')
+    simpleExecDefRE = re.compile(
+        r'(?<![\w>:])(?P<class_name>\w+(?:::\w+)*)::execute\(\s*'
+        r'ExecContext \*xc,\s*Trace::InstRecord \*traceData\)\s*const\s*\{')
+
+    simpleExecDecl = '''
+%(indent)sFault executeSimple(SimpleExecContext *, Trace::InstRecord *) const;
+%(indent)sstatic const bool simpleExecuteRegistered;
+%(indent)sconst bool simpleExecuteSet = setSimpleExecute(typeid(*this));'''
+
+    simpleExecDef = '''
+
+Fault
+%(class_name)s::executeSimple(SimpleExecContext *xc,
+        Trace::InstRecord *traceData) const
+%(code)s
+
+const bool %(class_name)s::simpleExecuteRegistered =
+    StaticInst::registerSimpleExecute(typeid(%(class_name)s),
+        [](const StaticInst *si, SimpleExecContext *xc,
+           Trace::InstRecord *traceData) {
+            return static_cast<const %(class_name)s *>(si)->executeSimple(
+                    xc, traceData);
+        });
+'''
+
+    # Declare executeSimple() next to execute() in header output.
+    def declareSimpleExecute(self, code):
+        if not self.specializeSimpleExec:
+            return code
+
+        def declare(m):
+            classes = self.simpleExecClassRE.findall(code, 0, m.start())
+            if not classes:
+                return m.group(0)
+            self.simpleExecClasses.add(classes[-1])
+            return m.group(0) + self.simpleExecDecl % m.groupdict()
+
+        return self.simpleExecDeclRE.sub(declare, code)
+
+    # Define executeSimple() after the definition of execute() in exec
+    # output, for the classes that declared it.
+    def defineSimpleExecute(self, code):
+        if not self.specializeSimpleExec:
+            return code
+
+        chunks = []
+        pos = 0
+        for m in self.simpleExecDefRE.finditer(code):
+            class_name = m.group('class_name')
+            if m.start() < pos or class_name not in self.simpleExecClasses:
+                continue
+            start = m.end() - 1
+            end = matchingBrace(code, start)
+            if end is None:
+                continue
+            chunks.append(code[pos:end + 1])
+            chunks.append(self.simpleExecDef % {
+                'class_name': class_name, 'code': code[start:end + 1] })
+            pos = end + 1
+        chunks.append(code[pos:])
+        return ''.join(chunks)
+
     def operandsRE(self):
         if not self._operandsRE:
             self.buildOperandREs()
@@ -665,6 +753,8 @@ class ISAParser(Grammar):
                 assert(fn in self.files)
                 f.write('#include "%s"\n' % fn)
                 f.write('#include "cpu/exec_context.hh"\n')
+                if self.specializeSimpleExec:
+                    f.write('#include "cpu/simple/exec_context.hh"\n')
                 f.write('#include "decoder.hh"\n')
 
                 fn = 'exec-ns.cc.inc'
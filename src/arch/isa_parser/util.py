@@ -58,6 +58,30 @@ stringRE = re.compile(r'"([^"\\]|\\.)*"')
 commentRE = re.compile(r'(^)?[^\S\n]*/(?:\*(.*?)\*/[^\S\n]*|/[^\n]*)($)?',
         re.DOTALL | re.MULTILINE)
 
+# Regular expression object to match the C++ tokens that can hide
+# braces: comments, string and character literals (used in
+# matchingBrace())
+braceSkipRE = re.compile(r'//[^\n]*|/\*.*?\*/|"(?:[^"\\]|\\.)*"|'
+                         r"'(?:[^'\\]|\\.)*'|[{}]", re.DOTALL)
+
+#
+# Find the brace closing the block opened by the brace at index 'pos'
+# of the C++ code in 'code'.  Returns the index of the closing brace,
+# or None if the block is not closed.
+#
+def matchingBrace(code, pos):
+    assert code[pos] == '{'
+    depth = 0
+    for m in braceSkipRE.finditer(code, pos):
+        token = m.group(0)
+        if token == '{':
+            depth += 1
+        elif token == '}':
+            depth -= 1
+            if depth == 0:
+                return m.start()
+    return None
+
 # Regular expression object to match assignment statements (used in
 # findOperands()).  If the code immediately following the first
 # appearance of the operand matches this regex, then the operand
@@ -87,8 +87,9 @@ class Decoder : public InstDecoder
     void takeOverFrom(Decoder *old) {}
 
   protected:
-    /// A cache of decoded instruction objects.
-    static GenericISA::BasicDecodeCache<Decoder, ExtMachInst> defaultCache;
+    /// A cache of decoded instruction objects. Each decoder has its own,
+    /// as cores may be simulated by separate host threads.
+    GenericISA::BasicDecodeCache<Decoder, ExtMachInst> defaultCache;
 
   public:
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
@@ -220,8 +220,7 @@ copyRegs(ThreadContext *src, ThreadContext *dest)
     assert(NumCCRegs == 0);
 
     // Copy misc. registers
-    for (int i = 0; i < NumMiscRegs; i++)
-        dest->setMiscRegNoEffect(i, src->readMiscRegNoEffect(i));
+    copyMiscRegs(src, dest);
 
     // Copy over the PC State
     dest->pcState(src->pcState());
@@ -230,7 +229,8 @@ copyRegs(ThreadContext *src, ThreadContext *dest)
 void
 copyMiscRegs(ThreadContext *src, ThreadContext *dest)
 {
-    panic("Copy Misc. Regs Not Implemented Yet\n");
+    for (int i = 0; i < NumMiscRegs; i++)
+        dest->setMiscRegNoEffect(i, src->readMiscRegNoEffect(i));
 }
 
 } // namespace MipsISA
@@ -162,7 +162,7 @@ RemoteGDB::acc(Addr va, size_t len)
     // port proxy to read/writeBlob.  I (bgs) am not convinced the first byte
     // check is enough.
     panic_if(FullSystem, "acc not implemented for POWER FS!");
-    return context()->getProcessPtr()->pTable->lookup(va) != nullptr;
+    return context()->getProcessPtr()->pTable->translate(va);
 }
 
 void
@@ -177,7 +177,7 @@ RemoteGDB::acc(Addr va, size_t len)
         return true;
     }
 
-    return context()->getProcessPtr()->pTable->lookup(va) != nullptr;
+    return context()->getProcessPtr()->pTable->translate(va);
 }
 
 void
@@ -436,20 +436,21 @@ TLB::translateFunctional(const RequestPtr &req, ThreadContext *tc, Mode mode)
     }
     else {
         Process *process = tc->getProcessPtr();
-        const auto *pte = process->pTable->lookup(vaddr);
+        EmulationPageTable::Entry pte;
+        bool mapped = process->pTable->lookup(vaddr, pte);
 
-        if (!pte && mode != Execute) {
+        if (!mapped && mode != Execute) {
             // Check if we just need to grow the stack.
             if (process->fixupFault(vaddr)) {
                 // If we did, lookup the entry for the new page.
-                pte = process->pTable->lookup(vaddr);
+                mapped = process->pTable->lookup(vaddr, pte);
             }
         }
 
-        if (!pte)
+        if (!mapped)
             return std::make_shared<GenericPageTableFault>(req->getVaddr());
 
-        paddr = pte->paddr | process->pTable->pageOffset(vaddr);
+        paddr = pte.paddr | process->pTable->pageOffset(vaddr);
     }
 
     DPRINTF(TLB, "Translated (functional) %#x -> %#x.\n", vaddr, paddr);
@@ -107,6 +107,11 @@ buildRetPC(const PCState &curPC, const PCState &callPC)
     return retPC;
 }
 
+inline void
+copyMiscRegs(ThreadContext *src, ThreadContext *dest)
+{
+}
+
 inline void
 copyRegs(ThreadContext *src, ThreadContext *dest)
 {
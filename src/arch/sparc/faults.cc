@@ -625,8 +625,9 @@ FastInstructionAccessMMUMiss::invoke(ThreadContext *tc,
     }
 
     Process *p = tc->getProcessPtr();
-    const EmulationPageTable::Entry *pte = p->pTable->lookup(vaddr);
-    panic_if(!pte, "Tried to execute unmapped address %#x.\n", vaddr);
+    EmulationPageTable::Entry pte;
+    bool mapped = p->pTable->lookup(vaddr, pte);
+    panic_if(!mapped, "Tried to execute unmapped address %#x.\n", vaddr);
 
     Addr alignedvaddr = p->pTable->pageAlign(vaddr);
 
@@ -658,9 +659,9 @@ FastInstructionAccessMMUMiss::invoke(ThreadContext *tc,
     // the logic works out to the following for the context.
     int context_id = (is_real_address || trapped) ? 0 : primary_context;
 
-    TlbEntry entry(p->pTable->pid(), alignedvaddr, pte->paddr,
-                   pte->flags & EmulationPageTable::Uncacheable,
-                   pte->flags & EmulationPageTable::ReadOnly);
+    TlbEntry entry(p->pTable->pid(), alignedvaddr, pte.paddr,
+                   pte.flags & EmulationPageTable::Uncacheable,
+                   pte.flags & EmulationPageTable::ReadOnly);
 
     // Insert the TLB entry.
     // The entry specifying whether the address is "real" is set to
@@ -681,10 +682,11 @@ FastDataAccessMMUMiss::invoke(ThreadContext *tc, const StaticInstPtr &inst)
     }
 
     Process *p = tc->getProcessPtr();
-    const EmulationPageTable::Entry *pte = p->pTable->lookup(vaddr);
-    if (!pte && p->fixupFault(vaddr))
-        pte = p->pTable->lookup(vaddr);
-    panic_if(!pte, "Tried to access unmapped address %#x.\n", vaddr);
+    EmulationPageTable::Entry pte;
+    bool mapped = p->pTable->lookup(vaddr, pte);
+    if (!mapped && p->fixupFault(vaddr))
+        mapped = p->pTable->lookup(vaddr, pte);
+    panic_if(!mapped, "Tried to access unmapped address %#x.\n", vaddr);
 
     Addr alignedvaddr = p->pTable->pageAlign(vaddr);
 
@@ -746,9 +748,9 @@ FastDataAccessMMUMiss::invoke(ThreadContext *tc, const StaticInstPtr &inst)
     // The partition id distinguishes between virtualized environments.
     int const partition_id = 0;
 
-    TlbEntry entry(p->pTable->pid(), alignedvaddr, pte->paddr,
-                   pte->flags & EmulationPageTable::Uncacheable,
-                   pte->flags & EmulationPageTable::ReadOnly);
+    TlbEntry entry(p->pTable->pid(), alignedvaddr, pte.paddr,
+                   pte.flags & EmulationPageTable::Uncacheable,
+                   pte.flags & EmulationPageTable::ReadOnly);
 
     // Insert the TLB entry.
     // The entry specifying whether the address is "real" is set to
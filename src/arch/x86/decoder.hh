@@ -239,7 +239,7 @@ class Decoder : public InstDecoder
     DecodeCache::InstMap<ExtMachInst> *instMap = nullptr;
     typedef std::unordered_map<
             CacheKey, DecodeCache::InstMap<ExtMachInst> *> InstCacheMap;
-    static InstCacheMap instCacheMap;
+    InstCacheMap instCacheMap;
 
   public:
     Decoder(ISA *isa=nullptr)
@@ -84,7 +84,7 @@ RemoteGDB::acc(Addr va, size_t len)
                                         BaseTLB::Read);
         return fault == NoFault;
     } else {
-        return context()->getProcessPtr()->pTable->lookup(va) != nullptr;
+        return context()->getProcessPtr()->pTable->translate(va);
     }
 }
 
@@ -37,8 +37,10 @@
 
 #include "arch/x86/tlb.hh"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
+#include <vector>
 
 #include "arch/x86/faults.hh"
 #include "arch/x86/insts/microldstop.hh"
@@ -139,6 +141,28 @@ TLB::flushAll()
     }
 }
 
+void
+TLB::takeOverEntriesFrom(BaseTLB *_otlb)
+{
+    TLB *otlb = dynamic_cast<TLB *>(_otlb);
+    panic_if(!otlb, "Incompatible TLB type!");
+
+    flushAll();
+
+    // Insert the old entries from the least to the most recently used
+    // one so that they keep their LRU order here.
+    std::vector<const TlbEntry *> entries;
+    for (const auto &entry : otlb->tlb) {
+        if (entry.trieHandle)
+            entries.push_back(&entry);
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const TlbEntry *a, const TlbEntry *b)
+              { return a->lruSeq < b->lruSeq; });
+    for (const auto *entry : entries)
+        insert(entry->vaddr, *entry);
+}
+
 void
 TLB::setConfigAddress(uint32_t addr)
 {
@@ -397,19 +421,19 @@ TLB::translate(const RequestPtr &req,
                     assert(entry);
                 } else {
                     Process *p = tc->getProcessPtr();
-                    const EmulationPageTable::Entry *pte =
-                        p->pTable->lookup(vaddr);
-                    if (!pte) {
+                    EmulationPageTable::Entry pte;
+                    bool mapped = p->pTable->lookup(vaddr, pte);
+                    if (!mapped) {
                         return std::make_shared<PageFault>(vaddr, true, mode,
                                                            true, false);
                     } else {
                         Addr alignedVaddr = p->pTable->pageAlign(vaddr);
                         DPRINTF(TLB, "Mapping %#x to %#x\n", alignedVaddr,
-                                pte->paddr);
+                                pte.paddr);
                         entry = insert(alignedVaddr, TlbEntry(
-                                p->pTable->pid(), alignedVaddr, pte->paddr,
-                                pte->flags & EmulationPageTable::Uncacheable,
-                                pte->flags & EmulationPageTable::ReadOnly));
+                                p->pTable->pid(), alignedVaddr, pte.paddr,
+                                pte.flags & EmulationPageTable::Uncacheable,
+                                pte.flags & EmulationPageTable::ReadOnly));
                     }
                     DPRINTF(TLB, "Miss was serviced.\n");
                 }
@@ -478,20 +502,21 @@ TLB::translateFunctional(const RequestPtr &req, ThreadContext *tc, Mode mode)
         paddr = insertBits(addr, logBytes - 1, 0, vaddr);
     } else {
         Process *process = tc->getProcessPtr();
-        const auto *pte = process->pTable->lookup(vaddr);
+        EmulationPageTable::Entry pte;
+        bool mapped = process->pTable->lookup(vaddr, pte);
 
-        if (!pte && mode != Execute) {
+        if (!mapped && mode != Execute) {
             // Check if we just need to grow the stack.
             if (process->fixupFault(vaddr)) {
                 // If we did, lookup the entry for the new page.
-                pte = process->pTable->lookup(vaddr);
+                mapped = process->pTable->lookup(vaddr, pte);
             }
         }
 
-        if (!pte)
+        if (!mapped)
             return std::make_shared<PageFault>(vaddr, true, mode, true, false);
 
-        paddr = pte->paddr | process->pTable->pageOffset(vaddr);
+        paddr = pte.paddr | process->pTable->pageOffset(vaddr);
     }
     DPRINTF(TLB, "Translated (functional) %#x -> %#x.\n", vaddr, paddr);
     req->setPaddr(paddr);
@@ -69,6 +69,7 @@ namespace X86ISA
         TLB(const Params &p);
 
         void takeOverFrom(BaseTLB *otlb) override {}
+        void takeOverEntriesFrom(BaseTLB *otlb) override;
 
         TlbEntry *lookup(Addr va, bool update_lru = true);
 
@@ -263,3 +263,40 @@ TEST(CircularQueueTest, MultipleRound)
 
     ASSERT_EQ(ending_it - starting_it, cq_size);
 }
+
+/**
+ * Testing that a queue can be replaced by a larger one:
+ * - Capacity and contents are those of the assigned queue
+ * - Elements can be added up to the new capacity
+ */
+TEST(CircularQueueTest, MoveAssignment)
+{
+    const auto cq_size = 4;
+    CircularQueue<uint32_t> cq(cq_size);
+
+    for (auto idx = 0; idx < cq_size; idx++) {
+        cq.push_back(idx);
+    }
+    ASSERT_TRUE(cq.full());
+
+    CircularQueue<uint32_t> grown(2 * cq_size);
+    while (!cq.empty()) {
+        grown.push_back(cq.front());
+        cq.pop_front();
+    }
+    cq = std::move(grown);
+
+    ASSERT_EQ(cq.capacity(), 2 * cq_size);
+    ASSERT_EQ(cq.size(), cq_size);
+    ASSERT_FALSE(cq.full());
+
+    for (auto idx = cq_size; idx < 2 * cq_size; idx++) {
+        cq.push_back(idx);
+    }
+    ASSERT_TRUE(cq.full());
+
+    for (auto idx = 0; idx < 2 * cq_size; idx++) {
+        ASSERT_EQ(cq.front(), idx);
+        cq.pop_front();
+    }
+}
@@ -0,0 +1,122 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_RECYCLING_POOL_HH__
+#define __BASE_RECYCLING_POOL_HH__
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+/**
+ * Per host thread pool of fixed size blocks, which recycles the storage
+ * of objects that are created and destroyed at a high rate instead of
+ * going through the heap every time. Released blocks are kept on an
+ * intrusive free list and are never handed back to the heap. A block
+ * released by a thread other than the one that allocated it simply joins
+ * the pool of the releasing thread, so no synchronization is needed.
+ */
+template <size_t Size>
+class RecyclingPool
+{
+  private:
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    static_assert(Size >= sizeof(FreeBlock),
+                  "Blocks must be able to hold a free list link");
+
+    static thread_local FreeBlock *freeList;
+
+  public:
+    static void *
+    allocate()
+    {
+        FreeBlock *block = freeList;
+        if (!block)
+            return ::operator new(Size);
+        freeList = block->next;
+        return block;
+    }
+
+    static void
+    release(void *p)
+    {
+        FreeBlock *block = static_cast<FreeBlock *>(p);
+        block->next = freeList;
+        freeList = block;
+    }
+};
+
+template <size_t Size>
+thread_local typename RecyclingPool<Size>::FreeBlock *
+RecyclingPool<Size>::freeList = nullptr;
+
+/**
+ * Standard allocator drawing single objects from a RecyclingPool, e.g.,
+ * for std::allocate_shared, which then recycles the reference count
+ * along with the object.
+ */
+template <typename T>
+class RecyclingAllocator
+{
+  private:
+    using Pool = RecyclingPool<std::max(sizeof(T), sizeof(void *))>;
+
+  public:
+    using value_type = T;
+
+    RecyclingAllocator() = default;
+
+    template <typename U>
+    RecyclingAllocator(const RecyclingAllocator<U> &) {}
+
+    T *
+    allocate(size_t n)
+    {
+        if (n != 1)
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        return static_cast<T *>(Pool::allocate());
+    }
+
+    void
+    deallocate(T *p, size_t n)
+    {
+        if (n != 1)
+            ::operator delete(p);
+        else
+            Pool::release(p);
+    }
+
+    template <typename U>
+    bool operator==(const RecyclingAllocator<U> &) const { return true; }
+
+    template <typename U>
+    bool operator!=(const RecyclingAllocator<U> &) const { return false; }
+};
+
+#endif // __BASE_RECYCLING_POOL_HH__
@@ -0,0 +1,97 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "base/recycling_pool.hh"
+
+/** Released blocks are handed out again, most recently released first. */
+TEST(RecyclingPoolTest, Reuse)
+{
+    using Pool = RecyclingPool<48>;
+
+    void *a = Pool::allocate();
+    void *b = Pool::allocate();
+    EXPECT_NE(a, b);
+
+    Pool::release(a);
+    Pool::release(b);
+    EXPECT_EQ(b, Pool::allocate());
+    EXPECT_EQ(a, Pool::allocate());
+
+    Pool::release(a);
+    Pool::release(b);
+}
+
+/** Each host thread has a pool of its own. */
+TEST(RecyclingPoolTest, PerThread)
+{
+    using Pool = RecyclingPool<40>;
+
+    void *a = Pool::allocate();
+    Pool::release(a);
+
+    void *other = nullptr;
+    std::thread t([&other]() {
+        other = Pool::allocate();
+        Pool::release(other);
+    });
+    t.join();
+
+    EXPECT_NE(a, other);
+    EXPECT_EQ(a, Pool::allocate());
+    Pool::release(a);
+}
+
+/** Shared objects recycle their storage along with the reference count. */
+TEST(RecyclingPoolTest, AllocateShared)
+{
+    RecyclingAllocator<uint64_t> alloc;
+
+    auto p = std::allocate_shared<uint64_t>(alloc, 42);
+    EXPECT_EQ(42, *p);
+    const void *storage = p.get();
+    p.reset();
+
+    auto q = std::allocate_shared<uint64_t>(alloc, 7);
+    EXPECT_EQ(7, *q);
+    EXPECT_EQ(storage, q.get());
+}
+
+/** Arrays bypass the pool. */
+TEST(RecyclingPoolTest, Arrays)
+{
+    RecyclingAllocator<uint32_t> alloc;
+
+    uint32_t *p = alloc.allocate(16);
+    for (int i = 0; i < 16; i++)
+        p[i] = i;
+    EXPECT_EQ(15, p[15]);
+    alloc.deallocate(p, 16);
+}
@@ -41,6 +41,7 @@
 #ifndef __BASE_REFCNT_HH__
 #define __BASE_REFCNT_HH__
 
+#include <atomic>
 #include <type_traits>
 
 /**
@@ -104,6 +105,39 @@ class RefCounted
     }
 };
 
+/**
+ * Derive from AtomicRefCounted instead of RefCounted if references to
+ * objects of this class may be taken and dropped by several host
+ * threads at once, e.g. objects shared by the event queues of a
+ * parallel simulation. The reference count is then updated atomically.
+ */
+class AtomicRefCounted
+{
+  private:
+    mutable std::atomic<int> count;
+
+  private:
+    AtomicRefCounted(const AtomicRefCounted &);
+    AtomicRefCounted &operator=(const AtomicRefCounted &);
+
+  public:
+    AtomicRefCounted() : count(0) {}
+
+    virtual ~AtomicRefCounted() {}
+
+    /// Increment the reference count
+    void incref() const { count.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Decrement the reference count and destroy the object if all
+    /// references are gone.
+    void
+    decref() const
+    {
+        if (count.fetch_sub(1, std::memory_order_acq_rel) <= 1)
+            delete this;
+    }
+};
+
 /**
  * If you want a reference counting pointer to a mutable object,
  * create it like this:
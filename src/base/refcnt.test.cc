@@ -32,6 +32,8 @@
 #include <gtest/gtest.h>
 
 #include <list>
+#include <thread>
+#include <vector>
 
 #include "base/refcnt.hh"
 
@@ -68,6 +70,20 @@ class TestRC : public RefCounted
 };
 typedef RefCountingPtr<TestRC> Ptr;
 
+class TestAtomicRC : public AtomicRefCounted
+{
+  public:
+    TestAtomicRC(int &_deleted) : deleted(_deleted) {}
+
+    ~TestAtomicRC()
+    {
+        deleted++;
+    }
+
+    int &deleted;
+};
+typedef RefCountingPtr<TestAtomicRC> AtomicPtr;
+
 } // anonymous namespace
 
 TEST(RefcntTest, NullPointerCheck)
@@ -170,3 +186,29 @@ TEST(RefcntTest, EqualityOperators)
     EXPECT_TRUE(equalTestAPtr != equalTestB);
     EXPECT_TRUE(equalTestAPtr != equalTestBPtr);
 }
+
+TEST(RefcntTest, AtomicConcurrentReferences)
+{
+    // Take and drop references from several threads at once. The object
+    // must be deleted once, when the last reference is gone.
+    int deleted = 0;
+    {
+        AtomicPtr shared = new TestAtomicRC(deleted);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&shared]() {
+                std::vector<AtomicPtr> copies(1000);
+                for (int i = 0; i < 10000; i++) {
+                    for (auto &copy : copies)
+                        copy = shared;
+                    for (auto &copy : copies)
+                        copy = nullptr;
+                }
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+        EXPECT_EQ(0, deleted);
+    }
+    EXPECT_EQ(1, deleted);
+}
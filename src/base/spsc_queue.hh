@@ -0,0 +1,161 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_SPSC_QUEUE_HH__
+#define __BASE_SPSC_QUEUE_HH__
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+/**
+ * Bounded lock-free queue between exactly one producer thread and exactly
+ * one consumer thread. The capacity is rounded up to a power of two so
+ * that the free-running head and tail counters can be mapped onto the
+ * storage with a mask. The head is only written by the consumer and the
+ * tail only by the producer; each side keeps a private copy of the other
+ * side's counter and only reloads it when the queue looks full (or
+ * empty), which keeps the shared cache lines from bouncing on every
+ * operation.
+ */
+template <typename T>
+class SPSCQueue
+{
+  private:
+    /**
+     * Assumed size of a host cache line. The counters written by the two
+     * sides are kept on separate lines to avoid false sharing.
+     */
+    static constexpr size_t CacheLineSize = 64;
+
+    const size_t _capacity;
+    const size_t mask;
+    std::unique_ptr<T[]> storage;
+
+    char pad0[CacheLineSize];
+
+    /** Index of the next element to pop, written by the consumer. */
+    std::atomic<size_t> head;
+    /** Consumer's cached copy of the tail. */
+    size_t cachedTail;
+
+    char pad1[CacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+    /** Index of the next free slot, written by the producer. */
+    std::atomic<size_t> tail;
+    /** Producer's cached copy of the head. */
+    size_t cachedHead;
+
+    char pad2[CacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+    static size_t
+    roundCapacity(size_t capacity)
+    {
+        fatal_if(capacity == 0, "SPSCQueue capacity must be non-zero.\n");
+        return size_t(1) << ceilLog2(capacity);
+    }
+
+  public:
+    /**
+     * @param capacity Minimum number of elements the queue can hold.
+     */
+    explicit SPSCQueue(size_t capacity)
+        : _capacity(roundCapacity(capacity)), mask(_capacity - 1),
+          storage(new T[_capacity]),
+          head(0), cachedTail(0), tail(0), cachedHead(0)
+    {}
+
+    SPSCQueue(const SPSCQueue &) = delete;
+    SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+    /** Number of elements the queue can hold. */
+    size_t capacity() const { return _capacity; }
+
+    /**
+     * Append an element. Must only be called by the producer.
+     *
+     * @param val Element to move into the queue.
+     * @return False if the queue is full, in which case val is untouched.
+     */
+    bool
+    push(T &&val)
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cachedHead == _capacity) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead == _capacity)
+                return false;
+        }
+        storage[t & mask] = std::move(val);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool
+    push(const T &val)
+    {
+        T tmp(val);
+        return push(std::move(tmp));
+    }
+
+    /**
+     * Remove the oldest element. Must only be called by the consumer.
+     *
+     * @param val Destination of the element.
+     * @return False if the queue is empty.
+     */
+    bool
+    pop(T &val)
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h == cachedTail)
+                return false;
+        }
+        val = std::move(storage[h & mask]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Approximate number of queued elements. Exact when called while
+     * neither side is operating on the queue.
+     */
+    size_t
+    size() const
+    {
+        return tail.load(std::memory_order_acquire) -
+            head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+};
+
+#endif // __BASE_SPSC_QUEUE_HH__
@@ -0,0 +1,118 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "base/spsc_queue.hh"
+
+/** The capacity is rounded up to the next power of two. */
+TEST(SPSCQueueTest, Capacity)
+{
+    SPSCQueue<int> q1(1);
+    EXPECT_EQ(1, q1.capacity());
+
+    SPSCQueue<int> q5(5);
+    EXPECT_EQ(8, q5.capacity());
+
+    SPSCQueue<int> q64(64);
+    EXPECT_EQ(64, q64.capacity());
+}
+
+/** Elements come out in order and push fails once the queue is full. */
+TEST(SPSCQueueTest, FullAndEmpty)
+{
+    SPSCQueue<int> q(4);
+    int val = -1;
+
+    EXPECT_TRUE(q.empty());
+    EXPECT_FALSE(q.pop(val));
+
+    for (int i = 0; i < 4; i++)
+        EXPECT_TRUE(q.push(i));
+    EXPECT_EQ(4, q.size());
+    EXPECT_FALSE(q.push(4));
+
+    EXPECT_TRUE(q.pop(val));
+    EXPECT_EQ(0, val);
+    EXPECT_TRUE(q.push(4));
+
+    for (int i = 1; i < 5; i++) {
+        EXPECT_TRUE(q.pop(val));
+        EXPECT_EQ(i, val);
+    }
+    EXPECT_TRUE(q.empty());
+    EXPECT_FALSE(q.pop(val));
+}
+
+/** Move-only elements are supported. */
+TEST(SPSCQueueTest, MoveOnly)
+{
+    SPSCQueue<std::unique_ptr<int>> q(2);
+    std::unique_ptr<int> val(new int(42));
+
+    EXPECT_TRUE(q.push(std::move(val)));
+    EXPECT_EQ(nullptr, val);
+
+    std::unique_ptr<int> out;
+    EXPECT_TRUE(q.pop(out));
+    ASSERT_NE(nullptr, out);
+    EXPECT_EQ(42, *out);
+}
+
+/**
+ * A producer and a consumer thread pass a sequence through a small queue,
+ * wrapping around many times. Nothing may be lost, duplicated or
+ * reordered.
+ */
+TEST(SPSCQueueTest, ProducerConsumer)
+{
+    const uint64_t count = 1 << 20;
+    SPSCQueue<uint64_t> q(16);
+
+    std::thread producer([&] () {
+        for (uint64_t i = 0; i < count; i++) {
+            while (!q.push(i))
+                std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0;
+    uint64_t val;
+    while (expected < count) {
+        if (q.pop(val)) {
+            ASSERT_EQ(expected, val);
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(q.empty());
+}
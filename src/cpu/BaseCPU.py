@@ -169,6 +169,9 @@ class BaseCPU(ClockedObject):
     switched_out = Param.Bool(False,
         "Leave the CPU switched out after startup (used when switching " \
         "between CPU models)")
+    switch_keeps_tlbs = Param.Bool(False,
+        "Hand the TLB contents over to the CPU taking over on a switch " \
+        "instead of flushing them")
 
     tracer = Param.InstTracer(default_tracer, "Instruction tracer")
 
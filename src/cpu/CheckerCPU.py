@@ -37,3 +37,16 @@ class CheckerCPU(BaseCPU):
         "Update the checker with the main CPU's state on an error")
     warnOnlyOnLoadError = Param.Bool(True,
         "If a load result is incorrect, only print a warning and do not exit")
+    sampleWindow = Param.Counter(0,
+        "Number of committed instructions verified in every sample period "
+        "(0 verifies every instruction)")
+    samplePeriod = Param.Counter(0,
+        "Number of committed instructions in a sample period, the checker "
+        "resynchronizes with the main CPU at the start of every period")
+    hashCheck = Param.Bool(False,
+        "Compare a hash of the register state with the main CPU's at the "
+        "end of every sample window instead of the results of every "
+        "instruction")
+    injectDivergence = Param.Counter(0,
+        "Corrupt the checker's registers before the given register hash "
+        "check, to test that divergences are caught (0 never)")
@@ -87,6 +87,11 @@ class ActivityRecorder
     /** Returns if the CPU should be active. */
     bool active() { return activityCount; }
 
+    /** Returns if any time buffer communication is still in flight,
+     * i.e. if the activity count is not made up only of active stages.
+     */
+    bool communicationInFlight() const;
+
     /** Clears the time buffer and the activity count. */
     void reset();
 
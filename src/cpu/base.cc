@@ -136,7 +136,8 @@ BaseCPU::BaseCPU(const Params &p, bool is_checker)
       syscallRetryLatency(p.syscallRetryLatency),
       pwrGatingLatency(p.pwr_gating_latency),
       powerGatingOnIdle(p.power_gating_on_idle),
-      enterPwrGatingEvent([this]{ enterPwrGating(); }, name())
+      enterPwrGatingEvent([this]{ enterPwrGating(); }, name()),
+      switchKeepsTLBs(p.switch_keeps_tlbs)
 {
     // if Python did not provide a valid ID, do it here
     if (_cpuId == -1 ) {
@@ -239,7 +240,7 @@ BaseCPU::mwaitAtomic(ThreadID tid, ThreadContext *tc, BaseMMU *mmu)
     assert(tid < numThreads);
     AddressMonitor &monitor = addressMonitor[tid];
 
-    RequestPtr req = std::make_shared<Request>();
+    RequestPtr req = Request::create();
 
     Addr addr = monitor.vAddr;
     int block_size = cacheLineSize();
@@ -539,8 +540,10 @@ BaseCPU::switchOut()
     _switchedOut = true;
 
     // Flush all TLBs in the CPU to avoid having stale translations if
-    // it gets switched in later.
-    flushTLBs();
+    // it gets switched in later. If they are handed over, that happens
+    // once the new CPU has copied them.
+    if (!switchKeepsTLBs)
+        flushTLBs();
 
     // Go to the power gating state
     powerState->set(Enums::PwrState::OFF);
@@ -584,6 +587,8 @@ BaseCPU::takeOverFrom(BaseCPU *oldCPU)
         */
 
         newTC->getMMUPtr()->takeOverFrom(oldTC->getMMUPtr());
+        if (oldCPU->switchKeepsTLBs)
+            newTC->getMMUPtr()->takeOverEntriesFrom(oldTC->getMMUPtr());
 
         // Checker whether or not we have to transfer CheckerCPU
         // objects over in the switch
@@ -591,9 +596,18 @@ BaseCPU::takeOverFrom(BaseCPU *oldCPU)
         CheckerCPU *new_checker = newTC->getCheckerCpuPtr();
         if (old_checker && new_checker) {
             new_checker->getMMUPtr()->takeOverFrom(old_checker->getMMUPtr());
+            if (oldCPU->switchKeepsTLBs) {
+                new_checker->getMMUPtr()->takeOverEntriesFrom(
+                    old_checker->getMMUPtr());
+            }
         }
     }
 
+    // The old CPU kept its translations for us, drop them now that
+    // they have been handed over.
+    if (oldCPU->switchKeepsTLBs)
+        oldCPU->flushTLBs();
+
     interrupts = oldCPU->interrupts;
     for (ThreadID tid = 0; tid < numThreads; tid++) {
         interrupts[tid]->setThreadContext(threadContexts[tid]);
@@ -632,6 +632,9 @@ class BaseCPU : public ClockedObject
     const Cycles pwrGatingLatency;
     const bool powerGatingOnIdle;
     EventFunctionWrapper enterPwrGatingEvent;
+
+    /** Hand the TLB contents over on a switch rather than flush them */
+    const bool switchKeepsTLBs;
 };
 
 #endif // THE_ISA == NULL_ISA
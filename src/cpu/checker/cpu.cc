@@ -44,6 +44,7 @@
 #include <string>
 
 #include "arch/generic/tlb.hh"
+#include "arch/registers.hh"
 #include "cpu/base.hh"
 #include "cpu/simple_thread.hh"
 #include "cpu/static_inst.hh"
@@ -81,12 +82,50 @@ CheckerCPU::CheckerCPU(const Params &p)
     workload = p.workload;
 
     updateOnError = true;
+
+    sampleWindow = p.sampleWindow;
+    samplePeriod = p.samplePeriod;
+    sampleInsts = 0;
+    sampleActive = true;
+    hashCheck = p.hashCheck;
+    injectDivergence = p.injectDivergence;
+    numHashChecks = 0;
+
+    fatal_if(sampleWindow > samplePeriod,
+             "%s: The sample window (%d) must not exceed the sample "
+             "period (%d).", name(), sampleWindow, samplePeriod);
+    fatal_if(hashCheck && !sampleWindow,
+             "%s: Register hash checks need a sample window.", name());
+    fatal_if(injectDivergence && !hashCheck,
+             "%s: Divergences can only be injected in register hash "
+             "checks.", name());
 }
 
 CheckerCPU::~CheckerCPU()
 {
 }
 
+uint64_t
+CheckerCPU::regStateHash(ThreadContext *tc)
+{
+    // FNV-1a over the registers instructions in the current mode can
+    // name, so that the checker and the main CPU agree on what is
+    // hashed however their register files are laid out.
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    auto mix = [&hash](RegVal val) {
+        hash = (hash ^ val) * 0x100000001b3ULL;
+    };
+
+    for (int i = 0; i < TheISA::NumIntArchRegs; ++i)
+        mix(tc->readIntReg(i));
+    for (int i = 0; i < TheISA::NumFloatRegs; ++i)
+        mix(tc->readFloatReg(i));
+    for (int i = 0; i < TheISA::NumCCRegs; ++i)
+        mix(tc->readCCReg(i));
+
+    return hash;
+}
+
 void
 CheckerCPU::setSystem(System *system)
 {
@@ -148,7 +187,7 @@ CheckerCPU::genMemFragmentRequest(Addr frag_addr, int size,
                                                     size_left));
     auto it_end = byte_enable.cbegin() + (size - size_left);
     if (isAnyActiveElement(it_start, it_end)) {
-        mem_req = std::make_shared<Request>(frag_addr, frag_size,
+        mem_req = Request::create(frag_addr, frag_size,
                 flags, requestorId, thread->pcState().instAddr(),
                 tc->contextId());
         mem_req->setByteEnable(std::vector<bool>(it_start, it_end));
@@ -626,6 +626,37 @@ class CheckerCPU : public BaseCPU, public ExecContext
     bool warnOnlyOnLoadError;
 
     InstSeqNum youngestSN;
+
+    /**
+     * Hash the integer, floating point and condition code registers
+     * visible to the current mode of a thread, to cheaply compare the
+     * state of the checker with the main CPU's.
+     *
+     * Vector and vector predicate registers are not hashed, as the
+     * bytes beyond the current vector length are not architectural and
+     * may legitimately differ. Neither are misc registers, many of which
+     * hold state the checker does not model (e.g., counters); the misc
+     * registers an instruction writes are still compared right after it
+     * is verified.
+     */
+    static uint64_t regStateHash(ThreadContext *tc);
+
+    /** Instructions verified per sample period, 0 to verify all. */
+    Counter sampleWindow;
+    /** Committed instructions per sample period. */
+    Counter samplePeriod;
+    /** Committed instructions seen so far in this sample period. */
+    Counter sampleInsts;
+    /** Is the checker verifying instructions in this sample window? */
+    bool sampleActive;
+    /** Compare register hashes at the end of every sample window
+     *  rather than the results of every instruction. */
+    bool hashCheck;
+    /** Register hash check before which to corrupt the checker's
+     *  state, for testing (0 never). */
+    Counter injectDivergence;
+    /** Register hash checks done so far. */
+    Counter numHashChecks;
 };
 
 /**
@@ -654,6 +685,8 @@ class Checker : public CheckerCPU
 
     void validateInst(const DynInstPtr &inst);
     void validateExecution(const DynInstPtr &inst);
+    /** Compare the misc registers inst wrote with the main CPU's. */
+    void validateSideEffects(const DynInstPtr &inst);
     void validateState();
 
     void copyResult(const DynInstPtr &inst, const InstResult& mismatch_val,
@@ -661,6 +694,27 @@ class Checker : public CheckerCPU
     void handlePendingInt();
 
   private:
+    /**
+     * Can the checker's state be compared with, or copied from, the
+     * main CPU's once inst has been verified? That is only so when no
+     * younger instruction has committed yet and inst ends a macroop.
+     */
+    bool
+    atSyncPoint(const DynInstPtr &inst) const
+    {
+        return instList.empty() && inst->getFault() == NoFault &&
+            (!inst->isMicroop() || inst->isLastMicroop());
+    }
+
+    /** Account for an instruction outside the sample window. */
+    void skipInst(const DynInstPtr &inst);
+    /** Account for an instruction verified in the sample window. */
+    void sampleInst(const DynInstPtr &inst);
+    /** Copy the state of the main CPU following inst. */
+    void resyncState(const DynInstPtr &inst);
+    /** Compare register hashes with the main CPU following inst. */
+    void validateStateHash(const DynInstPtr &inst);
+
     void handleError(const DynInstPtr &inst)
     {
         if (exitOnError) {
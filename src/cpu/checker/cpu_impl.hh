@@ -186,6 +186,16 @@ Checker<Impl>::verify(const DynInstPtr &completed_inst)
     while (1) {
         DPRINTF(Checker, "Processing instruction [sn:%lli] PC:%s.\n",
                 unverifiedInst->seqNum, unverifiedInst->pcState());
+
+        if (!sampleActive) {
+            skipInst(unverifiedInst);
+            if (instList.empty() || !instList.front()->isCompleted())
+                break;
+            unverifiedInst = instList.front();
+            instList.pop_front();
+            continue;
+        }
+
         unverifiedReq = NULL;
         unverifiedReq = unverifiedInst->reqToVerify;
         unverifiedMemData = unverifiedInst->memData;
@@ -233,7 +243,7 @@ Checker<Impl>::verify(const DynInstPtr &completed_inst)
             // If not in the middle of a macro instruction
             if (!curMacroStaticInst) {
                 // set up memory request for instruction fetch
-                auto mem_req = std::make_shared<Request>(
+                auto mem_req = Request::create(
                     fetch_PC, sizeof(TheISA::MachInst), 0, requestorId,
                     fetch_PC, thread->contextId());
 
@@ -361,8 +371,19 @@ Checker<Impl>::verify(const DynInstPtr &completed_inst)
 
             if (fault == NoFault && unverifiedFault == NoFault) {
                 thread->funcExeInst++;
-                // Checks to make sure instrution results are correct.
-                validateExecution(unverifiedInst);
+                if (!hashCheck) {
+                    // Checks to make sure instrution results are correct.
+                    validateExecution(unverifiedInst);
+                } else {
+                    // Results are only compared as a register hash at
+                    // the end of the sample window.
+                    if (unverifiedInst->isUnverifiable()) {
+                        copyResult(unverifiedInst, InstResult(0ul,
+                                    InstResult::ResultType::Scalar), -1);
+                    }
+                    // Side effect registers are not part of the hash
+                    validateSideEffects(unverifiedInst);
+                }
 
                 if (curStaticInst->isLoad()) {
                     ++numLoad;
@@ -409,6 +430,9 @@ Checker<Impl>::verify(const DynInstPtr &completed_inst)
             }
         }
 
+        if (sampleWindow)
+            sampleInst(unverifiedInst);
+
         // @todo:  Optionally can check all registers. (Or just those
         // that have been modified).
         validateState();
@@ -433,6 +457,12 @@ void
 Checker<Impl>::switchOut()
 {
     instList.clear();
+
+    // Pick the main CPU's state up again once switched back in
+    if (sampleWindow) {
+        sampleActive = false;
+        sampleInsts = samplePeriod;
+    }
 }
 
 template <class Impl>
@@ -530,6 +560,13 @@ Checker<Impl>::validateExecution(const DynInstPtr &inst)
         handleError(inst);
     }
 
+    validateSideEffects(inst);
+}
+
+template <class Impl>
+void
+Checker<Impl>::validateSideEffects(const DynInstPtr &inst)
+{
     // Checking side effect registers can be difficult if they are not
     // checked simultaneously with the execution of the instruction.
     // This is because other valid instructions may have modified
@@ -580,6 +617,83 @@ Checker<Impl>::validateState()
     }
 }
 
+template <class Impl>
+void
+Checker<Impl>::skipInst(const DynInstPtr &inst)
+{
+    DPRINTF(Checker, "Skipping instruction [sn:%lli] PC:%s.\n",
+            inst->seqNum, inst->pcState());
+
+    // The window starts at the first point the main CPU's state can
+    // be copied from once the period is over.
+    if (++sampleInsts >= samplePeriod && atSyncPoint(inst)) {
+        resyncState(inst);
+        sampleInsts = 0;
+        sampleActive = true;
+    }
+}
+
+template <class Impl>
+void
+Checker<Impl>::sampleInst(const DynInstPtr &inst)
+{
+    // Likewise, the window only ends where the state can be compared
+    if (++sampleInsts < sampleWindow || !atSyncPoint(inst))
+        return;
+
+    if (hashCheck)
+        validateStateHash(inst);
+
+    if (sampleInsts >= samplePeriod)
+        sampleInsts = 0;
+    else
+        sampleActive = false;
+}
+
+template <class Impl>
+void
+Checker<Impl>::resyncState(const DynInstPtr &inst)
+{
+    DPRINTF(Checker, "Resynchronizing with main CPU after [sn:%lli] "
+            "PC:%s.\n", inst->seqNum, inst->pcState());
+
+    // As in validateState(), keep the O3 model from squashing
+    bool no_squash_from_TC = inst->thread->noSquashFromTC;
+    inst->thread->noSquashFromTC = true;
+    thread->copyArchRegs(inst->tcBase());
+    inst->thread->noSquashFromTC = no_squash_from_TC;
+
+    // The main CPU has not advanced its PC past inst yet
+    TheISA::PCState pc = inst->pcState();
+    TheISA::advancePC(pc, inst->staticInst);
+    thread->pcState(pc);
+
+    thread->decoder.reset();
+    curMacroStaticInst = StaticInst::nullStaticInstPtr;
+    changedPC = willChangePC = false;
+}
+
+template <class Impl>
+void
+Checker<Impl>::validateStateHash(const DynInstPtr &inst)
+{
+    if (injectDivergence && ++numHashChecks == injectDivergence) {
+        warn("%lli: Corrupting checker register state before hash check "
+             "%lli.", curTick(), numHashChecks);
+        tc->setIntReg(0, tc->readIntReg(0) ^ 1);
+    }
+
+    uint64_t checker_hash = regStateHash(tc);
+    uint64_t inst_hash = regStateHash(inst->tcBase());
+
+    if (checker_hash != inst_hash) {
+        warn("%lli: Register state hashes do not match after sn:%lli at "
+             "PC: %s! Inst: %#x, checker: %#x", curTick(), inst->seqNum,
+             inst->pcState(), inst_hash, checker_hash);
+        handleError(inst);
+    }
+}
+
 template <class Impl>
 void
 Checker<Impl>::copyResult(const DynInstPtr &inst,
@@ -277,6 +277,13 @@ class MinorCPU(BaseCPU):
 
     enableIdling = Param.Bool(True,
         "Enable cycle skipping when the processor is idle\n");
+    skipIdleStages = Param.Bool(True,
+        "Only evaluate pipeline stages and advance latches that have work"
+        " to do in a cycle");
+    idleOnMemoryStalls = Param.Bool(False,
+        "Also idle while Execute only waits on the memory system, and"
+        " restart an idled pipeline in the cycle a ticking one would have"
+        " reacted (requires enableIdling)");
 
     branchPred = Param.BranchPredictor(TournamentBP(
         numThreads = Parent.numThreads), "Branch Predictor")
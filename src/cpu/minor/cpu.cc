@@ -48,6 +48,7 @@
 MinorCPU::MinorCPU(const MinorCPUParams &params) :
     BaseCPU(params),
     threadPolicy(params.threadPolicy),
+    idleOnMemoryStalls(params.idleOnMemoryStalls),
     stats(this)
 {
     /* This is only written for one thread at the moment */
@@ -156,6 +157,10 @@ MinorCPU::wakeup(ThreadID tid)
 
     if (threads[tid]->status() == ThreadContext::Suspended) {
         threads[tid]->activate();
+    } else if (idleOnMemoryStalls) {
+        /* Execute polls for interrupts, make sure it sees a newly posted
+         *  one when the pipeline has idled waiting on memory */
+        wakeupOnEvent(Minor::Pipeline::ExecuteStageId);
     }
 }
 
@@ -303,7 +308,7 @@ MinorCPU::wakeupOnEvent(unsigned int stage_id)
 
     /* Mark that some activity has taken place and start the pipeline */
     activityRecorder->activateStage(stage_id);
-    pipeline->start();
+    pipeline->wakeup();
 }
 
 Port &
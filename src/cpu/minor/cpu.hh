@@ -110,6 +110,9 @@ class MinorCPU : public BaseCPU
 
     /** Thread Scheduling Policy (RoundRobin, Random, etc) */
     Enums::ThreadPolicy threadPolicy;
+
+    /** Idle while Execute only waits on the memory system */
+    const bool idleOnMemoryStalls;
   protected:
      /** Return a reference to the data port. */
     Port &getDataPort() override;
@@ -156,6 +156,10 @@ class Decode : public Named
      *  into Decode and on to Execute which is responsible for
      *  actually killing instructions */
     bool isDrained();
+
+    /** Would evaluate do nothing this cycle?  True when there are no
+     *  instructions arriving or left to decode */
+    bool isIdle() { return isDrained(); }
 };
 
 }
@@ -77,6 +77,7 @@ Execute::Execute(const std::string &name_,
     setTraceTimeOnCommit(params.executeSetTraceTimeOnCommit),
     setTraceTimeOnIssue(params.executeSetTraceTimeOnIssue),
     allowEarlyMemIssue(params.executeAllowEarlyMemoryIssue),
+    idleOnMemoryStalls(params.idleOnMemoryStalls),
     noCostFUIndex(fuDescriptions.funcUnits.size() + 1),
     lsq(name_ + ".lsq", name_ + ".dcache_port",
         cpu_, *this,
@@ -1556,9 +1557,21 @@ Execute::evaluate()
                 head_inst_might_commit = true;
             } else {
                 FUPipeline *fu = funcUnits[head_inst.inst->fuIndex];
-                if ((fu->stalled &&
-                     fu->front().inst->id == head_inst.inst->id) ||
-                     lsq.findResponse(head_inst.inst))
+                bool head_stalled = fu->stalled &&
+                    fu->front().inst->id == head_inst.inst->id;
+
+                /* A mem ref that can't get into the LSQ will only move
+                 *  once the memory system frees a request slot, which
+                 *  wakes the CPU up */
+                if (head_stalled && idleOnMemoryStalls &&
+                    !head_inst.inst->isFault() &&
+                    head_inst.inst->isMemRef() &&
+                    !head_inst.inst->inLSQ && !lsq.canRequest())
+                {
+                    head_stalled = false;
+                }
+
+                if (head_stalled || lsq.findResponse(head_inst.inst))
                 {
                     head_inst_might_commit = true;
                     break;
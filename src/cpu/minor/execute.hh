@@ -109,6 +109,10 @@ class Execute : public Named
      *  of the in flight insts queue if their dependencies are met */
     bool allowEarlyMemIssue;
 
+    /** Don't keep ticking for a head mem ref that is stalled at the end
+     *  of its FU only because the LSQ is full */
+    bool idleOnMemoryStalls;
+
     /** The FU index of the non-existent costless FU for instructions
      *  which pass the MinorDynInst::isNoCostInst test */
     unsigned int noCostFUIndex;
@@ -734,6 +734,23 @@ Fetch1::isDrained()
     return drained;
 }
 
+bool
+Fetch1::isIdle()
+{
+    if (!inp.outputWire->isBubble() || !prediction.outputWire->isBubble() ||
+        numInFlightFetches() != 0)
+    {
+        return false;
+    }
+
+    for (const auto &thread : fetchInfo) {
+        if (thread.state == FetchRunning || thread.wakeupGuard)
+            return false;
+    }
+
+    return true;
+}
+
 void
 Fetch1::FetchRequest::reportData(std::ostream &os) const
 {
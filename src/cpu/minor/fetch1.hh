@@ -177,7 +177,7 @@ class Fetch1 : public Named
             pc(pc_),
             fault(NoFault)
         {
-            request = std::make_shared<Request>();
+            request = Request::create();
         }
 
         ~FetchRequest();
@@ -405,6 +405,10 @@ class Fetch1 : public Named
     /** Is this stage drained?  For Fetch1, draining is initiated by
      *  Execute signalling a branch with the reason HaltFetch */
     bool isDrained();
+
+    /** Would evaluate do nothing this cycle?  True when there are no
+     *  branches arriving, no fetches in flight and no thread fetching */
+    bool isIdle();
 };
 
 }
@@ -605,6 +605,17 @@ Fetch2::isDrained()
            (*predictionOut.inputWire).isBubble();
 }
 
+bool
+Fetch2::isIdle()
+{
+    for (const auto &buffer : inputBuffer) {
+        if (!buffer.empty())
+            return false;
+    }
+
+    return (*inp.outputWire).isBubble() && (*branchInp.outputWire).isBubble();
+}
+
 Fetch2::Fetch2Stats::Fetch2Stats(MinorCPU *cpu)
       : Stats::Group(cpu, "fetch2"),
       ADD_STAT(intInstructions, UNIT_COUNT,
@@ -223,6 +223,10 @@ class Fetch2 : public Named
      *  Execute halting Fetch1 causing Fetch2 to naturally drain.
      *  Branch predictions are ignored by Fetch1 during halt */
     bool isDrained();
+
+    /** Would evaluate do nothing this cycle?  True when there are no
+     *  lines or branches arriving and no lines left to decode */
+    bool isIdle();
 };
 
 }
@@ -55,6 +55,9 @@ Pipeline::Pipeline(MinorCPU &cpu_, const MinorCPUParams &params) :
     Ticked(cpu_, &(cpu_.BaseCPU::baseStats.numCycles)),
     cpu(cpu_),
     allow_idling(params.enableIdling),
+    skipIdleStages(params.skipIdleStages &&
+        (params.threadPolicy != Enums::Random || params.numThreads == 1)),
+    idleOnMemoryStalls(params.idleOnMemoryStalls),
     f1ToF2(cpu.name() + ".f1ToF2", "lines",
         params.fetch1ToFetch2ForwardDelay),
     f2ToF1(cpu.name() + ".f2ToF1", "prediction",
@@ -128,19 +131,28 @@ Pipeline::evaluate()
      *  'immediate', 0-time-offset TimeBuffer activity to be visible from
      *  later stages to earlier ones in the same cycle */
     execute.evaluate();
-    decode.evaluate();
-    fetch2.evaluate();
-    fetch1.evaluate();
+    if (!skipIdleStages || !decode.isIdle())
+        decode.evaluate();
+    if (!skipIdleStages || !fetch2.isIdle())
+        fetch2.evaluate();
+    if (!skipIdleStages || !fetch1.isIdle())
+        fetch1.evaluate();
 
     if (DTRACE(MinorTrace))
         minorTrace();
 
-    /* Update the time buffers after the stages */
-    f1ToF2.evaluate();
-    f2ToF1.evaluate();
-    f2ToD.evaluate();
-    dToE.evaluate();
-    eToF1.evaluate();
+    /* Update the time buffers after the stages.  Advancing a latch that
+     *  only holds bubbles would leave it unchanged */
+    if (!skipIdleStages || !f1ToF2.empty())
+        f1ToF2.evaluate();
+    if (!skipIdleStages || !f2ToF1.empty())
+        f2ToF1.evaluate();
+    if (!skipIdleStages || !f2ToD.empty())
+        f2ToD.evaluate();
+    if (!skipIdleStages || !dToE.empty())
+        dToE.evaluate();
+    if (!skipIdleStages || !eToF1.empty())
+        eToF1.evaluate();
 
     /* The activity recorder must be be called after all the stages and
      *  before the idler (which acts on the advice of the activity recorder */
@@ -194,6 +206,17 @@ Pipeline::wakeupFetch(ThreadID tid)
     fetch1.wakeupFetch(tid);
 }
 
+void
+Pipeline::wakeup()
+{
+    /* Every cycle skipped while idle would have left the pipeline
+     *  unchanged, so the pipeline can carry on from this cycle */
+    if (idleOnMemoryStalls)
+        startThisCycle();
+    else
+        start();
+}
+
 bool
 Pipeline::drain()
 {
@@ -74,6 +74,15 @@ class Pipeline : public Ticked
     /** Allow cycles to be skipped when the pipeline is idle */
     bool allow_idling;
 
+    /** Only evaluate stages and advance latches with work to do.  Not
+     *  used with the random thread policy on more than one thread as the
+     *  stages draw random numbers every cycle to pick a thread */
+    bool skipIdleStages;
+
+    /** Restart an idled pipeline in the cycle it would have reacted in
+     *  had it kept ticking */
+    bool idleOnMemoryStalls;
+
     Latch<ForwardLineData> f1ToF2;
     Latch<BranchData> f2ToF1;
     Latch<ForwardInstData> f2ToD;
@@ -112,6 +121,9 @@ class Pipeline : public Ticked
      *  after quiesce wakeup */
     void wakeupFetch(ThreadID tid);
 
+    /** Restart the pipeline after a stage has been woken by an event */
+    void wakeup();
+
     /** Try to drain the CPU */
     bool drain();
 
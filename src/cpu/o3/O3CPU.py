@@ -71,6 +71,9 @@ class DerivO3CPU(BaseCPU):
         return True
 
     activity = Param.Unsigned(0, "Initial count")
+    skipStalledCycles = Param.Bool(False, "Stop ticking while the pipeline "
+          "is stalled waiting only on events outside the CPU, and account "
+          "for the skipped cycles when woken up")
 
     cacheStorePorts = Param.Unsigned(200, "Cache Ports. "
           "Constrains stores only.")
@@ -155,6 +158,9 @@ class DerivO3CPU(BaseCPU):
                                    "Number of physical cc registers")
     numIQEntries = Param.Unsigned(64, "Number of instruction queue entries")
     numROBEntries = Param.Unsigned(192, "Number of reorder buffer entries")
+    iqDepMatrix = Param.Bool(False, "Track register dependences in the IQ "
+                             "with per-register consumer bit matrices "
+                             "instead of linked lists")
 
     smtNumFetchingThreads = Param.Unsigned(1, "SMT Number of Fetching Threads")
     smtFetchPolicy = Param.SMTFetchPolicy('RoundRobin', "SMT Fetch policy")
@@ -211,6 +211,17 @@ class DefaultCommit
     /** Ticks the commit stage, which tries to commit instructions. */
     void tick();
 
+    /** Returns if the thread is stalled such that every cycle until an
+     * event outside the pipeline wakes the CPU would be identical.
+     */
+    bool canSkipStall(ThreadID tid);
+
+    /** Records which stall the skipped cycles are charged to. */
+    void beginStallSkip(ThreadID tid);
+
+    /** Accounts for the cycles skipped while stalled. */
+    void endStallSkip(Cycles cycles);
+
     /** Handles any squashes that are sent from IEW, and adds instructions
      * to the ROB and tries to commit instructions.
      */
@@ -437,6 +448,11 @@ class DefaultCommit
     /** The interrupt fault. */
     Fault interrupt;
 
+    /** The instruction stalling the head of the ROB while cycles are
+     * skipped, if any.
+     */
+    DynInstPtr skippedStallHead;
+
     /** The commit PC state of each thread.  Refers to the instruction that
      * is currently being processed/committed.
      */
@@ -735,6 +735,50 @@ DefaultCommit<Impl>::tick()
     updateStatus();
 }
 
+template <class Impl>
+bool
+DefaultCommit<Impl>::canSkipStall(ThreadID tid)
+{
+    if (commitStatus[tid] != Running && commitStatus[tid] != Idle)
+        return false;
+
+    if (trapSquash[tid] || tcSquash[tid] || interrupt != NoFault ||
+        (FullSystem && cpu->checkInterrupts(0))) {
+        return false;
+    }
+
+    // The head has to be waiting on something outside of commit, and an
+    // empty ROB must already have been reported to the other stages.
+    return !rob->isHeadReady(tid) &&
+        !(checkEmptyROB[tid] && rob->isEmpty(tid));
+}
+
+template <class Impl>
+void
+DefaultCommit<Impl>::beginStallSkip(ThreadID tid)
+{
+    assert(canSkipStall(tid));
+
+    if (!rob->isEmpty(tid))
+        skippedStallHead = rob->readHeadInst(tid);
+}
+
+template <class Impl>
+void
+DefaultCommit<Impl>::endStallSkip(Cycles cycles)
+{
+    stats.numCommittedDist.sample(0, cycles);
+
+    // Listeners see the stalled head once per cycle, as if commit had
+    // ticked.
+    if (skippedStallHead && ppCommitStall->hasListeners()) {
+        for (Cycles i(0); i < cycles; ++i)
+            ppCommitStall->notify(skippedStallHead);
+    }
+
+    skippedStallHead = nullptr;
+}
+
 template <class Impl>
 void
 DefaultCommit<Impl>::handleInterrupt()
@@ -115,6 +115,8 @@ FullO3CPU<Impl>::FullO3CPU(const DerivO3CPUParams &params)
                   params.backComSize + params.forwardComSize,
                   params.activity),
 
+      skipStalledCycles(params.skipStalledCycles),
+      stallSkipping(false),
       globalSeqNum(1),
       system(params.system),
       lastRunningCycle(curCycle()),
@@ -538,6 +540,9 @@ FullO3CPU<Impl>::tick()
             DPRINTF(O3CPU, "Idle!\n");
             lastRunningCycle = curCycle();
             cpuStats.timesIdled++;
+        } else if (canSkipStall()) {
+            DPRINTF(O3CPU, "Stalled, skipping cycles until woken up!\n");
+            beginStallSkip();
         } else {
             schedule(tickEvent, clockEdge(Cycles(1)));
             DPRINTF(O3CPU, "Scheduling next tick!\n");
@@ -550,6 +555,68 @@ FullO3CPU<Impl>::tick()
     tryDrain();
 }
 
+template <class Impl>
+bool
+FullO3CPU<Impl>::canSkipStall()
+{
+    // Only a single thread is handled, and any communication still in
+    // flight between the stages would change their state.
+    if (!skipStalledCycles || _status != Running ||
+        drainState() != DrainState::Running || numThreads != 1 ||
+        activeThreads.size() != 1 || activityRec.communicationInFlight()) {
+        return false;
+    }
+
+    ThreadID tid = activeThreads.front();
+
+    return fetch.canSkipStall(tid) && decode.canSkipStall(tid) &&
+        rename.canSkipStall(tid) && iew.canSkipStall(tid) &&
+        commit.canSkipStall(tid);
+}
+
+template <class Impl>
+void
+FullO3CPU<Impl>::beginStallSkip()
+{
+    ThreadID tid = activeThreads.front();
+
+    fetch.beginStallSkip(tid);
+    decode.beginStallSkip(tid);
+    rename.beginStallSkip(tid);
+    iew.beginStallSkip(tid);
+    commit.beginStallSkip(tid);
+
+    lastRunningCycle = curCycle();
+    stallSkipping = true;
+}
+
+template <class Impl>
+void
+FullO3CPU<Impl>::endStallSkip()
+{
+    assert(stallSkipping);
+    stallSkipping = false;
+
+    // Every cycle between the last tick and the next one would have
+    // repeated the stall. If woken up in the same cycle as the last tick,
+    // the next tick is a cycle later.
+    bool same_cycle = curCycle() <= lastRunningCycle;
+    Cycles skipped(same_cycle ? 0 : curCycle() - lastRunningCycle - 1);
+
+    DPRINTF(Activity, "Resuming after skipping %d stalled cycles\n",
+            skipped);
+
+    baseStats.numCycles += skipped;
+
+    fetch.endStallSkip(skipped);
+    decode.endStallSkip(skipped);
+    rename.endStallSkip(skipped);
+    iew.endStallSkip(skipped);
+    commit.endStallSkip(skipped);
+
+    schedule(tickEvent, same_cycle ? clockEdge(Cycles(1)) : clockEdge());
+}
+
 template <class Impl>
 void
 FullO3CPU<Impl>::init()
@@ -699,6 +766,9 @@ FullO3CPU<Impl>::suspendContext(ThreadID tid)
     DPRINTF(O3CPU,"[tid:%i] Suspending Thread Context.\n", tid);
     assert(!switchedOut());
 
+    if (stallSkipping)
+        endStallSkip();
+
     deactivateThread(tid);
 
     // If this was the last thread then unschedule the tick event.
@@ -721,6 +791,9 @@ FullO3CPU<Impl>::haltContext(ThreadID tid)
     DPRINTF(O3CPU,"[tid:%i] Halt Context called. Deallocating\n", tid);
     assert(!switchedOut());
 
+    if (stallSkipping)
+        endStallSkip();
+
     deactivateThread(tid);
     removeThread(tid);
 
@@ -1670,6 +1743,11 @@ template <class Impl>
 void
 FullO3CPU<Impl>::wakeCPU()
 {
+    if (stallSkipping) {
+        endStallSkip();
+        return;
+    }
+
     if (activityRec.active() || tickEvent.scheduled()) {
         DPRINTF(Activity, "CPU already running.\n");
         return;
@@ -1692,6 +1770,10 @@ template <class Impl>
 void
 FullO3CPU<Impl>::wakeup(ThreadID tid)
 {
+    // A posted interrupt has to be seen by commit in the next cycle.
+    if (stallSkipping)
+        wakeCPU();
+
     if (this->thread[tid]->status() != ThreadContext::Suspended)
         return;
 
@@ -1820,7 +1902,7 @@ FullO3CPU<Impl>::htmSendAbortSignal(ThreadID tid, uint64_t htm_uid,
 
     // notify l1 d-cache (ruby) that core has aborted transaction
     RequestPtr req =
-        std::make_shared<Request>(addr, size, flags, _dataRequestorId);
+        Request::create(addr, size, flags, _dataRequestorId);
 
     req->taskId(taskId());
     req->setContext(this->thread[tid]->contextId());
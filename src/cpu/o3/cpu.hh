@@ -632,7 +632,31 @@ class FullO3CPU : public BaseO3CPU
      */
     ActivityRecorder activityRec;
 
+    /** Whether the CPU may stop ticking while every stage is stalled
+     * waiting on an event outside the pipeline.
+     */
+    const bool skipStalledCycles;
+
+    /** Whether the CPU is currently skipping stalled cycles. */
+    bool stallSkipping;
+
+    /** Returns if every stage would repeat the same stalled cycle until
+     * an event outside the pipeline wakes the CPU up.
+     */
+    bool canSkipStall();
+
+    /** Stops ticking while the pipeline is stalled. */
+    void beginStallSkip();
+
+    /** Accounts for the skipped cycles in the stage statistics and
+     * resumes ticking.
+     */
+    void endStallSkip();
+
   public:
+    /** Returns if the CPU may stop ticking while the pipeline is stalled. */
+    bool maySkipStalledCycles() const { return skipStalledCycles; }
+
     /** Records that there was time buffer activity this cycle. */
     void activityThisCycle() { activityRec.activity(); }
 
@@ -135,6 +135,17 @@ class DefaultDecode
      */
     void tick();
 
+    /** Returns if the thread is stalled such that every cycle until an
+     * event outside the pipeline wakes the CPU would be identical.
+     */
+    bool canSkipStall(ThreadID tid) const;
+
+    /** Records which stall the skipped cycles are charged to. */
+    void beginStallSkip(ThreadID tid);
+
+    /** Accounts for the cycles skipped while stalled. */
+    void endStallSkip(Cycles cycles);
+
     /** Determines what to do based on decode's current status.
      * @param status_change decode() sets this variable if there was a status
      * change (ie switching from from blocking to unblocking).
@@ -280,6 +291,11 @@ class DefaultDecode
     /** Maximum size of the skid buffer. */
     unsigned skidBufferMax;
 
+    /** Stall counter that the cycles skipped while stalled are charged
+     * to.
+     */
+    Stats::Scalar *skippedStallStat;
+
     /** SeqNum of Squashing Branch Delay Instruction (used for MIPS)*/
     Addr bdelayDoneSeqNum[Impl::MaxThreads];
 
@@ -65,6 +65,7 @@ DefaultDecode<Impl>::DefaultDecode(O3CPU *_cpu, const DerivO3CPUParams &params)
       fetchToDecodeDelay(params.fetchToDecodeDelay),
       decodeWidth(params.decodeWidth),
       numThreads(params.numThreads),
+      skippedStallStat(nullptr),
       stats(_cpu)
 {
     if (decodeWidth > Impl::MaxWidth)
@@ -584,6 +585,39 @@ DefaultDecode<Impl>::tick()
     }
 }
 
+template<class Impl>
+bool
+DefaultDecode<Impl>::canSkipStall(ThreadID tid) const
+{
+    if (decodeStatus[tid] == Blocked) {
+        return checkStall(tid);
+    } else if (decodeStatus[tid] == Running || decodeStatus[tid] == Idle) {
+        return !checkStall(tid) && insts[tid].empty();
+    }
+
+    return false;
+}
+
+template<class Impl>
+void
+DefaultDecode<Impl>::beginStallSkip(ThreadID tid)
+{
+    assert(canSkipStall(tid));
+
+    skippedStallStat = decodeStatus[tid] == Blocked ?
+        &stats.blockedCycles : &stats.idleCycles;
+}
+
+template<class Impl>
+void
+DefaultDecode<Impl>::endStallSkip(Cycles cycles)
+{
+    assert(skippedStallStat);
+
+    *skippedStallStat += cycles;
+    skippedStallStat = nullptr;
+}
+
 template<class Impl>
 void
 DefaultDecode<Impl>::decode(bool &status_change, ThreadID tid)
@@ -0,0 +1,344 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_DEP_MATRIX_HH__
+#define __CPU_O3_DEP_MATRIX_HH__
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "cpu/o3/comm.hh"
+
+/**
+ * Bit matrix that maintains the dependencies between producing
+ * instructions and consuming instructions.  It offers the same interface
+ * as DependencyGraph, but instead of a linked list per physical register
+ * it keeps one row of bits per physical register, with one column per
+ * consumer slot.  Every instruction waiting on at least one register
+ * occupies a slot for as long as it has outstanding dependencies, so
+ * the number of slots only needs to match the number of IQ entries.
+ *
+ * Wakeup scans a register's row a host word at a time, and squashing a
+ * consumer clears a single bit rather than walking a list.  Nothing is
+ * allocated once the matrix has been sized.
+ */
+template <class DynInstPtr>
+class DependencyMatrix
+{
+  public:
+    /** Default construction.  Must call resize() prior to use. */
+    DependencyMatrix()
+        : numEntries(0), numSlots(0), wordsPerRow(0), lastSlot(-1)
+    { }
+
+    /**
+     * Resize the matrix to have num_entries registers and num_slots
+     * consumer slots.
+     */
+    void resize(int num_entries, int num_slots);
+
+    /** Clears all of the rows and frees all of the slots. */
+    void reset();
+
+    /** Inserts an instruction to be dependent on the given index. */
+    void insert(PhysRegIndex idx, const DynInstPtr &new_inst);
+
+    /** Sets the producing instruction of a given register. */
+    void setInst(PhysRegIndex idx, const DynInstPtr &new_inst)
+    { producers[idx] = new_inst; }
+
+    /** Clears the producing instruction. */
+    void clearInst(PhysRegIndex idx)
+    { producers[idx] = NULL; }
+
+    /** Removes an instruction from a single row. */
+    void remove(PhysRegIndex idx, const DynInstPtr &inst_to_remove);
+
+    /** Removes and returns a dependent of a specific register. */
+    DynInstPtr pop(PhysRegIndex idx);
+
+    /** Checks if the entire matrix is empty. */
+    bool empty() const { return freeSlots.size() == (size_t)numSlots; }
+
+    /** Checks if there are any dependents on a specific register. */
+    bool empty(PhysRegIndex idx) const;
+
+    /** Debugging function to dump out the dependency matrix. */
+    void dump();
+
+  private:
+    /** Returns the first word of the row of a register. */
+    uint64_t *row(PhysRegIndex idx) { return &matrix[idx * wordsPerRow]; }
+    const uint64_t *
+    row(PhysRegIndex idx) const
+    {
+        return &matrix[idx * wordsPerRow];
+    }
+
+    /** Returns the slot held by an instruction, allocating one if needed. */
+    int getSlot(const DynInstPtr &inst);
+
+    /** Drops one reference to a slot, freeing it when unused. */
+    void releaseSlot(int slot);
+
+    /**
+     * Drops one (slot, register) dependency that was inserted more than
+     * once.  Returns true if a duplicate was found and removed, in which
+     * case the bit in the register's row must stay set.
+     */
+    bool removeDuplicate(int slot, PhysRegIndex idx);
+
+    /** Number of rows; identical to the number of registers. */
+    int numEntries;
+
+    /** Number of consumer slots (columns). */
+    int numSlots;
+
+    /** Number of 64-bit words in each row. */
+    int wordsPerRow;
+
+    /** Row-major bit matrix, one row per physical register. */
+    std::vector<uint64_t> matrix;
+
+    /** Producing instruction of each register. */
+    std::vector<DynInstPtr> producers;
+
+    /** Consumer instruction held by each slot. */
+    std::vector<DynInstPtr> slotInsts;
+
+    /** Number of outstanding dependencies of each slot. */
+    std::vector<int> slotRefs;
+
+    /** Stack of the free slots. */
+    std::vector<int> freeSlots;
+
+    /**
+     * Dependencies inserted more than once for the same register and
+     * consumer (an instruction reading the same register as several
+     * sources).  They are rare enough that a flat list is sufficient.
+     */
+    std::vector<std::pair<int, PhysRegIndex>> duplicates;
+
+    /**
+     * Slot of the last consumer inserted.  All sources of an instruction
+     * are inserted back to back, so this avoids searching for the slot.
+     */
+    int lastSlot;
+};
+
+template <class DynInstPtr>
+void
+DependencyMatrix<DynInstPtr>::resize(int num_entries, int num_slots)
+{
+    numEntries = num_entries;
+    numSlots = num_slots;
+    wordsPerRow = (num_slots + 63) / 64;
+
+    matrix.assign(numEntries * wordsPerRow, 0);
+    producers.resize(numEntries);
+    slotInsts.resize(numSlots);
+    slotRefs.assign(numSlots, 0);
+
+    reset();
+}
+
+template <class DynInstPtr>
+void
+DependencyMatrix<DynInstPtr>::reset()
+{
+    std::fill(matrix.begin(), matrix.end(), 0);
+
+    for (auto &producer : producers)
+        producer = NULL;
+
+    freeSlots.clear();
+    for (int slot = numSlots - 1; slot >= 0; --slot) {
+        slotInsts[slot] = NULL;
+        slotRefs[slot] = 0;
+        freeSlots.push_back(slot);
+    }
+
+    duplicates.clear();
+    lastSlot = -1;
+}
+
+template <class DynInstPtr>
+int
+DependencyMatrix<DynInstPtr>::getSlot(const DynInstPtr &inst)
+{
+    if (lastSlot >= 0 && slotInsts[lastSlot] == inst)
+        return lastSlot;
+
+    panic_if(freeSlots.empty(),
+             "Dependency matrix out of consumer slots (%d).", numSlots);
+
+    lastSlot = freeSlots.back();
+    freeSlots.pop_back();
+    slotInsts[lastSlot] = inst;
+
+    return lastSlot;
+}
+
+template <class DynInstPtr>
+void
+DependencyMatrix<DynInstPtr>::releaseSlot(int slot)
+{
+    assert(slotRefs[slot] > 0);
+    if (--slotRefs[slot] == 0) {
+        slotInsts[slot] = NULL;
+        freeSlots.push_back(slot);
+        if (lastSlot == slot)
+            lastSlot = -1;
+    }
+}
+
+template <class DynInstPtr>
+bool
+DependencyMatrix<DynInstPtr>::removeDuplicate(int slot, PhysRegIndex idx)
+{
+    if (duplicates.empty())
+        return false;
+
+    auto it = std::find(duplicates.begin(), duplicates.end(),
+                        std::make_pair(slot, idx));
+    if (it == duplicates.end())
+        return false;
+
+    duplicates.erase(it);
+    return true;
+}
+
+template <class DynInstPtr>
+void
+DependencyMatrix<DynInstPtr>::insert(PhysRegIndex idx,
+        const DynInstPtr &new_inst)
+{
+    int slot = getSlot(new_inst);
+    uint64_t &word = row(idx)[slot / 64];
+    uint64_t mask = (uint64_t)1 << (slot % 64);
+
+    if (word & mask) {
+        duplicates.emplace_back(slot, idx);
+    } else {
+        word |= mask;
+    }
+
+    ++slotRefs[slot];
+}
+
+template <class DynInstPtr>
+void
+DependencyMatrix<DynInstPtr>::remove(PhysRegIndex idx,
+                                     const DynInstPtr &inst_to_remove)
+{
+    uint64_t *words = row(idx);
+
+    // As with the linked list implementation, the instruction may
+    // already have been woken up, in which case there is nothing to do.
+    for (int i = 0; i < wordsPerRow; ++i) {
+        uint64_t word = words[i];
+        while (word) {
+            int bit = findLsbSet(word);
+            word &= word - 1;
+
+            int slot = i * 64 + bit;
+            if (slotInsts[slot] != inst_to_remove)
+                continue;
+
+            if (!removeDuplicate(slot, idx))
+                words[i] &= ~((uint64_t)1 << bit);
+            releaseSlot(slot);
+            return;
+        }
+    }
+}
+
+template <class DynInstPtr>
+DynInstPtr
+DependencyMatrix<DynInstPtr>::pop(PhysRegIndex idx)
+{
+    uint64_t *words = row(idx);
+
+    for (int i = 0; i < wordsPerRow; ++i) {
+        if (!words[i])
+            continue;
+
+        int bit = findLsbSet(words[i]);
+        int slot = i * 64 + bit;
+        DynInstPtr inst = slotInsts[slot];
+
+        if (!removeDuplicate(slot, idx))
+            words[i] &= ~((uint64_t)1 << bit);
+        releaseSlot(slot);
+
+        return inst;
+    }
+
+    return NULL;
+}
+
+template <class DynInstPtr>
+bool
+DependencyMatrix<DynInstPtr>::empty(PhysRegIndex idx) const
+{
+    const uint64_t *words = row(idx);
+    for (int i = 0; i < wordsPerRow; ++i) {
+        if (words[i])
+            return false;
+    }
+    return true;
+}
+
+template <class DynInstPtr>
+void
+DependencyMatrix<DynInstPtr>::dump()
+{
+    for (int i = 0; i < numEntries; ++i) {
+        if (producers[i]) {
+            cprintf("dependMatrix[%i]: producer: %s [sn:%lli] consumer: ",
+                    i, producers[i]->pcState(), producers[i]->seqNum);
+        } else {
+            cprintf("dependMatrix[%i]: No producer. consumer: ", i);
+        }
+
+        const uint64_t *words = row(i);
+        for (int slot = 0; slot < numSlots; ++slot) {
+            if (bits(words[slot / 64], slot % 64)) {
+                cprintf("%s [sn:%lli] ", slotInsts[slot]->pcState(),
+                        slotInsts[slot]->seqNum);
+            }
+        }
+
+        cprintf("\n");
+    }
+    cprintf("Free slots: %i of %i\n", freeSlots.size(), numSlots);
+}
+
+#endif // __CPU_O3_DEP_MATRIX_HH__
@@ -0,0 +1,181 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "base/refcnt.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/o3/dep_graph.hh"
+#include "cpu/o3/dep_matrix.hh"
+
+namespace {
+
+struct FakeInst : public RefCounted
+{
+    FakeInst(InstSeqNum seq_num) : seqNum(seq_num) {}
+
+    InstSeqNum seqNum;
+    /** Registers the instruction still waits on, once per source. */
+    std::vector<PhysRegIndex> waitingOn;
+};
+
+typedef RefCountingPtr<FakeInst> FakeInstPtr;
+
+/** Pops all the dependents of a register, as wakeDependents() does. */
+template <class Deps>
+std::vector<InstSeqNum>
+wake(Deps &deps, PhysRegIndex idx)
+{
+    std::vector<InstSeqNum> woken;
+    while (FakeInstPtr inst = deps.pop(idx))
+        woken.push_back(inst->seqNum);
+    std::sort(woken.begin(), woken.end());
+    return woken;
+}
+
+/**
+ * Drives a dependency matrix and a dependency graph with the same random
+ * inserts, wakeups and squashes as the IQ would, and checks that they wake
+ * up the same instructions. Only the order in which the dependents of a
+ * register are popped differs.
+ */
+void
+checkAgainstGraph(int num_regs, int num_slots, std::mt19937 &rng)
+{
+    DependencyMatrix<FakeInstPtr> matrix;
+    DependencyGraph<FakeInstPtr> graph;
+    matrix.resize(num_regs, num_slots);
+    graph.resize(num_regs);
+
+    std::vector<FakeInstPtr> waiting;
+    InstSeqNum seq_num = 0;
+
+    for (int step = 0; step < 20000; step++) {
+        const int action = rng() % 4;
+        if (action < 2 && waiting.size() < (size_t)num_slots) {
+            // Dispatch an instruction with up to three sources, which may
+            // read the same register more than once
+            FakeInstPtr inst = new FakeInst(++seq_num);
+            const int num_srcs = 1 + rng() % 3;
+            for (int i = 0; i < num_srcs; i++) {
+                const PhysRegIndex idx = rng() % num_regs;
+                matrix.insert(idx, inst);
+                graph.insert(idx, inst);
+                inst->waitingOn.push_back(idx);
+            }
+            waiting.push_back(inst);
+        } else if (action == 2) {
+            // Complete the producer of a register
+            const PhysRegIndex idx = rng() % num_regs;
+            const std::vector<InstSeqNum> woken = wake(matrix, idx);
+            ASSERT_EQ(wake(graph, idx), woken);
+
+            std::vector<InstSeqNum> expected;
+            for (auto &inst : waiting) {
+                auto &srcs = inst->waitingOn;
+                const auto num = std::count(srcs.begin(), srcs.end(), idx);
+                expected.insert(expected.end(), num, inst->seqNum);
+                srcs.erase(std::remove(srcs.begin(), srcs.end(), idx),
+                           srcs.end());
+            }
+            ASSERT_EQ(expected, woken);
+        } else if (!waiting.empty()) {
+            // Squash an instruction, removing it from the registers it
+            // still waits on
+            FakeInstPtr inst = waiting[rng() % waiting.size()];
+            for (PhysRegIndex idx : inst->waitingOn) {
+                matrix.remove(idx, inst);
+                graph.remove(idx, inst);
+            }
+            inst->waitingOn.clear();
+        }
+
+        // Instructions without outstanding dependencies free their slot
+        waiting.erase(std::remove_if(waiting.begin(), waiting.end(),
+                          [](const FakeInstPtr &inst)
+                          { return inst->waitingOn.empty(); }),
+                      waiting.end());
+
+        for (PhysRegIndex idx = 0; idx < num_regs; idx++)
+            ASSERT_EQ(graph.empty(idx), matrix.empty(idx));
+        ASSERT_EQ(graph.empty(), matrix.empty());
+        ASSERT_EQ(waiting.empty(), matrix.empty());
+    }
+
+    matrix.reset();
+    graph.reset();
+    EXPECT_TRUE(matrix.empty());
+    for (PhysRegIndex idx = 0; idx < num_regs; idx++)
+        EXPECT_TRUE(matrix.empty(idx));
+}
+
+} // anonymous namespace
+
+/** A single word per row */
+TEST(DependencyMatrixTest, SingleWordRows)
+{
+    std::mt19937 rng(0xde95);
+    checkAgainstGraph(16, 32, rng);
+    checkAgainstGraph(64, 64, rng);
+}
+
+/** Rows spanning several words, the last one partially used */
+TEST(DependencyMatrixTest, MultiWordRows)
+{
+    std::mt19937 rng(0x3a71);
+    checkAgainstGraph(32, 100, rng);
+    checkAgainstGraph(256, 192, rng);
+}
+
+/** A slot is only freed once all the dependencies of its owner are gone */
+TEST(DependencyMatrixTest, SlotHeldUntilLastDependency)
+{
+    DependencyMatrix<FakeInstPtr> matrix;
+    matrix.resize(4, 1);
+
+    FakeInstPtr inst = new FakeInst(1);
+    matrix.insert(0, inst);
+    matrix.insert(1, inst);
+    matrix.insert(1, inst);
+
+    EXPECT_EQ(inst, matrix.pop(1));
+    EXPECT_FALSE(matrix.empty(1));
+    EXPECT_EQ(inst, matrix.pop(1));
+    EXPECT_TRUE(matrix.empty(1));
+    EXPECT_FALSE(matrix.empty());
+
+    matrix.remove(0, inst);
+    EXPECT_TRUE(matrix.empty());
+
+    // The only slot is free again
+    FakeInstPtr next = new FakeInst(2);
+    matrix.insert(3, next);
+    EXPECT_EQ(next, matrix.pop(3));
+    EXPECT_TRUE(matrix.empty());
+}
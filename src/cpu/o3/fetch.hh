@@ -270,6 +270,17 @@ class DefaultFetch
     /** Tells fetch to wake up from a quiesce instruction. */
     void wakeFromQuiesce();
 
+    /** Returns if the thread is stalled such that every cycle until an
+     * event outside the pipeline wakes the CPU would be identical.
+     */
+    bool canSkipStall(ThreadID tid) const;
+
+    /** Records which stall the skipped cycles are charged to. */
+    void beginStallSkip(ThreadID tid);
+
+    /** Accounts for the cycles skipped while stalled. */
+    void endStallSkip(Cycles cycles);
+
     /** For priority-based fetch policies, need to keep update priorityList */
     void deactivateThread(ThreadID tid);
   private:
@@ -533,6 +544,11 @@ class DefaultFetch
      */
     bool interruptPending;
 
+    /** Stall counter that the cycles skipped while stalled are charged
+     * to.
+     */
+    Stats::Scalar *skippedStallStat;
+
     /** Instruction port. Note that it has to appear after the fetch stage. */
     IcachePort icachePort;
 
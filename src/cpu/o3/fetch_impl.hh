@@ -90,6 +90,7 @@ DefaultFetch<Impl>::DefaultFetch(O3CPU *_cpu, const DerivO3CPUParams &params)
       fetchQueueSize(params.fetchQueueSize),
       numThreads(params.numThreads),
       numFetchingThreads(params.smtNumFetchingThreads),
+      skippedStallStat(nullptr),
       icachePort(this, _cpu),
       finishTranslationEvent(this), fetchStats(_cpu, this)
 {
@@ -479,6 +480,69 @@ DefaultFetch<Impl>::wakeFromQuiesce()
     fetchStatus[0] = Running;
 }
 
+template<class Impl>
+bool
+DefaultFetch<Impl>::canSkipStall(ThreadID tid) const
+{
+    if (stalls[tid].drain || interruptPending)
+        return false;
+
+    switch (fetchStatus[tid]) {
+      case Running:
+        {
+            // Fetch keeps running against a full fetch queue while decode
+            // is blocked, which is a no-op as long as neither a new nor a
+            // pipelined I-cache access is started.
+            Addr fetch_addr = (pc[tid].instAddr() + fetchOffset[tid]) &
+                BaseCPU::PCMask;
+            bool buffered = (fetchBufferValid[tid] &&
+                             (fetch_addr & ~fetchBufferMask) ==
+                             fetchBufferPC[tid]) || macroop[tid];
+            return buffered && stalls[tid].decode &&
+                fetchQueue[tid].size() >= fetchQueueSize;
+        }
+      case IcacheWaitResponse:
+      case ItlbWait:
+        // Completion of the access wakes the CPU up.
+        return stalls[tid].decode || fetchQueue[tid].empty();
+      default:
+        return false;
+    }
+}
+
+template<class Impl>
+void
+DefaultFetch<Impl>::beginStallSkip(ThreadID tid)
+{
+    assert(canSkipStall(tid));
+
+    if (fetchStatus[tid] == Running) {
+        skippedStallStat = &fetchStats.cycles;
+    } else if (fetchStatus[tid] == IcacheWaitResponse) {
+        skippedStallStat = &fetchStats.icacheStallCycles;
+    } else {
+        skippedStallStat = &fetchStats.tlbCycles;
+    }
+}
+
+template<class Impl>
+void
+DefaultFetch<Impl>::endStallSkip(Cycles cycles)
+{
+    assert(skippedStallStat);
+
+    // A running thread is tried once per fetching thread slot, while a
+    // stalled one is profiled only once per cycle.
+    if (skippedStallStat == &fetchStats.cycles) {
+        *skippedStallStat += cycles * numFetchingThreads;
+    } else {
+        *skippedStallStat += cycles;
+    }
+    fetchStats.nisnDist.sample(0, cycles);
+
+    skippedStallStat = nullptr;
+}
+
 template <class Impl>
 inline void
 DefaultFetch<Impl>::switchToActive()
@@ -595,7 +659,7 @@ DefaultFetch<Impl>::fetchCacheLine(Addr vaddr, ThreadID tid, Addr pc)
     // Setup the memReq to do a read of the first instruction's address.
     // Set the appropriate read size and flags as well.
     // Build request here.
-    RequestPtr mem_req = std::make_shared<Request>(
+    RequestPtr mem_req = Request::create(
         fetchBufferBlockPC, fetchBufferSize,
         Request::INST_FETCH, cpu->instRequestorId(), pc,
         cpu->thread[tid]->contextId());
@@ -922,9 +986,15 @@ DefaultFetch<Impl>::tick()
         }
     }
 
-    // Pick a random thread to start trying to grab instructions from
+    // Pick a random thread to start trying to grab instructions from.
+    // When skipping stalled cycles, don't consume a random number when
+    // there is nothing to pick from, so that the random stream doesn't
+    // depend on how many cycles fetch ticked.
     auto tid_itr = activeThreads->begin();
-    std::advance(tid_itr, random_mt.random<uint8_t>(0, activeThreads->size() - 1));
+    if (activeThreads->size() > 1 || !cpu->maySkipStalledCycles()) {
+        std::advance(tid_itr,
+                     random_mt.random<uint8_t>(0, activeThreads->size() - 1));
+    }
 
     while (available_insts != 0 && insts_to_decode < decodeWidth) {
         ThreadID tid = *tid_itr;
@@ -152,6 +152,9 @@ class FUPool : public SimObject
     /** Frees all FUs on the list. */
     void processFreeUnits();
 
+    /** Returns if any FUs are waiting to be freed. */
+    bool hasUnitsToBeFreed() const { return !unitsToBeFreed.empty(); }
+
     /** Returns the total number of FUs. */
     int size() { return numFU; }
 
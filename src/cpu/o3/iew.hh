@@ -301,6 +301,17 @@ class DefaultIEW
      */
     void tick();
 
+    /** Returns if the thread is stalled such that every cycle until an
+     * event outside the pipeline wakes the CPU would be identical.
+     */
+    bool canSkipStall(ThreadID tid);
+
+    /** Records which stall the skipped cycles are charged to. */
+    void beginStallSkip(ThreadID tid);
+
+    /** Accounts for the cycles skipped while stalled. */
+    void endStallSkip(Cycles cycles);
+
   private:
     /** Updates execution stats based on the instruction. */
     void updateExeInstStats(const DynInstPtr &inst);
@@ -423,6 +434,11 @@ class DefaultIEW
     /** Maximum size of the skid buffer. */
     unsigned skidBufferMax;
 
+    /** Stall counter that the cycles skipped while stalled are charged
+     * to, if any.
+     */
+    Stats::Scalar *skippedStallStat;
+
 
     struct IEWStats : public Stats::Group
     {
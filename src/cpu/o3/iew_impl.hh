@@ -76,6 +76,7 @@ DefaultIEW<Impl>::DefaultIEW(O3CPU *_cpu, const DerivO3CPUParams &params)
       wbCycle(0),
       wbWidth(params.wbWidth),
       numThreads(params.numThreads),
+      skippedStallStat(nullptr),
       iewStats(cpu)
 {
     if (dispatchWidth > Impl::MaxWidth)
@@ -1594,6 +1595,50 @@ DefaultIEW<Impl>::tick()
     }
 }
 
+template <class Impl>
+bool
+DefaultIEW<Impl>::canSkipStall(ThreadID tid)
+{
+    if (exeStatus != Idle || updateLSQNextCycle ||
+        fuPool->hasUnitsToBeFreed() || !instQueue.canSkipStall() ||
+        !ldstQueue.canSkipStall()) {
+        return false;
+    }
+
+    if (dispatchStatus[tid] == Blocked) {
+        return checkStall(tid);
+    } else if (dispatchStatus[tid] == Running ||
+               dispatchStatus[tid] == Idle) {
+        return !checkStall(tid) && insts[tid].empty();
+    }
+
+    return false;
+}
+
+template <class Impl>
+void
+DefaultIEW<Impl>::beginStallSkip(ThreadID tid)
+{
+    assert(canSkipStall(tid));
+
+    skippedStallStat = dispatchStatus[tid] == Blocked ?
+        &iewStats.blockCycles : nullptr;
+}
+
+template <class Impl>
+void
+DefaultIEW<Impl>::endStallSkip(Cycles cycles)
+{
+    if (skippedStallStat) {
+        *skippedStallStat += cycles;
+        skippedStallStat = nullptr;
+    }
+
+    // updateStatus() reads the IQ every cycle.
+    instQueue.iqIOStats.intInstQueueReads += cycles;
+    instQueue.endStallSkip(cycles);
+}
+
 template <class Impl>
 void
 DefaultIEW<Impl>::updateExeInstStats(const DynInstPtr& inst)
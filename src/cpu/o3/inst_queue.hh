@@ -43,13 +43,14 @@
 #define __CPU_O3_INST_QUEUE_HH__
 
 #include <list>
-#include <map>
 #include <queue>
 #include <vector>
 
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/o3/dep_graph.hh"
+#include "cpu/o3/dep_matrix.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/op_class.hh"
 #include "cpu/timebuf.hh"
@@ -90,8 +91,11 @@ class InstructionQueue
     typedef typename Impl::CPUPol::IssueStruct IssueStruct;
     typedef typename Impl::CPUPol::TimeStruct TimeStruct;
 
+    /** Ring of instructions, used for all IQ lists. */
+    typedef CircularQueue<DynInstPtr> InstRing;
+
     // Typedef of iterator through the list of instructions.
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
+    typedef typename InstRing::iterator ListIt;
 
     /** FU completion event class. */
     class FUCompletion : public Event {
@@ -172,6 +176,14 @@ class InstructionQueue
     /** Returns if there are any ready instructions in the IQ. */
     bool hasReadyInsts();
 
+    /** Returns if the IQ has nothing to issue or execute until an event
+     * outside the pipeline wakes up an instruction.
+     */
+    bool canSkipStall();
+
+    /** Accounts for the cycles skipped while stalled. */
+    void endStallSkip(Cycles cycles);
+
     /** Inserts a new instruction into the IQ. */
     void insert(const DynInstPtr &new_inst);
 
@@ -305,24 +317,27 @@ class InstructionQueue
     // Instruction lists, ready queues, and ordering
     //////////////////////////////////////
 
-    /** List of all the instructions in the IQ (some of which may be issued). */
-    std::list<DynInstPtr> instList[Impl::MaxThreads];
+    /** List of all the instructions in the IQ (some of which may be issued).
+     *  Instructions only leave this list at commit or squash, so it is
+     *  sized from the ROB rather than from the number of IQ entries.
+     */
+    std::vector<InstRing> instList;
 
     /** List of instructions that are ready to be executed. */
-    std::list<DynInstPtr> instsToExecute;
+    InstRing instsToExecute;
 
     /** List of instructions waiting for their DTB translation to
      *  complete (hw page table walk in progress).
      */
-    std::list<DynInstPtr> deferredMemInsts;
+    InstRing deferredMemInsts;
 
     /** List of instructions that have been cache blocked. */
-    std::list<DynInstPtr> blockedMemInsts;
+    InstRing blockedMemInsts;
 
     /** List of instructions that were cache blocked, but a retry has been seen
      * since, so they can now be retried. May fail again go on the blocked list.
      */
-    std::list<DynInstPtr> retryMemInsts;
+    InstRing retryMemInsts;
 
     /**
      * Struct for comparing entries to be added to the priority queue.
@@ -347,52 +362,136 @@ class InstructionQueue
     ReadyInstQueue readyInsts[Num_OpClasses];
 
     /** List of non-speculative instructions that will be scheduled
-     *  once the IQ gets a signal from commit.  While it's redundant to
-     *  have the key be a part of the value (the sequence number is stored
-     *  inside of DynInst), when these instructions are woken up only
-     *  the sequence number will be available.  Thus it is most efficient to be
-     *  able to search by the sequence number alone.
+     *  once the IQ gets a signal from commit.  When these instructions
+     *  are woken up only the sequence number is available, so they are
+     *  searched by sequence number.  There are rarely more than a handful
+     *  of them in flight, so a linear search over a flat vector is cheaper
+     *  than maintaining a node-based map.
      */
-    std::map<InstSeqNum, DynInstPtr> nonSpecInsts;
+    std::vector<DynInstPtr> nonSpecInsts;
 
-    typedef typename std::map<InstSeqNum, DynInstPtr>::iterator NonSpecMapIt;
+    typedef typename std::vector<DynInstPtr>::iterator NonSpecIt;
 
-    /** Entry for the list age ordering by op class. */
-    struct ListOrderEntry {
-        OpClass queueType;
-        InstSeqNum oldestInst;
-    };
+    /** Finds a non-speculative instruction by sequence number. */
+    NonSpecIt findNonSpec(const InstSeqNum &seq_num);
+
+    /** Number of 64-bit words in the ready op class bitmap. */
+    static constexpr int ReadyMaskWords = (Num_OpClasses + 63) / 64;
 
-    /** List that contains the age order of the oldest instruction of each
-     *  ready queue.  Used to select the oldest instruction available
-     *  among op classes.
-     *  @todo: Might be better to just move these entries around instead
-     *  of creating new ones every time the position changes due to an
-     *  instruction issuing.  Not sure std::list supports this.
+    /** Bitmap of the op classes that have at least one ready instruction.
+     *  Used to select the oldest instruction available among op classes
+     *  by scanning only the non-empty ready queues.
      */
-    std::list<ListOrderEntry> listOrder;
+    uint64_t readyMask[ReadyMaskWords];
 
-    typedef typename std::list<ListOrderEntry>::iterator ListOrderIt;
+    /** Marks an op class as having ready instructions. */
+    void
+    setReady(uint64_t *mask, OpClass op_class)
+    {
+        mask[op_class / 64] |= (uint64_t)1 << (op_class % 64);
+    }
 
-    /** Tracks if each ready queue is on the age order list. */
-    bool queueOnList[Num_OpClasses];
+    /** Marks an op class as having no (more) ready instructions. */
+    void
+    clearReady(uint64_t *mask, OpClass op_class)
+    {
+        mask[op_class / 64] &= ~((uint64_t)1 << (op_class % 64));
+    }
 
-    /** Iterators of each ready queue.  Points to their spot in the age order
-     *  list.
+    /**
+     * Returns the op class, among those set in the given mask, whose
+     * oldest ready instruction is the oldest overall, or Num_OpClasses if
+     * the mask is empty.
      */
-    ListOrderIt readyIt[Num_OpClasses];
-
-    /** Add an op class to the age order list. */
-    void addToOrderList(OpClass op_class);
+    OpClass oldestReadyOpClass(const uint64_t *mask);
 
     /**
-     * Called when the oldest instruction has been removed from a ready queue;
-     * this places that ready queue into the proper spot in the age order list.
+     * Appends an instruction to one of the lists. The lists are sized
+     * from the CPU parameters so that they normally never fill up, but
+     * one that does is grown rather than overflowing.
      */
-    void moveToYoungerInst(ListOrderIt age_order_it);
+    static void pushInst(InstRing &ring, const DynInstPtr &inst);
+
+    /** Removes all instructions from one of the lists. */
+    static void clearInsts(InstRing &ring);
 
     DependencyGraph<DynInstPtr> dependGraph;
 
+    /** Bit matrix alternative to the dependency graph. */
+    DependencyMatrix<DynInstPtr> dependMatrix;
+
+    /** Use the dependency matrix instead of the dependency graph. */
+    const bool useDepMatrix;
+
+    /** @{ */
+    /** Dependency tracking operations, forwarded to whichever of the
+     *  dependency graph or matrix is in use.
+     */
+    void
+    depInsert(PhysRegIndex idx, const DynInstPtr &inst)
+    {
+        if (useDepMatrix)
+            dependMatrix.insert(idx, inst);
+        else
+            dependGraph.insert(idx, inst);
+    }
+
+    void
+    depRemove(PhysRegIndex idx, const DynInstPtr &inst)
+    {
+        if (useDepMatrix)
+            dependMatrix.remove(idx, inst);
+        else
+            dependGraph.remove(idx, inst);
+    }
+
+    DynInstPtr
+    depPop(PhysRegIndex idx)
+    {
+        return useDepMatrix ? dependMatrix.pop(idx) : dependGraph.pop(idx);
+    }
+
+    void
+    depSetInst(PhysRegIndex idx, const DynInstPtr &inst)
+    {
+        if (useDepMatrix)
+            dependMatrix.setInst(idx, inst);
+        else
+            dependGraph.setInst(idx, inst);
+    }
+
+    void
+    depClearInst(PhysRegIndex idx)
+    {
+        if (useDepMatrix)
+            dependMatrix.clearInst(idx);
+        else
+            dependGraph.clearInst(idx);
+    }
+
+    bool
+    depEmpty(PhysRegIndex idx) const
+    {
+        return useDepMatrix ? dependMatrix.empty(idx) :
+                              dependGraph.empty(idx);
+    }
+
+    bool
+    depEmpty() const
+    {
+        return useDepMatrix ? dependMatrix.empty() : dependGraph.empty();
+    }
+
+    void
+    depDump()
+    {
+        if (useDepMatrix)
+            dependMatrix.dump();
+        else
+            dependGraph.dump();
+    }
+    /** @} */
+
     //////////////////////////////////////
     // Various parameters
     //////////////////////////////////////
@@ -42,9 +42,11 @@
 #ifndef __CPU_O3_INST_QUEUE_IMPL_HH__
 #define __CPU_O3_INST_QUEUE_IMPL_HH__
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "base/logging.hh"
 #include "cpu/o3/fu_pool.hh"
 #include "cpu/o3/inst_queue.hh"
@@ -87,6 +89,14 @@ InstructionQueue<Impl>::InstructionQueue(O3CPU *cpu_ptr, IEW *iew_ptr,
     : cpu(cpu_ptr),
       iewStage(iew_ptr),
       fuPool(params.fuPool),
+      instList(Impl::MaxThreads,
+               InstRing(params.numROBEntries +
+                        params.commitWidth * params.commitToIEWDelay)),
+      instsToExecute(2 * params.numROBEntries),
+      deferredMemInsts(2 * (params.LQEntries + params.SQEntries)),
+      blockedMemInsts(2 * (params.LQEntries + params.SQEntries)),
+      retryMemInsts(2 * (params.LQEntries + params.SQEntries)),
+      useDepMatrix(params.iqDepMatrix),
       iqPolicy(params.smtIQPolicy),
       numThreads(params.numThreads),
       numEntries(params.numIQEntries),
@@ -106,12 +116,18 @@ InstructionQueue<Impl>::InstructionQueue(O3CPU *cpu_ptr, IEW *iew_ptr,
                     params.numPhysCCRegs;
 
     //Create an entry for each physical register within the
-    //dependency graph.
-    dependGraph.resize(numPhysRegs);
+    //dependency graph, or a row in the dependency matrix with a consumer
+    //slot per IQ entry.
+    if (useDepMatrix)
+        dependMatrix.resize(numPhysRegs, numEntries);
+    else
+        dependGraph.resize(numPhysRegs);
 
     // Resize the register scoreboard.
     regScoreboard.resize(numPhysRegs);
 
+    nonSpecInsts.reserve(numEntries);
+
     //Initialize Mem Dependence Units
     for (ThreadID tid = 0; tid < Impl::MaxThreads; tid++) {
         memDepUnit[tid].init(params, tid, cpu_ptr);
@@ -391,7 +407,7 @@ InstructionQueue<Impl>::resetState()
     //Initialize thread IQ counts
     for (ThreadID tid = 0; tid < Impl::MaxThreads; tid++) {
         count[tid] = 0;
-        instList[tid].clear();
+        clearInsts(instList[tid]);
     }
 
     // Initialize the number of free IQ entries.
@@ -413,14 +429,15 @@ InstructionQueue<Impl>::resetState()
     for (int i = 0; i < Num_OpClasses; ++i) {
         while (!readyInsts[i].empty())
             readyInsts[i].pop();
-        queueOnList[i] = false;
-        readyIt[i] = listOrder.end();
+    }
+    for (int i = 0; i < ReadyMaskWords; ++i) {
+        readyMask[i] = 0;
     }
     nonSpecInsts.clear();
-    listOrder.clear();
-    deferredMemInsts.clear();
-    blockedMemInsts.clear();
-    retryMemInsts.clear();
+    clearInsts(instsToExecute);
+    clearInsts(deferredMemInsts);
+    clearInsts(blockedMemInsts);
+    clearInsts(retryMemInsts);
     wbOutstanding = 0;
 }
 
@@ -451,7 +468,7 @@ template <class Impl>
 bool
 InstructionQueue<Impl>::isDrained() const
 {
-    bool drained = dependGraph.empty() &&
+    bool drained = depEmpty() &&
                    instsToExecute.empty() &&
                    wbOutstanding == 0;
     for (ThreadID tid = 0; tid < numThreads; ++tid)
@@ -464,7 +481,7 @@ template <class Impl>
 void
 InstructionQueue<Impl>::drainSanityCheck() const
 {
-    assert(dependGraph.empty());
+    assert(depEmpty());
     assert(instsToExecute.empty());
     for (ThreadID tid = 0; tid < numThreads; ++tid)
         memDepUnit[tid].drainSanityCheck();
@@ -554,12 +571,8 @@ template <class Impl>
 bool
 InstructionQueue<Impl>::hasReadyInsts()
 {
-    if (!listOrder.empty()) {
-        return true;
-    }
-
-    for (int i = 0; i < Num_OpClasses; ++i) {
-        if (!readyInsts[i].empty()) {
+    for (int i = 0; i < ReadyMaskWords; ++i) {
+        if (readyMask[i]) {
             return true;
         }
     }
@@ -567,6 +580,21 @@ InstructionQueue<Impl>::hasReadyInsts()
     return false;
 }
 
+template <class Impl>
+bool
+InstructionQueue<Impl>::canSkipStall()
+{
+    return !hasReadyInsts() && instsToExecute.empty() &&
+        deferredMemInsts.empty() && retryMemInsts.empty();
+}
+
+template <class Impl>
+void
+InstructionQueue<Impl>::endStallSkip(Cycles cycles)
+{
+    iqStats.numIssuedDist.sample(0, cycles);
+}
+
 template <class Impl>
 void
 InstructionQueue<Impl>::insert(const DynInstPtr &new_inst)
@@ -586,7 +614,7 @@ InstructionQueue<Impl>::insert(const DynInstPtr &new_inst)
 
     assert(freeEntries != 0);
 
-    instList[new_inst->threadNumber].push_back(new_inst);
+    pushInst(instList[new_inst->threadNumber], new_inst);
 
     --freeEntries;
 
@@ -629,7 +657,7 @@ InstructionQueue<Impl>::insertNonSpec(const DynInstPtr &new_inst)
 
     assert(new_inst);
 
-    nonSpecInsts[new_inst->seqNum] = new_inst;
+    nonSpecInsts.push_back(new_inst);
 
     DPRINTF(IQ, "Adding non-speculative instruction [sn:%llu] PC %s "
             "to the IQ.\n",
@@ -637,7 +665,7 @@ InstructionQueue<Impl>::insertNonSpec(const DynInstPtr &new_inst)
 
     assert(freeEntries != 0);
 
-    instList[new_inst->threadNumber].push_back(new_inst);
+    pushInst(instList[new_inst->threadNumber], new_inst);
 
     --freeEntries;
 
@@ -687,56 +715,68 @@ InstructionQueue<Impl>::getInstToExecute()
 }
 
 template <class Impl>
-void
-InstructionQueue<Impl>::addToOrderList(OpClass op_class)
+OpClass
+InstructionQueue<Impl>::oldestReadyOpClass(const uint64_t *mask)
 {
-    assert(!readyInsts[op_class].empty());
-
-    ListOrderEntry queue_entry;
-
-    queue_entry.queueType = op_class;
-
-    queue_entry.oldestInst = readyInsts[op_class].top()->seqNum;
+    OpClass oldest_class = Num_OpClasses;
+    InstSeqNum oldest_inst = std::numeric_limits<InstSeqNum>::max();
+
+    for (int i = 0; i < ReadyMaskWords; ++i) {
+        uint64_t word = mask[i];
+        while (word) {
+            int bit = findLsbSet(word);
+            word &= word - 1;
+
+            OpClass op_class = (OpClass)(i * 64 + bit);
+            assert(!readyInsts[op_class].empty());
+
+            InstSeqNum seq_num = readyInsts[op_class].top()->seqNum;
+            if (seq_num < oldest_inst) {
+                oldest_inst = seq_num;
+                oldest_class = op_class;
+            }
+        }
+    }
 
-    ListOrderIt list_it = listOrder.begin();
-    ListOrderIt list_end_it = listOrder.end();
+    return oldest_class;
+}
 
-    while (list_it != list_end_it) {
-        if ((*list_it).oldestInst > queue_entry.oldestInst) {
-            break;
+template <class Impl>
+void
+InstructionQueue<Impl>::pushInst(InstRing &ring, const DynInstPtr &inst)
+{
+    if (ring.full()) {
+        // No iterators into the lists are kept across calls, so the
+        // instructions can be moved to a larger ring in order.
+        InstRing grown(2 * ring.capacity());
+        while (!ring.empty()) {
+            grown.push_back(std::move(ring.front()));
+            ring.pop_front();
         }
-
-        list_it++;
+        ring = std::move(grown);
     }
-
-    readyIt[op_class] = listOrder.insert(list_it, queue_entry);
-    queueOnList[op_class] = true;
+    ring.push_back(inst);
 }
 
 template <class Impl>
 void
-InstructionQueue<Impl>::moveToYoungerInst(ListOrderIt list_order_it)
+InstructionQueue<Impl>::clearInsts(InstRing &ring)
 {
-    // Get iterator of next item on the list
-    // Delete the original iterator
-    // Determine if the next item is either the end of the list or younger
-    // than the new instruction.  If so, then add in a new iterator right here.
-    // If not, then move along.
-    ListOrderEntry queue_entry;
-    OpClass op_class = (*list_order_it).queueType;
-    ListOrderIt next_it = list_order_it;
-
-    ++next_it;
-
-    queue_entry.queueType = op_class;
-    queue_entry.oldestInst = readyInsts[op_class].top()->seqNum;
-
-    while (next_it != listOrder.end() &&
-           (*next_it).oldestInst < queue_entry.oldestInst) {
-        ++next_it;
+    // Release the references held by the ring so squashed or committed
+    // instructions are not kept alive by stale slots.
+    while (!ring.empty()) {
+        ring.front() = nullptr;
+        ring.pop_front();
     }
+}
 
-    readyIt[op_class] = listOrder.insert(next_it, queue_entry);
+template <class Impl>
+typename InstructionQueue<Impl>::NonSpecIt
+InstructionQueue<Impl>::findNonSpec(const InstSeqNum &seq_num)
+{
+    return std::find_if(nonSpecInsts.begin(), nonSpecInsts.end(),
+                        [seq_num](const DynInstPtr &inst)
+                        { return inst->seqNum == seq_num; });
 }
 
 template <class Impl>
@@ -757,7 +797,7 @@ InstructionQueue<Impl>::processFUCompletion(const DynInstPtr &inst, int fu_idx)
     // of a cycle, otherwise they could add too many instructions to
     // the queue.
     issueToExecuteQueue->access(-1)->size++;
-    instsToExecute.push_back(inst);
+    pushInst(instsToExecute, inst);
 }
 
 // @todo: Figure out a better way to remove the squashed items from the
@@ -782,20 +822,26 @@ InstructionQueue<Impl>::scheduleReadyInsts()
         addReadyMemInst(mem_inst);
     }
 
-    // Have iterator to head of the list
-    // While I haven't exceeded bandwidth or reached the end of the list,
+    // Pick the op class holding the oldest ready instruction among the
+    // candidate op classes.
+    // While I haven't exceeded bandwidth or run out of candidates,
     // Try to get a FU that can do what this op needs.
-    // If successful, change the oldestInst to the new top of the list, put
-    // the queue in the proper place in the list.
-    // Increment the iterator.
+    // If successful, the op class stays a candidate with its next oldest
+    // instruction; otherwise it is dropped from the candidates for this
+    // cycle.
     // This will avoid trying to schedule a certain op class if there are no
     // FUs that handle it.
     int total_issued = 0;
-    ListOrderIt order_it = listOrder.begin();
-    ListOrderIt order_end_it = listOrder.end();
+    uint64_t candidates[ReadyMaskWords];
+    for (int i = 0; i < ReadyMaskWords; ++i) {
+        candidates[i] = readyMask[i];
+    }
 
-    while (total_issued < totalWidth && order_it != order_end_it) {
-        OpClass op_class = (*order_it).queueType;
+    while (total_issued < totalWidth) {
+        OpClass op_class = oldestReadyOpClass(candidates);
+
+        if (op_class == Num_OpClasses)
+            break;
 
         assert(!readyInsts[op_class].empty());
 
@@ -809,20 +855,14 @@ InstructionQueue<Impl>::scheduleReadyInsts()
             iqIOStats.intInstQueueReads++;
         }
 
-        assert(issuing_inst->seqNum == (*order_it).oldestInst);
-
         if (issuing_inst->isSquashed()) {
             readyInsts[op_class].pop();
 
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
-            } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
+            if (readyInsts[op_class].empty()) {
+                clearReady(readyMask, op_class);
+                clearReady(candidates, op_class);
             }
 
-            listOrder.erase(order_it++);
-
             ++iqStats.squashedInstsIssued;
 
             continue;
@@ -851,7 +891,7 @@ InstructionQueue<Impl>::scheduleReadyInsts()
         if (idx != FUPool::NoFreeFU) {
             if (op_latency == Cycles(1)) {
                 i2e_info->size++;
-                instsToExecute.push_back(issuing_inst);
+                pushInst(instsToExecute, issuing_inst);
 
                 // Add the FU onto the list of FU's to be freed next
                 // cycle if we used one.
@@ -884,11 +924,9 @@ InstructionQueue<Impl>::scheduleReadyInsts()
 
             readyInsts[op_class].pop();
 
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
-            } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
+            if (readyInsts[op_class].empty()) {
+                clearReady(readyMask, op_class);
+                clearReady(candidates, op_class);
             }
 
             issuing_inst->setIssued();
@@ -908,12 +946,11 @@ InstructionQueue<Impl>::scheduleReadyInsts()
                 memDepUnit[tid].issue(issuing_inst);
             }
 
-            listOrder.erase(order_it++);
             iqStats.statIssuedInstType[tid][op_class]++;
         } else {
             iqStats.statFuBusy[op_class]++;
             iqStats.fuBusy[tid]++;
-            ++order_it;
+            clearReady(candidates, op_class);
         }
     }
 
@@ -938,25 +975,25 @@ InstructionQueue<Impl>::scheduleNonSpec(const InstSeqNum &inst)
     DPRINTF(IQ, "Marking nonspeculative instruction [sn:%llu] as ready "
             "to execute.\n", inst);
 
-    NonSpecMapIt inst_it = nonSpecInsts.find(inst);
+    NonSpecIt inst_it = findNonSpec(inst);
 
     assert(inst_it != nonSpecInsts.end());
 
-    ThreadID tid = (*inst_it).second->threadNumber;
+    DynInstPtr ns_inst = std::move(*inst_it);
 
-    (*inst_it).second->setAtCommit();
+    nonSpecInsts.erase(inst_it);
 
-    (*inst_it).second->setCanIssue();
+    ThreadID tid = ns_inst->threadNumber;
 
-    if (!(*inst_it).second->isMemRef()) {
-        addIfReady((*inst_it).second);
-    } else {
-        memDepUnit[tid].nonSpecInstReady((*inst_it).second);
-    }
+    ns_inst->setAtCommit();
 
-    (*inst_it).second = NULL;
+    ns_inst->setCanIssue();
 
-    nonSpecInsts.erase(inst_it);
+    if (!ns_inst->isMemRef()) {
+        addIfReady(ns_inst);
+    } else {
+        memDepUnit[tid].nonSpecInstReady(ns_inst);
+    }
 }
 
 template <class Impl>
@@ -966,12 +1003,11 @@ InstructionQueue<Impl>::commit(const InstSeqNum &inst, ThreadID tid)
     DPRINTF(IQ, "[tid:%i] Committing instructions older than [sn:%llu]\n",
             tid,inst);
 
-    ListIt iq_it = instList[tid].begin();
+    InstRing &inst_list = instList[tid];
 
-    while (iq_it != instList[tid].end() &&
-           (*iq_it)->seqNum <= inst) {
-        ++iq_it;
-        instList[tid].pop_front();
+    while (!inst_list.empty() && inst_list.front()->seqNum <= inst) {
+        inst_list.front() = nullptr;
+        inst_list.pop_front();
     }
 
     assert(freeEntries == (numEntries - countInsts()));
@@ -1047,7 +1083,7 @@ InstructionQueue<Impl>::wakeDependents(const DynInstPtr &completed_inst)
 
         //Go through the dependency chain, marking the registers as
         //ready within the waiting instructions.
-        DynInstPtr dep_inst = dependGraph.pop(dest_reg->flatIndex());
+        DynInstPtr dep_inst = depPop(dest_reg->flatIndex());
 
         while (dep_inst) {
             DPRINTF(IQ, "Waking up a dependent instruction, [sn:%llu] "
@@ -1061,15 +1097,15 @@ InstructionQueue<Impl>::wakeDependents(const DynInstPtr &completed_inst)
 
             addIfReady(dep_inst);
 
-            dep_inst = dependGraph.pop(dest_reg->flatIndex());
+            dep_inst = depPop(dest_reg->flatIndex());
 
             ++dependents;
         }
 
         // Reset the head node now that all of its dependents have
         // been woken up.
-        assert(dependGraph.empty(dest_reg->flatIndex()));
-        dependGraph.clearInst(dest_reg->flatIndex());
+        assert(depEmpty(dest_reg->flatIndex()));
+        depClearInst(dest_reg->flatIndex());
 
         // Mark the scoreboard as having that register ready.
         regScoreboard[dest_reg->flatIndex()] = true;
@@ -1084,16 +1120,7 @@ InstructionQueue<Impl>::addReadyMemInst(const DynInstPtr &ready_inst)
     OpClass op_class = ready_inst->opClass();
 
     readyInsts[op_class].push(ready_inst);
-
-    // Will need to reorder the list if either a queue is not on the list,
-    // or it has an older instruction than last time.
-    if (!queueOnList[op_class]) {
-        addToOrderList(op_class);
-    } else if (readyInsts[op_class].top()->seqNum  <
-               (*readyIt[op_class]).oldestInst) {
-        listOrder.erase(readyIt[op_class]);
-        addToOrderList(op_class);
-    }
+    setReady(readyMask, op_class);
 
     DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
             "the ready list, PC %s opclass:%i [sn:%llu].\n",
@@ -1125,7 +1152,7 @@ template <class Impl>
 void
 InstructionQueue<Impl>::deferMemInst(const DynInstPtr &deferred_inst)
 {
-    deferredMemInsts.push_back(deferred_inst);
+    pushInst(deferredMemInsts, deferred_inst);
 }
 
 template <class Impl>
@@ -1134,14 +1161,18 @@ InstructionQueue<Impl>::blockMemInst(const DynInstPtr &blocked_inst)
 {
     blocked_inst->clearIssued();
     blocked_inst->clearCanIssue();
-    blockedMemInsts.push_back(blocked_inst);
+    pushInst(blockedMemInsts, blocked_inst);
 }
 
 template <class Impl>
 void
 InstructionQueue<Impl>::cacheUnblocked()
 {
-    retryMemInsts.splice(retryMemInsts.end(), blockedMemInsts);
+    while (!blockedMemInsts.empty()) {
+        DynInstPtr blocked_inst = std::move(blockedMemInsts.front());
+        blockedMemInsts.pop_front();
+        pushInst(retryMemInsts, blocked_inst);
+    }
     // Get the CPU ticking again
     cpu->wakeCPU();
 }
@@ -1150,11 +1181,17 @@ template <class Impl>
 typename Impl::DynInstPtr
 InstructionQueue<Impl>::getDeferredMemInstToExecute()
 {
-    for (ListIt it = deferredMemInsts.begin(); it != deferredMemInsts.end();
-         ++it) {
-        if ((*it)->translationCompleted() || (*it)->isSquashed()) {
-            DynInstPtr mem_inst = std::move(*it);
-            deferredMemInsts.erase(it);
+    for (size_t idx = deferredMemInsts.head();
+         deferredMemInsts.isValidIdx(idx); ++idx) {
+        DynInstPtr &deferred_inst = deferredMemInsts[idx];
+        if (deferred_inst->translationCompleted() ||
+            deferred_inst->isSquashed()) {
+            DynInstPtr mem_inst = std::move(deferred_inst);
+            // Close the gap so the remaining instructions keep their order.
+            for (; idx != deferredMemInsts.tail(); ++idx) {
+                deferredMemInsts[idx] = std::move(deferredMemInsts[idx + 1]);
+            }
+            deferredMemInsts.pop_back();
             return mem_inst;
         }
     }
@@ -1204,19 +1241,18 @@ template <class Impl>
 void
 InstructionQueue<Impl>::doSquash(ThreadID tid)
 {
-    // Start at the tail.
-    ListIt squash_it = instList[tid].end();
-    --squash_it;
+    InstRing &inst_list = instList[tid];
 
     DPRINTF(IQ, "[tid:%i] Squashing until sequence number %i!\n",
             tid, squashedSeqNum[tid]);
 
     // Squash any instructions younger than the squashed sequence number
-    // given.
-    while (squash_it != instList[tid].end() &&
-           (*squash_it)->seqNum > squashedSeqNum[tid]) {
+    // given, starting at the tail.
+    while (!inst_list.empty() &&
+           inst_list.back()->seqNum > squashedSeqNum[tid]) {
 
-        DynInstPtr squashed_inst = (*squash_it);
+        DynInstPtr squashed_inst = std::move(inst_list.back());
+        inst_list.pop_back();
         if (squashed_inst->isFloating()) {
             iqIOStats.fpInstQueueWrites++;
         } else if (squashed_inst->isVector()) {
@@ -1225,11 +1261,10 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
             iqIOStats.intInstQueueWrites++;
         }
 
-        // Only handle the instruction if it actually is in the IQ and
-        // hasn't already been squashed in the IQ.
-        if (squashed_inst->threadNumber != tid ||
-            squashed_inst->isSquashedInIQ()) {
-            --squash_it;
+        // Only handle the instruction if it hasn't already been squashed
+        // in the IQ.
+        assert(squashed_inst->threadNumber == tid);
+        if (squashed_inst->isSquashedInIQ()) {
             continue;
         }
 
@@ -1271,8 +1306,7 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
 
                     if (!squashed_inst->regs.readySrcIdx(src_reg_idx) &&
                         !src_reg->isFixedMapping()) {
-                        dependGraph.remove(src_reg->flatIndex(),
-                                           squashed_inst);
+                        depRemove(src_reg->flatIndex(), squashed_inst);
                     }
 
                     ++iqStats.squashedOperandsExamined;
@@ -1280,8 +1314,7 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
 
             } else if (!squashed_inst->isStoreConditional() ||
                        !squashed_inst->isCompleted()) {
-                NonSpecMapIt ns_inst_it =
-                    nonSpecInsts.find(squashed_inst->seqNum);
+                NonSpecIt ns_inst_it = findNonSpec(squashed_inst->seqNum);
 
                 // we remove non-speculative instructions from
                 // nonSpecInsts already when they are ready, and so we
@@ -1294,8 +1327,6 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
                            squashed_inst->isMemRef());
                 } else {
 
-                    (*ns_inst_it).second = NULL;
-
                     nonSpecInsts.erase(ns_inst_it);
 
                     ++iqStats.squashedNonSpecRemoved;
@@ -1335,10 +1366,9 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
             if (dest_reg->isFixedMapping()){
                 continue;
             }
-            assert(dependGraph.empty(dest_reg->flatIndex()));
-            dependGraph.clearInst(dest_reg->flatIndex());
+            assert(depEmpty(dest_reg->flatIndex()));
+            depClearInst(dest_reg->flatIndex());
         }
-        instList[tid].erase(squash_it--);
         ++iqStats.squashedInstsExamined;
     }
 }
@@ -1372,7 +1402,7 @@ InstructionQueue<Impl>::addToDependents(const DynInstPtr &new_inst)
                         new_inst->pcState(), src_reg->index(),
                         src_reg->className());
 
-                dependGraph.insert(src_reg->flatIndex(), new_inst);
+                depInsert(src_reg->flatIndex(), new_inst);
 
                 // Change the return value to indicate that something
                 // was added to the dependency graph.
@@ -1413,14 +1443,14 @@ InstructionQueue<Impl>::addToProducers(const DynInstPtr &new_inst)
             continue;
         }
 
-        if (!dependGraph.empty(dest_reg->flatIndex())) {
-            dependGraph.dump();
+        if (!depEmpty(dest_reg->flatIndex())) {
+            depDump();
             panic("Dependency graph %i (%s) (flat: %i) not empty!",
                   dest_reg->index(), dest_reg->className(),
                   dest_reg->flatIndex());
         }
 
-        dependGraph.setInst(dest_reg->flatIndex(), new_inst);
+        depSetInst(dest_reg->flatIndex(), new_inst);
 
         // Mark the scoreboard to say it's not yet ready.
         regScoreboard[dest_reg->flatIndex()] = false;
@@ -1454,16 +1484,7 @@ InstructionQueue<Impl>::addIfReady(const DynInstPtr &inst)
                 inst->pcState(), op_class, inst->seqNum);
 
         readyInsts[op_class].push(inst);
-
-        // Will need to reorder the list if either a queue is not on the list,
-        // or it has an older instruction than last time.
-        if (!queueOnList[op_class]) {
-            addToOrderList(op_class);
-        } else if (readyInsts[op_class].top()->seqNum  <
-                   (*readyIt[op_class]).oldestInst) {
-            listOrder.erase(readyIt[op_class]);
-            addToOrderList(op_class);
-        }
+        setReady(readyMask, op_class);
     }
 }
 
@@ -1486,31 +1507,20 @@ InstructionQueue<Impl>::dumpLists()
 
     cprintf("Non speculative list size: %i\n", nonSpecInsts.size());
 
-    NonSpecMapIt non_spec_it = nonSpecInsts.begin();
-    NonSpecMapIt non_spec_end_it = nonSpecInsts.end();
-
     cprintf("Non speculative list: ");
 
-    while (non_spec_it != non_spec_end_it) {
-        cprintf("%s [sn:%llu]", (*non_spec_it).second->pcState(),
-                (*non_spec_it).second->seqNum);
-        ++non_spec_it;
+    for (const auto &ns_inst : nonSpecInsts) {
+        cprintf("%s [sn:%llu]", ns_inst->pcState(), ns_inst->seqNum);
     }
 
     cprintf("\n");
 
-    ListOrderIt list_order_it = listOrder.begin();
-    ListOrderIt list_order_end_it = listOrder.end();
-    int i = 1;
-
-    cprintf("List order: ");
-
-    while (list_order_it != list_order_end_it) {
-        cprintf("%i OpClass:%i [sn:%llu] ", i, (*list_order_it).queueType,
-                (*list_order_it).oldestInst);
+    cprintf("Ready op classes: ");
 
-        ++list_order_it;
-        ++i;
+    for (int i = 0; i < Num_OpClasses; ++i) {
+        if (!readyInsts[i].empty()) {
+            cprintf("OpClass:%i [sn:%llu] ", i, readyInsts[i].top()->seqNum);
+        }
     }
 
     cprintf("\n");
@@ -413,7 +413,7 @@ class LSQ
                    const std::vector<bool>& byte_enable)
         {
             if (isAnyActiveElement(byte_enable.begin(), byte_enable.end())) {
-                auto request = std::make_shared<Request>(
+                auto request = Request::create(
                         addr, size, _flags, _inst->requestorId(),
                         _inst->instAddr(), _inst->contextId(),
                         std::move(_amo_op));
@@ -1067,6 +1067,11 @@ class LSQ
 
     /** Returns if the LSQ will write back to memory this cycle. */
     bool willWB();
+
+    /** Returns if the LSQ can't make progress until an event outside the
+     * pipeline, such as a memory response, arrives.
+     */
+    bool canSkipStall();
     /** Returns if the LSQ of a specific thread will write back to memory this
      * cycle.
      */
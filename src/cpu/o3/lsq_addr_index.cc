@@ -0,0 +1,130 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/lsq_addr_index.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/intmath.hh"
+
+void
+LSQAddrIndex::init(size_t queue_capacity, unsigned granule_shift)
+{
+    granuleShift = granule_shift;
+
+    // Keep the buckets sparsely populated so that most lookups only see
+    // entries that really share a granule with the access.
+    size_t num_buckets = std::max<size_t>(16, 2 * queue_capacity);
+    bucketBits = ceilLog2(num_buckets);
+    bucketMask = (Addr(1) << bucketBits) - 1;
+
+    buckets.assign(Addr(1) << bucketBits, std::vector<size_t>());
+    records.assign(queue_capacity, Record());
+}
+
+void
+LSQAddrIndex::clear()
+{
+    for (auto &b : buckets)
+        b.clear();
+    for (auto &r : records)
+        r.valid = false;
+}
+
+void
+LSQAddrIndex::granules(Addr addr, unsigned size,
+                       Addr &first, Addr &last) const
+{
+    // Mirror the granule arithmetic of the LSQ checks, including their
+    // handling of zero sized accesses.
+    first = addr >> granuleShift;
+    last = (addr + size - 1) >> granuleShift;
+    if (last < first)
+        std::swap(first, last);
+}
+
+void
+LSQAddrIndex::insert(size_t idx, Addr addr, unsigned size)
+{
+    Record &rec = records[idx % records.size()];
+    if (rec.valid)
+        remove(rec.idx);
+
+    rec.valid = true;
+    rec.idx = idx;
+    granules(addr, size, rec.first, rec.last);
+
+    // Accesses spanning more granules than there are buckets visit every
+    // bucket once.
+    Addr span = std::min<Addr>(rec.last - rec.first, bucketMask);
+    for (Addr g = rec.first; g <= rec.first + span; ++g) {
+        auto &b = bucket(g);
+        if (std::find(b.begin(), b.end(), idx) == b.end())
+            b.push_back(idx);
+    }
+}
+
+void
+LSQAddrIndex::remove(size_t idx)
+{
+    Record &rec = records[idx % records.size()];
+    if (!rec.valid || rec.idx != idx)
+        return;
+
+    Addr span = std::min<Addr>(rec.last - rec.first, bucketMask);
+    for (Addr g = rec.first; g <= rec.first + span; ++g) {
+        auto &b = bucket(g);
+        auto it = std::find(b.begin(), b.end(), idx);
+        if (it != b.end()) {
+            *it = b.back();
+            b.pop_back();
+        }
+    }
+
+    rec.valid = false;
+}
+
+void
+LSQAddrIndex::lookup(Addr addr, unsigned size, size_t min_idx,
+                     size_t max_idx, std::vector<size_t> &candidates) const
+{
+    candidates.clear();
+
+    Addr first, last;
+    granules(addr, size, first, last);
+
+    Addr span = std::min<Addr>(last - first, bucketMask);
+    for (Addr g = first; g <= first + span; ++g) {
+        for (size_t idx : bucket(g)) {
+            if (idx >= min_idx && idx < max_idx)
+                candidates.push_back(idx);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                     candidates.end());
+}
@@ -0,0 +1,117 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_LSQ_ADDR_INDEX_HH__
+#define __CPU_O3_LSQ_ADDR_INDEX_HH__
+
+#include <cstddef>
+#include <vector>
+
+#include "base/types.hh"
+
+/**
+ * Hashed index from address granules (typically cache lines) to the
+ * entries of a load or store queue.  Entries are identified by their
+ * monotonically increasing CircularQueue index.  A lookup returns every
+ * indexed entry that may touch one of the granules of an access; it is a
+ * superset of the overlapping entries since several granules may share
+ * a bucket, so callers must still check the actual addresses.  This lets
+ * the LSQ only examine candidate entries for store-to-load forwarding
+ * and memory order violation checks instead of walking whole queues.
+ */
+class LSQAddrIndex
+{
+  public:
+    /**
+     * Sizes the index.
+     *
+     * @param queue_capacity Capacity of the indexed queue.
+     * @param granule_shift Log2 of the granule size in bytes.
+     */
+    void init(size_t queue_capacity, unsigned granule_shift);
+
+    /** Removes all the entries from the index. */
+    void clear();
+
+    /**
+     * Indexes a queue entry under the granules touched by an access,
+     * replacing any previous record of the same entry.
+     */
+    void insert(size_t idx, Addr addr, unsigned size);
+
+    /** Removes a queue entry from the index, if it is indexed. */
+    void remove(size_t idx);
+
+    /**
+     * Collects the indexed entries in [min_idx, max_idx) that may touch
+     * the granules of an access, in increasing (oldest first) order and
+     * without duplicates.
+     */
+    void lookup(Addr addr, unsigned size, size_t min_idx, size_t max_idx,
+                std::vector<size_t> &candidates) const;
+
+  private:
+    /** First and last granule touched by an access. */
+    void granules(Addr addr, unsigned size, Addr &first, Addr &last) const;
+
+    /** Bucket a granule maps to. */
+    std::vector<size_t> &
+    bucket(Addr granule)
+    {
+        return buckets[(granule ^ (granule >> bucketBits)) & bucketMask];
+    }
+
+    const std::vector<size_t> &
+    bucket(Addr granule) const
+    {
+        return buckets[(granule ^ (granule >> bucketBits)) & bucketMask];
+    }
+
+    /** Granules an entry was indexed under. */
+    struct Record
+    {
+        bool valid = false;
+        size_t idx = 0;
+        Addr first = 0;
+        Addr last = 0;
+    };
+
+    /** Per queue slot records, indexed by idx modulo the capacity. */
+    std::vector<Record> records;
+
+    /** Queue indices per bucket. */
+    std::vector<std::vector<size_t>> buckets;
+
+    /** Log2 of the granule size. */
+    unsigned granuleShift = 0;
+
+    /** Log2 of the number of buckets. */
+    unsigned bucketBits = 0;
+
+    /** Mask selecting a bucket. */
+    Addr bucketMask = 0;
+};
+
+#endif // __CPU_O3_LSQ_ADDR_INDEX_HH__
@@ -0,0 +1,206 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "cpu/o3/lsq_addr_index.hh"
+
+namespace {
+
+struct Access
+{
+    Addr addr;
+    unsigned size;
+};
+
+/** Granules touched by an access, as the LSQ checks compute them. */
+void
+granules(const Access &acc, unsigned shift, Addr &first, Addr &last)
+{
+    first = acc.addr >> shift;
+    last = (acc.addr + acc.size - 1) >> shift;
+    if (last < first)
+        std::swap(first, last);
+}
+
+/**
+ * Checks a lookup against a linear scan of the live entries: the
+ * candidates must be sorted, unique, in range and live, and must include
+ * every entry sharing a granule with the access.
+ */
+void
+checkLookup(const LSQAddrIndex &index, const std::map<size_t, Access> &live,
+            const Access &acc, unsigned shift, size_t min_idx,
+            size_t max_idx)
+{
+    std::vector<size_t> candidates;
+    index.lookup(acc.addr, acc.size, min_idx, max_idx, candidates);
+
+    ASSERT_TRUE(std::is_sorted(candidates.begin(), candidates.end()));
+    ASSERT_TRUE(std::adjacent_find(candidates.begin(), candidates.end()) ==
+                candidates.end());
+    for (size_t idx : candidates) {
+        ASSERT_GE(idx, min_idx);
+        ASSERT_LT(idx, max_idx);
+        ASSERT_EQ(live.count(idx), 1);
+    }
+
+    Addr first, last;
+    granules(acc, shift, first, last);
+    for (const auto &entry : live) {
+        if (entry.first < min_idx || entry.first >= max_idx)
+            continue;
+        Addr e_first, e_last;
+        granules(entry.second, shift, e_first, e_last);
+        if (e_first <= last && first <= e_last) {
+            ASSERT_TRUE(std::binary_search(candidates.begin(),
+                                           candidates.end(), entry.first))
+                << "entry " << entry.first << " not found";
+        }
+    }
+}
+
+/**
+ * Drives an index the way the LSQ drives it over a queue: entries are
+ * appended at the tail, have their address set or changed, retire from
+ * the head or are squashed from the tail. The queue indices grow
+ * monotonically, so they wrap around the capacity many times.
+ */
+void
+checkAgainstScan(size_t capacity, unsigned shift, Addr addr_range,
+                 std::mt19937 &rng)
+{
+    LSQAddrIndex index;
+    index.init(capacity, shift);
+
+    std::map<size_t, Access> live;
+    size_t head = 1;
+    size_t tail = 1;
+
+    auto random_access = [&]() {
+        Access acc;
+        acc.addr = rng() % addr_range;
+        // Mostly small accesses, with some that span several granules
+        // and some of size zero
+        switch (rng() % 8) {
+          case 0:
+            acc.size = 0;
+            break;
+          case 1:
+            acc.size = rng() % (64 << shift) + 1;
+            break;
+          default:
+            acc.size = 1 << (rng() % 4);
+        }
+        return acc;
+    };
+
+    for (int step = 0; step < 50000; step++) {
+        const int action = rng() % 6;
+        if (action <= 1 && tail - head < capacity) {
+            // Allocate an entry, with its address known or not yet
+            size_t idx = tail++;
+            if (action == 0) {
+                Access acc = random_access();
+                index.insert(idx, acc.addr, acc.size);
+                live[idx] = acc;
+            }
+        } else if (action == 2 && tail > head) {
+            // Set or change the address of an allocated entry
+            size_t idx = head + rng() % (tail - head);
+            Access acc = random_access();
+            index.insert(idx, acc.addr, acc.size);
+            live[idx] = acc;
+        } else if (action == 3 && tail > head) {
+            // Retire the oldest entry
+            index.remove(head);
+            live.erase(head);
+            head++;
+        } else if (action == 4 && tail > head) {
+            // Squash the youngest entries
+            size_t num = rng() % (tail - head) + 1;
+            for (size_t i = 0; i < num; i++) {
+                tail--;
+                index.remove(tail);
+                live.erase(tail);
+            }
+        } else {
+            size_t min_idx = head;
+            if (tail > head)
+                min_idx += rng() % (tail - head);
+            checkLookup(index, live, random_access(), shift, min_idx, tail);
+        }
+        if (::testing::Test::HasFatalFailure())
+            return;
+    }
+
+    // The indices wrapped around the queue
+    ASSERT_GT(tail, 10 * capacity);
+}
+
+} // anonymous namespace
+
+TEST(LSQAddrIndexTest, SmallQueue)
+{
+    std::mt19937 rng(1);
+    checkAgainstScan(4, 6, 1024, rng);
+}
+
+TEST(LSQAddrIndexTest, LargeQueue)
+{
+    std::mt19937 rng(2);
+    checkAgainstScan(72, 6, 1 << 16, rng);
+}
+
+TEST(LSQAddrIndexTest, SharedBuckets)
+{
+    // Many more granules than buckets, so that unrelated entries share
+    // the buckets of an access
+    std::mt19937 rng(3);
+    checkAgainstScan(16, 3, 1 << 20, rng);
+}
+
+TEST(LSQAddrIndexTest, Clear)
+{
+    LSQAddrIndex index;
+    index.init(8, 6);
+    index.insert(1, 0x100, 8);
+    index.insert(2, 0x100, 8);
+    index.clear();
+
+    std::vector<size_t> candidates;
+    index.lookup(0x100, 8, 0, 16, candidates);
+    EXPECT_TRUE(candidates.empty());
+
+    // Entries can be indexed again after being cleared
+    index.insert(9, 0x100, 8);
+    index.lookup(0x100, 8, 0, 16, candidates);
+    EXPECT_EQ(candidates, std::vector<size_t>({9}));
+}
@@ -656,6 +656,22 @@ LSQ<Impl>::willWB()
     return false;
 }
 
+template<class Impl>
+bool
+LSQ<Impl>::canSkipStall()
+{
+    // Loads that ran out of cache ports are re-issued by the next tick.
+    if (usedLoadPorts == cacheLoadPorts && !_cacheBlocked)
+        return false;
+
+    for (ThreadID tid : *activeThreads) {
+        if (!thread[tid].canSkipStall())
+            return false;
+    }
+
+    return true;
+}
+
 template<class Impl>
 void
 LSQ<Impl>::dumpInsts() const
@@ -732,7 +748,7 @@ LSQ<Impl>::pushRequest(const DynInstPtr& inst, bool isLoad, uint8_t *data,
             inst->effAddrValid(true);
 
             if (cpu->checker) {
-                inst->reqToVerify = std::make_shared<Request>(*req->request());
+                inst->reqToVerify = Request::create(*req->request());
             }
             Fault fault;
             if (isLoad)
@@ -887,7 +903,7 @@ LSQ<Impl>::SplitDataRequest::initiateTranslation()
     Addr final_addr = addrBlockAlign(_addr + _size, cacheLineSize);
     uint32_t size_so_far = 0;
 
-    mainReq = std::make_shared<Request>(base_addr,
+    mainReq = Request::create(base_addr,
                 _size, _flags, _inst->requestorId(),
                 _inst->instAddr(), _inst->contextId());
     mainReq->setByteEnable(_byteEnable);
@@ -53,6 +53,7 @@
 #include "arch/locked_mem.hh"
 #include "config/the_isa.hh"
 #include "cpu/inst_seq.hh"
+#include "cpu/o3/lsq_addr_index.hh"
 #include "cpu/timebuf.hh"
 #include "debug/HtmCpu.hh"
 #include "debug/LSQUnit.hh"
@@ -367,6 +368,23 @@ class LSQUnit
                         !isStoreBlocked;
     }
 
+    /** Returns if no store can be written back until a response from
+     * memory arrives.
+     */
+    bool
+    canSkipStall()
+    {
+        if (isStoreBlocked)
+            return false;
+
+        // Under TSO the next store waits for the one in flight.
+        return !(storesToWB > 0 &&
+                 storeWBIt.dereferenceable() &&
+                 storeWBIt->valid() &&
+                 storeWBIt->canWB()) ||
+            (needsTSO && storeInFlight);
+    }
+
     /** Handles doing the retry. */
     void recvRetry();
 
@@ -498,6 +516,19 @@ class LSQUnit
     LoadQueue loadQueue;
 
   private:
+    /** Index of the executed stores by address, used to find the stores a
+     * load may forward from without walking the store queue.
+     */
+    LSQAddrIndex storeAddrIndex;
+
+    /** Index of the loads by address, used to find the loads a memory
+     * instruction may conflict with without walking the load queue.
+     */
+    LSQAddrIndex loadAddrIndex;
+
+    /** Candidate queue entries returned by the address indices. */
+    std::vector<size_t> addrCandidates;
+
     /** The number of places to shift addresses in the LSQ before checking
      * for dependency violations
      */
@@ -641,6 +672,10 @@ LSQUnit<Impl>::read(LSQRequest *req, int load_idx)
     load_req.setRequest(req);
     assert(load_inst);
 
+    // The effective address has just been computed; make the load visible
+    // to the violation checks of older stores and loads.
+    loadAddrIndex.insert(load_idx, load_inst->effAddr, load_inst->effSize);
+
     assert(!load_inst->isExecuted());
 
     // Make sure this isn't a strictly ordered load
@@ -731,13 +766,17 @@ LSQUnit<Impl>::read(LSQRequest *req, int load_idx)
         }
     }
 
-    // Check the SQ for any previous stores that might lead to forwarding
-    auto store_it = load_inst->sqIt;
-    assert (store_it >= storeWBIt);
-    // End once we've reached the top of the LSQ
-    while (store_it != storeWBIt) {
-        // Move the index to one younger
-        store_it--;
+    // Check the SQ for any previous stores that might lead to forwarding.
+    // Only the stores indexed under the same cache lines as the load can
+    // overlap with it, so only those are visited, youngest first, between
+    // the load and the top of the LSQ.
+    assert (load_inst->sqIt >= storeWBIt);
+    storeAddrIndex.lookup(req->mainRequest()->getVaddr(),
+                          req->mainRequest()->getSize(), storeWBIt._idx,
+                          load_inst->sqIt._idx, addrCandidates);
+    for (auto cand = addrCandidates.rbegin(); cand != addrCandidates.rend();
+         ++cand) {
+        auto store_it = storeQueue.getIterator(*cand);
         assert(store_it->valid());
         assert(store_it->instruction()->seqNum < load_inst->seqNum);
         int store_size = store_it->size();
@@ -968,6 +1007,12 @@ LSQUnit<Impl>::write(LSQRequest *req, uint8_t *data, int store_idx)
     storeQueue[store_idx].setRequest(req);
     unsigned size = req->_size;
     storeQueue[store_idx].size() = size;
+    if (size != 0) {
+        storeAddrIndex.insert(store_idx,
+                storeQueue[store_idx].instruction()->effAddr, size);
+    } else {
+        storeAddrIndex.remove(store_idx);
+    }
     bool store_no_data =
         req->mainRequest()->getFlags() & Request::STORE_NO_DATA;
     storeQueue[store_idx].isAllZeros() = store_no_data;
@@ -45,6 +45,7 @@
 
 #include "arch/generic/debugfaults.hh"
 #include "arch/locked_mem.hh"
+#include "base/intmath.hh"
 #include "base/str.hh"
 #include "config/the_isa.hh"
 #include "cpu/checker/cpu.hh"
@@ -232,6 +233,13 @@ LSQUnit<Impl>::init(O3CPU *cpu_ptr, IEW *iew_ptr,
     checkLoads = params.LSQCheckLoads;
     needsTSO = params.needsTSO;
 
+    // Index by cache line, or by the dependence check granule if that is
+    // coarser, so that overlapping accesses always share a bucket.
+    unsigned index_shift = std::max<unsigned>(
+            floorLog2(cpu->cacheLineSize()), depCheckShift);
+    storeAddrIndex.init(storeQueue.capacity(), index_shift);
+    loadAddrIndex.init(loadQueue.capacity(), index_shift);
+
     resetState();
 }
 
@@ -248,6 +256,9 @@ LSQUnit<Impl>::resetState()
 
     storeWBIt = storeQueue.begin();
 
+    storeAddrIndex.clear();
+    loadAddrIndex.clear();
+
     retryPkt = NULL;
     memDepViolator = NULL;
 
@@ -542,11 +553,16 @@ LSQUnit<Impl>::checkViolations(typename LoadQueue::iterator& loadIt,
      * however, there isn't a good way in the pipeline at the moment to check
      * all instructions that will execute before the store writes back. Thus,
      * like the implementation that came before it, we're overly conservative.
+     *
+     * Only the loads indexed under the same granules as the instruction can
+     * conflict with it, so only those are visited, oldest first.
      */
-    while (loadIt != loadQueue.end()) {
+    loadAddrIndex.lookup(inst->effAddr, inst->effSize, loadIt.idx(),
+                         loadQueue.end().idx(), addrCandidates);
+    for (size_t ld_idx : addrCandidates) {
+        loadIt = loadQueue.getIterator(ld_idx);
         DynInstPtr ld_inst = loadIt->instruction();
         if (!ld_inst->effAddrValid() || ld_inst->strictlyOrdered()) {
-            ++loadIt;
             continue;
         }
 
@@ -602,8 +618,6 @@ LSQUnit<Impl>::checkViolations(typename LoadQueue::iterator& loadIt,
                     inst->seqNum, ld_inst->seqNum, ld_eff_addr1);
             }
         }
-
-        ++loadIt;
     }
     return NoFault;
 }
@@ -739,6 +753,7 @@ LSQUnit<Impl>::commitLoad()
     DPRINTF(LSQUnit, "Committing head load instruction, PC %s\n",
             loadQueue.front().instruction()->pcState());
 
+    loadAddrIndex.remove(loadQueue.head());
     loadQueue.front().clear();
     loadQueue.pop_front();
 
@@ -982,6 +997,7 @@ LSQUnit<Impl>::squash(const InstSeqNum &squashed_num)
 
         --loads;
 
+        loadAddrIndex.remove(loadQueue.tail());
         loadQueue.pop_back();
         ++stats.squashedLoads;
     }
@@ -995,7 +1011,7 @@ LSQUnit<Impl>::squash(const InstSeqNum &squashed_num)
             !scan_it->instruction()->isSquashed()) {
             in_flight_uid = scan_it->instruction()->getHtmTransactionUid();
             DPRINTF(HtmCpu, "loadQueue[%d]: found valid HtmStart htmUid=%u\n",
-                scan_it._idx, in_flight_uid);
+                scan_it.idx(), in_flight_uid);
         }
         scan_it++;
     }
@@ -1054,6 +1070,7 @@ LSQUnit<Impl>::squash(const InstSeqNum &squashed_num)
         storeQueue.back().clear();
         --stores;
 
+        storeAddrIndex.remove(storeQueue.tail());
         storeQueue.pop_back();
         ++stats.squashedStores;
     }
@@ -1171,6 +1188,7 @@ LSQUnit<Impl>::completeStore(typename StoreQueue::iterator store_idx)
     DynInstPtr store_inst = store_idx->instruction();
     if (store_idx == storeQueue.begin()) {
         do {
+            storeAddrIndex.remove(storeQueue.head());
             storeQueue.front().clear();
             storeQueue.pop_front();
             --stores;
@@ -196,6 +196,17 @@ class DefaultRename
      */
     void tick();
 
+    /** Returns if the thread is stalled such that every cycle until an
+     * event outside the pipeline wakes the CPU would be identical.
+     */
+    bool canSkipStall(ThreadID tid);
+
+    /** Records which stall the skipped cycles are charged to. */
+    void beginStallSkip(ThreadID tid);
+
+    /** Accounts for the cycles skipped while stalled. */
+    void endStallSkip(Cycles cycles);
+
     /** Debugging function used to dump history buffer of renamings. */
     void dumpHistory();
 
@@ -462,6 +473,11 @@ class DefaultRename
     /** The maximum skid buffer size. */
     unsigned skidBufferMax;
 
+    /** Stall counter that the cycles skipped while stalled are charged
+     * to.
+     */
+    Stats::Scalar *skippedStallStat;
+
     /** Enum to record the source of a structure full stall.  Can come from
      * either ROB, IQ, LSQ, and it is priortized in that order.
      */
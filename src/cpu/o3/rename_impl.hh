@@ -62,6 +62,7 @@ DefaultRename<Impl>::DefaultRename(O3CPU *_cpu, const DerivO3CPUParams &params)
       renameWidth(params.renameWidth),
       commitWidth(params.commitWidth),
       numThreads(params.numThreads),
+      skippedStallStat(nullptr),
       stats(_cpu)
 {
     if (renameWidth > Impl::MaxWidth)
@@ -453,6 +454,42 @@ DefaultRename<Impl>::tick()
 
 }
 
+template<class Impl>
+bool
+DefaultRename<Impl>::canSkipStall(ThreadID tid)
+{
+    if (resumeSerialize || resumeUnblocking)
+        return false;
+
+    if (renameStatus[tid] == Blocked) {
+        return checkStall(tid);
+    } else if (renameStatus[tid] == Running || renameStatus[tid] == Idle) {
+        return !checkStall(tid) && insts[tid].empty();
+    }
+
+    return false;
+}
+
+template<class Impl>
+void
+DefaultRename<Impl>::beginStallSkip(ThreadID tid)
+{
+    assert(canSkipStall(tid));
+
+    skippedStallStat = renameStatus[tid] == Blocked ?
+        &stats.blockCycles : &stats.idleCycles;
+}
+
+template<class Impl>
+void
+DefaultRename<Impl>::endStallSkip(Cycles cycles)
+{
+    assert(skippedStallStat);
+
+    *skippedStallStat += cycles;
+    skippedStallStat = nullptr;
+}
+
 template<class Impl>
 void
 DefaultRename<Impl>::rename(bool &status_change, ThreadID tid)
@@ -128,8 +128,10 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
     bool pred_taken = false;
     TheISA::PCState target = pc;
 
-    ++stats.lookups;
-    ppBranches->notify(1);
+    if (!warming) {
+        ++stats.lookups;
+        ppBranches->notify(1);
+    }
 
     void *bp_history = NULL;
     void *indirect_history = NULL;
@@ -142,7 +144,8 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
         // Tell the BP there was an unconditional branch.
         uncondBranch(tid, pc.instAddr(), bp_history);
     } else {
-        ++stats.condPredicted;
+        if (!warming)
+            ++stats.condPredicted;
         pred_taken = lookup(tid, pc.instAddr(), bp_history);
 
         DPRINTF(Branch, "[tid:%i] [sn:%llu] "
@@ -165,7 +168,8 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
     // Now lookup in the BTB or RAS.
     if (pred_taken) {
         if (inst->isReturn()) {
-            ++stats.RASUsed;
+            if (!warming)
+                ++stats.RASUsed;
             predict_record.wasReturn = true;
             // If it's a function return call, then look up the address
             // in the RAS.
@@ -199,10 +203,12 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
             }
 
             if (inst->isDirectCtrl() || !iPred) {
-                ++stats.BTBLookups;
+                if (!warming)
+                    ++stats.BTBLookups;
                 // Check BTB on direct branches
                 if (BTB.valid(pc.instAddr(), tid)) {
-                    ++stats.BTBHits;
+                    if (!warming)
+                        ++stats.BTBHits;
                     // If it's not a return, use the BTB to get target addr.
                     target = BTB.lookup(pc.instAddr(), tid);
                     DPRINTF(Branch,
@@ -231,18 +237,21 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
                 }
             } else {
                 predict_record.wasIndirect = true;
-                ++stats.indirectLookups;
+                if (!warming)
+                    ++stats.indirectLookups;
                 //Consult indirect predictor on indirect control
                 if (iPred->lookup(pc.instAddr(), target, tid)) {
                     // Indirect predictor hit
-                    ++stats.indirectHits;
+                    if (!warming)
+                        ++stats.indirectHits;
                     DPRINTF(Branch,
                             "[tid:%i] [sn:%llu] "
                             "Instruction %s predicted "
                             "indirect target is %s\n",
                             tid, seqNum, pc, target);
                 } else {
-                    ++stats.indirectMisses;
+                    if (!warming)
+                        ++stats.indirectMisses;
                     pred_taken = false;
                     predict_record.predTaken = pred_taken;
                     DPRINTF(Branch,
@@ -291,6 +300,32 @@ BPredUnit::predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
     return pred_taken;
 }
 
+bool
+BPredUnit::warm(const StaticInstPtr &inst, const TheISA::PCState &pc,
+                const TheISA::PCState &target, bool taken, ThreadID tid)
+{
+    // The branch commits right away, so a fixed sequence number is
+    // enough and the history never holds more than one entry.
+    const InstSeqNum warm_sn(0);
+    assert(predHist[tid].empty());
+
+    // Warming trains the tables on behalf of a CPU that is not
+    // simulated in detail, so keep it out of the stats and probes.
+    warming = true;
+
+    TheISA::PCState pred_pc(pc);
+    predict(inst, warm_sn, pred_pc, tid);
+
+    const bool correct(pred_pc == target);
+    if (!correct)
+        squash(warm_sn, target, taken, tid);
+    update(warm_sn, tid);
+
+    warming = false;
+
+    return correct;
+}
+
 void
 BPredUnit::update(const InstSeqNum &done_sn, ThreadID tid)
 {
@@ -377,8 +412,10 @@ BPredUnit::squash(const InstSeqNum &squashed_sn,
 
     History &pred_hist = predHist[tid];
 
-    ++stats.condIncorrect;
-    ppMisses->notify(1);
+    if (!warming) {
+        ++stats.condIncorrect;
+        ppMisses->notify(1);
+    }
 
     DPRINTF(Branch, "[tid:%i] Squashing from sequence number %i, "
             "setting target to %s\n", tid, squashed_sn, corrTarget);
@@ -405,7 +442,8 @@ BPredUnit::squash(const InstSeqNum &squashed_sn,
 
 
         if ((*hist_it).usedRAS) {
-            ++stats.RASIncorrect;
+            if (!warming)
+                ++stats.RASIncorrect;
             DPRINTF(Branch,
                     "[tid:%i] [squash sn:%llu] Incorrect RAS [sn:%llu]\n",
                     tid, squashed_sn, hist_it->seqNum);
@@ -444,7 +482,8 @@ BPredUnit::squash(const InstSeqNum &squashed_sn,
                  hist_it->usedRAS = true;
             }
             if (hist_it->wasIndirect) {
-                ++stats.indirectMispredicted;
+                if (!warming)
+                    ++stats.indirectMispredicted;
                 if (iPred) {
                     iPred->recordTarget(
                         hist_it->seqNum, pred_hist.front().indirectHistory,
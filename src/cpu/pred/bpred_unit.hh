@@ -84,6 +84,21 @@ class BPredUnit : public SimObject
     bool predict(const StaticInstPtr &inst, const InstSeqNum &seqNum,
                  TheISA::PCState &pc, ThreadID tid);
 
+    /**
+     * Trains the predictor with a branch that is already resolved, by
+     * predicting it and then immediately committing or correcting the
+     * prediction. Used by CPUs that functionally warm the predictor of
+     * another CPU without keeping branches in flight.
+     * @param inst The branch instruction.
+     * @param pc The PC state of the branch before it executed.
+     * @param target The PC state the branch resolved to.
+     * @param taken Whether the branch was actually taken.
+     * @param tid The thread id.
+     * @return Returns if the branch was correctly predicted.
+     */
+    bool warm(const StaticInstPtr &inst, const TheISA::PCState &pc,
+              const TheISA::PCState &target, bool taken, ThreadID tid);
+
     // @todo: Rename this function.
     virtual void uncondBranch(ThreadID tid, Addr pc, void * &bp_history) = 0;
 
@@ -311,6 +326,12 @@ class BPredUnit : public SimObject
     /** Number of bits to shift instructions by for predictor addresses. */
     const unsigned instShiftAmt;
 
+    /**
+     * Set while warm() trains the predictor. Stats and probe points
+     * are only updated for branches the owning CPU really predicted.
+     */
+    bool warming = false;
+
     /**
      * @{
      * @name PMU Probe points.
@@ -0,0 +1,226 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/branch_trace_replay.hh"
+
+#include <chrono>
+
+#include "base/logging.hh"
+#include "proto/branch_trace.pb.h"
+#include "sim/sim_exit.hh"
+
+namespace
+{
+
+/**
+ * Control instruction standing in for a trace record. Only the flags
+ * that the branch predictors look at are set.
+ */
+class TraceBranchInst : public StaticInst
+{
+  public:
+    TraceBranchInst(uint32_t trace_flags)
+        : StaticInst("trace branch", TheISA::ExtMachInst(), No_OpClass)
+    {
+        typedef ProtoMessage::BranchRecord Record;
+
+        flags[IsControl] = true;
+        flags[IsCondControl] = trace_flags & Record::COND;
+        flags[IsUncondControl] = trace_flags & Record::UNCOND;
+        flags[IsDirectControl] = trace_flags & Record::DIRECT;
+        flags[IsIndirectControl] = trace_flags & Record::INDIRECT;
+        flags[IsCall] = trace_flags & Record::CALL;
+        flags[IsReturn] = trace_flags & Record::RETURN;
+    }
+
+    Fault
+    execute(ExecContext *xc, Trace::InstRecord *traceData) const override
+    {
+        panic("Trace branches can not be executed.\n");
+    }
+
+    void
+    advancePC(TheISA::PCState &pcState) const override
+    {
+        pcState.advance();
+    }
+
+    std::string
+    generateDisassembly(Addr pc,
+            const Loader::SymbolTable *symtab) const override
+    {
+        return mnemonic;
+    }
+};
+
+} // anonymous namespace
+
+BranchTraceReplay::BranchTraceReplay(const BranchTraceReplayParams &p)
+    : SimObject(p),
+      predictors(p.predictors),
+      trace(p.trace_file),
+      maxBranches(p.max_branches),
+      traceDone(false),
+      chunkSeqNum(1),
+      replayEvent([this]{ replay(); }, name()),
+      stats(this)
+{
+    fatal_if(predictors.empty(), "%s has no branch predictors.\n", name());
+
+    ProtoMessage::BranchTraceHeader header;
+    panic_if(!trace.read(header), "Failed to read branch trace header "
+             "from %s\n", p.trace_file);
+
+    chunk.reserve(chunkSize);
+}
+
+void
+BranchTraceReplay::startup()
+{
+    schedule(replayEvent, curTick());
+}
+
+const StaticInstPtr &
+BranchTraceReplay::branchInst(uint32_t flags)
+{
+    StaticInstPtr &inst = branchInsts[flags % branchInsts.size()];
+    if (!inst)
+        inst = new TraceBranchInst(flags);
+    return inst;
+}
+
+void
+BranchTraceReplay::readChunk()
+{
+    chunk.clear();
+
+    ProtoMessage::BranchRecord rec;
+    while (chunk.size() < chunkSize) {
+        if ((maxBranches && stats.branches.value() >= maxBranches) ||
+            !trace.read(rec)) {
+            traceDone = true;
+            break;
+        }
+
+        chunk.push_back(Branch{rec.pc(), rec.target(), rec.size(),
+                               rec.flags(), rec.taken()});
+        stats.branches++;
+        stats.insts += rec.insts();
+    }
+}
+
+void
+BranchTraceReplay::replayChunk(size_t idx)
+{
+    BPredUnit *bp = predictors[idx];
+    InstSeqNum seq_num = chunkSeqNum;
+    const ThreadID tid = 0;
+
+    for (const auto &branch : chunk) {
+        TheISA::PCState pc(branch.pc);
+        pc.npc(branch.pc + branch.size);
+
+        bp->predict(branchInst(branch.flags), seq_num, pc, tid);
+
+        if (pc.instAddr() != branch.target) {
+            stats.mispredicts[idx]++;
+            bp->squash(seq_num, TheISA::PCState(branch.target),
+                       branch.taken, tid);
+        }
+        bp->update(seq_num, tid);
+
+        ++seq_num;
+    }
+}
+
+void
+BranchTraceReplay::replay()
+{
+    typedef std::chrono::steady_clock Clock;
+
+    while (!traceDone) {
+        readChunk();
+
+        for (size_t idx = 0; idx < predictors.size(); idx++) {
+            auto start = Clock::now();
+            replayChunk(idx);
+            std::chrono::duration<double> elapsed = Clock::now() - start;
+            stats.hostSeconds[idx] += elapsed.count();
+        }
+
+        chunkSeqNum += chunk.size();
+    }
+
+    const double branches = stats.branches.value();
+    const double insts = stats.insts.value();
+    for (size_t idx = 0; idx < predictors.size(); idx++) {
+        const double mispredicts = stats.mispredicts[idx].value();
+        const double seconds = stats.hostSeconds[idx].value();
+        inform("%s: %.0f branches, %.0f mispredicted, %.4f MPKI, "
+               "%.0f branches/s\n", predictors[idx]->name(),
+               branches, mispredicts,
+               insts ? 1000 * mispredicts / insts : 0.0,
+               seconds ? branches / seconds : 0.0);
+    }
+
+    exitSimLoop("branch trace replay complete");
+}
+
+BranchTraceReplay::ReplayStats::ReplayStats(BranchTraceReplay *parent)
+    : Stats::Group(parent),
+      ADD_STAT(branches, UNIT_COUNT, "Number of branches replayed"),
+      ADD_STAT(insts, UNIT_COUNT,
+               "Number of instructions covered by the replayed branches"),
+      ADD_STAT(mispredicts, UNIT_COUNT,
+               "Number of mispredicted branches per predictor"),
+      ADD_STAT(mpki, UNIT_RATIO,
+               "Mispredictions per thousand instructions per predictor",
+               mispredicts * 1000 / insts),
+      ADD_STAT(hostSeconds, UNIT_SECOND,
+               "Host time spent replaying each predictor"),
+      ADD_STAT(hostBranchRate,
+               UNIT_RATE(Stats::Units::Count, Stats::Units::Second),
+               "Branches replayed per host second per predictor",
+               branches / hostSeconds)
+{
+    const auto &predictors = parent->predictors;
+
+    mispredicts.init(predictors.size());
+    hostSeconds.init(predictors.size());
+    for (size_t idx = 0; idx < predictors.size(); idx++) {
+        // Name the entries after the predictor objects, e.g. predictors0
+        const std::string &path = predictors[idx]->name();
+        const std::string leaf = path.substr(path.rfind('.') + 1);
+        mispredicts.subname(idx, leaf);
+        mpki.subname(idx, leaf);
+        hostSeconds.subname(idx, leaf);
+        hostBranchRate.subname(idx, leaf);
+    }
+
+    mpki.precision(4);
+    hostSeconds.precision(2);
+    hostBranchRate.precision(0);
+}
+
@@ -0,0 +1,129 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_BRANCH_TRACE_REPLAY_HH__
+#define __CPU_PRED_BRANCH_TRACE_REPLAY_HH__
+
+#include <array>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/pred/bpred_unit.hh"
+#include "cpu/static_inst.hh"
+#include "params/BranchTraceReplay.hh"
+#include "proto/protoio.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+/**
+ * Drives one or more branch predictors from a branch trace, as recorded
+ * by the BranchTrace probe, without simulating a CPU. Each committed
+ * control instruction of the trace is predicted and then immediately
+ * resolved, squashing the predictor on a misprediction, which mirrors how
+ * the simple CPUs use a branch predictor. The predictors are regular
+ * BranchPredictor SimObjects so they are configured with their actual
+ * parameters and keep their own statistics.
+ *
+ * The trace is decoded in chunks that are replayed against each
+ * predictor in turn, so that the host time spent in each predictor can
+ * be reported along with its MPKI. The replay runs from a single event
+ * scheduled at startup and exits the simulation loop when done.
+ */
+class BranchTraceReplay : public SimObject
+{
+  public:
+    BranchTraceReplay(const BranchTraceReplayParams &params);
+
+    void startup() override;
+
+  private:
+    /** A decoded trace record. */
+    struct Branch
+    {
+        Addr pc;
+        Addr target;
+        uint32_t size;
+        uint32_t flags;
+        bool taken;
+    };
+
+    /** Number of records decoded and replayed at a time. */
+    static const size_t chunkSize = 64 * 1024;
+
+    /** Replay the whole trace and exit the simulation loop. */
+    void replay();
+
+    /** Decode the next chunk of the trace into the chunk buffer. */
+    void readChunk();
+
+    /** Replay the chunk buffer on one predictor. */
+    void replayChunk(size_t idx);
+
+    /** Get the instruction standing in for the given trace flags. */
+    const StaticInstPtr &branchInst(uint32_t flags);
+
+    const std::vector<BPredUnit *> predictors;
+
+    /** Input stream of the trace */
+    ProtoInputStream trace;
+
+    /** Maximum number of branches to replay, 0 for the whole trace */
+    const uint64_t maxBranches;
+
+    /** Set once the end of the trace has been reached */
+    bool traceDone;
+
+    /** Sequence number of the first branch in the chunk buffer */
+    InstSeqNum chunkSeqNum;
+
+    /** Records of the current chunk */
+    std::vector<Branch> chunk;
+
+    /** Stand-in instructions, indexed by trace flags */
+    std::array<StaticInstPtr, 64> branchInsts;
+
+    EventFunctionWrapper replayEvent;
+
+    struct ReplayStats : public Stats::Group
+    {
+        ReplayStats(BranchTraceReplay *parent);
+
+        /** Branches replayed */
+        Stats::Scalar branches;
+        /** Instructions covered by the replayed branches */
+        Stats::Scalar insts;
+        /** Mispredicted branches, per predictor */
+        Stats::Vector mispredicts;
+        /** Mispredictions per thousand instructions, per predictor */
+        Stats::Formula mpki;
+        /** Host time spent in each predictor */
+        Stats::Vector hostSeconds;
+        /** Branches replayed per host second, per predictor */
+        Stats::Formula hostBranchRate;
+    } stats;
+};
+
+#endif // __CPU_PRED_BRANCH_TRACE_REPLAY_HH__
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2014 The University of Wisconsin
+ *
+ * Copyright (c) 2006 INRIA (Institut National de Recherche en
+ * Informatique et en Automatique  / French National Research Institute
+ * for Computer Science and Applied Mathematics)
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/folded_histories.hh"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <cstring>
+
+#include "base/types.hh"
+
+void
+FoldedHistories::resize(unsigned num_banks)
+{
+    numBanks = num_banks;
+    const size_t size = NumFolds * num_banks;
+    comp.assign(size, 0);
+    mask.assign(size, 0);
+    compLength.assign(size, 0);
+    origLength.assign(size, 0);
+    outpoint.assign(size, 0);
+}
+
+void
+FoldedHistories::init(int fold, int bank, int original_length,
+                      int compressed_length)
+{
+    const size_t k = fold * numBanks + bank;
+    origLength[k] = original_length;
+    compLength[k] = compressed_length;
+    outpoint[k] = original_length % compressed_length;
+    mask[k] = (ULL(1) << compressed_length) - 1;
+}
+
+void
+FoldedHistories::update(const uint8_t *h)
+{
+    const size_t size = comp.size();
+    size_t k = 0;
+
+#if defined(__AVX2__)
+    // Eight folds at a time. The history bits are gathered as words and
+    // masked down to their low byte, hence the padding of the history
+    // buffer.
+    const __m256i newest = _mm256_set1_epi32(h[0]);
+    const __m256i low_byte = _mm256_set1_epi32(0xff);
+    for (; k + 8 <= size; k += 8) {
+        __m256i c = _mm256_loadu_si256((const __m256i *)&comp[k]);
+        const __m256i orig = _mm256_loadu_si256(
+            (const __m256i *)&origLength[k]);
+        const __m256i out = _mm256_loadu_si256(
+            (const __m256i *)&outpoint[k]);
+        const __m256i len = _mm256_loadu_si256(
+            (const __m256i *)&compLength[k]);
+        const __m256i m = _mm256_loadu_si256((const __m256i *)&mask[k]);
+        const __m256i oldest = _mm256_and_si256(
+            _mm256_i32gather_epi32((const int *)h, orig, 1), low_byte);
+
+        c = _mm256_or_si256(_mm256_slli_epi32(c, 1), newest);
+        c = _mm256_xor_si256(c, _mm256_sllv_epi32(oldest, out));
+        c = _mm256_xor_si256(c, _mm256_srlv_epi32(c, len));
+        c = _mm256_and_si256(c, m);
+        _mm256_storeu_si256((__m256i *)&comp[k], c);
+    }
+#endif
+
+    // Scalar fallback, and the tail of the vector loop. It is written
+    // without control flow so the compiler can vectorize it too.
+    const unsigned newest_bit = h[0];
+    for (; k < size; k++) {
+        unsigned c = (comp[k] << 1) | newest_bit;
+        c ^= h[origLength[k]] << outpoint[k];
+        c ^= (c >> compLength[k]);
+        comp[k] = c & mask[k];
+    }
+}
+
+void
+FoldedHistories::save(int *dst) const
+{
+    static_assert(sizeof(int) == sizeof(unsigned),
+                  "Folded histories are saved as int");
+    memcpy(dst, comp.data(), comp.size() * sizeof(unsigned));
+}
+
+void
+FoldedHistories::restore(const int *src)
+{
+    memcpy(comp.data(), src, comp.size() * sizeof(unsigned));
+}
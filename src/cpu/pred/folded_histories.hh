@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2014 The University of Wisconsin
+ *
+ * Copyright (c) 2006 INRIA (Institut National de Recherche en
+ * Informatique et en Automatique  / French National Research Institute
+ * for Computer Science and Applied Mathematics)
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Folded global histories of the TAGE based branch predictors.
+ */
+
+#ifndef __CPU_PRED_FOLDED_HISTORIES_HH__
+#define __CPU_PRED_FOLDED_HISTORIES_HH__
+
+#include <cstdint>
+#include <vector>
+
+// Folded History Table - compressed history
+// to mix with instruction PC to index partially
+// tagged tables.
+// The three folds of every table (one for the index and two for the
+// tag) are kept as a structure of arrays, fold-major, so that the
+// per-branch update of all of them is a single loop over contiguous
+// arrays. The bank 0 (bimodal) slots are present but have a zero
+// mask, so they always read as zero.
+class FoldedHistories
+{
+  public:
+    enum
+    {
+        IndexFold = 0,
+        TagFold0,
+        TagFold1,
+        NumFolds
+    };
+
+    unsigned numBanks = 0;
+    std::vector<unsigned> comp;
+    std::vector<unsigned> mask;
+    std::vector<int> compLength;
+    std::vector<int> origLength;
+    std::vector<int> outpoint;
+
+    void resize(unsigned num_banks);
+
+    void init(int fold, int bank, int original_length,
+              int compressed_length);
+
+    unsigned
+    indexFold(int bank) const
+    {
+        return comp[bank];
+    }
+
+    unsigned
+    tagFold(int which, int bank) const
+    {
+        return comp[(TagFold0 + which) * numBanks + bank];
+    }
+
+    /**
+     * Shift the newest history bit h[0] into every fold.
+     * @param h Pointer to the most recent outcome in the global
+     * history buffer. Up to sizeof(int) - 1 bytes past
+     * h[origLength] may be read.
+     */
+    void update(const uint8_t *h);
+
+    /**
+     * Save/restore all the folds to/from a BranchInfo checkpoint,
+     * whose ci, ct0 and ct1 arrays are laid out back to back.
+     */
+    void save(int *dst) const;
+    void restore(const int *src);
+};
+
+#endif // __CPU_PRED_FOLDED_HISTORIES_HH__
@@ -0,0 +1,147 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "cpu/pred/folded_histories.hh"
+
+/**
+ * The folded history of a single table, updated one fold at a time as the
+ * TAGE predictors originally did. It is the reference the folds of all the
+ * tables, updated together (eight at a time with AVX2), are checked
+ * against.
+ */
+struct FoldedHistory
+{
+    unsigned comp = 0;
+    int compLength = 0;
+    int origLength = 0;
+    int outpoint = 0;
+
+    void
+    init(int original_length, int compressed_length)
+    {
+        origLength = original_length;
+        compLength = compressed_length;
+        outpoint = original_length % compressed_length;
+    }
+
+    void
+    update(const uint8_t *h)
+    {
+        comp = (comp << 1) | h[0];
+        comp ^= h[origLength] << outpoint;
+        comp ^= (comp >> compLength);
+        comp &= (1ULL << compLength) - 1;
+    }
+};
+
+/**
+ * Sets up num_banks tables with random history lengths and fold widths,
+ * leaving bank 0 (the bimodal table) unused as TAGE does, and shifts
+ * random outcomes through both implementations.
+ */
+static void
+checkFoldedHistories(unsigned num_banks, int max_length,
+                     std::mt19937 &rng)
+{
+    FoldedHistories folded;
+    folded.resize(num_banks);
+    std::vector<FoldedHistory> ref(FoldedHistories::NumFolds * num_banks);
+
+    for (unsigned bank = 1; bank < num_banks; bank++) {
+        const int length = 1 + rng() % max_length;
+        const int index_bits = 1 + rng() % 16;
+        const int tag_bits = 2 + rng() % 15;
+        const int widths[] = { index_bits, tag_bits, tag_bits - 1 };
+        for (int fold = 0; fold < FoldedHistories::NumFolds; fold++) {
+            folded.init(fold, bank, length, widths[fold]);
+            ref[fold * num_banks + bank].init(length, widths[fold]);
+        }
+    }
+
+    // The most recent outcome is the lowest address, and up to
+    // sizeof(int) - 1 bytes past the oldest one may be read
+    const int num_updates = 20000;
+    std::vector<uint8_t> history(num_updates + max_length + sizeof(int));
+    std::generate(history.begin(), history.end(),
+                  [&rng]() { return rng() % 2; });
+
+    std::vector<int> checkpoint(FoldedHistories::NumFolds * num_banks);
+    for (int i = num_updates; i > 0; i--) {
+        const uint8_t *h = &history[i];
+        folded.update(h);
+        for (auto &fold : ref) {
+            fold.update(h);
+        }
+
+        for (unsigned bank = 1; bank < num_banks; bank++) {
+            ASSERT_EQ(ref[bank].comp, folded.indexFold(bank));
+            for (int which = 0; which < 2; which++) {
+                ASSERT_EQ(ref[(1 + which) * num_banks + bank].comp,
+                          folded.tagFold(which, bank));
+            }
+        }
+
+        // Checkpoint now and then, and go back to it after a few updates
+        // as a misprediction would
+        if (i % 97 == 0) {
+            folded.save(checkpoint.data());
+        } else if (i % 97 == 50) {
+            folded.restore(checkpoint.data());
+            for (size_t k = 0; k < checkpoint.size(); k++) {
+                ref[k].comp = checkpoint[k];
+            }
+        }
+    }
+
+    // The bimodal slots are never initialized and must read as zero
+    EXPECT_EQ(0, folded.indexFold(0));
+    EXPECT_EQ(0, folded.tagFold(0, 0));
+    EXPECT_EQ(0, folded.tagFold(1, 0));
+}
+
+/** Table counts of the TAGE configurations, with and without a vector tail */
+TEST(FoldedHistoriesTest, TageConfigurations)
+{
+    std::mt19937 rng(0x7a6e);
+    for (unsigned num_banks : { 8u, 13u, 16u, 22u, 37u }) {
+        checkFoldedHistories(num_banks, 3000, rng);
+    }
+}
+
+/** Any number of tables, including fewer folds than a vector holds */
+TEST(FoldedHistoriesTest, RandomConfigurations)
+{
+    std::mt19937 rng(0xf01d);
+    for (unsigned num_banks = 1; num_banks <= 24; num_banks++) {
+        checkFoldedHistories(num_banks, 1 + rng() % 2000, rng);
+    }
+}
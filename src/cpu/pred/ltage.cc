@@ -112,9 +112,10 @@ LTAGE::update(ThreadID tid, Addr branch_pc, bool taken, void* bp_history,
     if (bi->tageBranchInfo->condBranch) {
         DPRINTF(LTage, "Updating tables for branch:%lx; taken?:%d\n",
                 branch_pc, taken);
-        tage->updateStats(taken, bi->tageBranchInfo);
-
-        loopPredictor->updateStats(taken, bi->lpBranchInfo);
+        if (!warming) {
+            tage->updateStats(taken, bi->tageBranchInfo);
+            loopPredictor->updateStats(taken, bi->lpBranchInfo);
+        }
 
         loopPredictor->condBranchUpdate(tid, branch_pc, taken,
             bi->tageBranchInfo->tagePred, bi->lpBranchInfo, instShiftAmt);
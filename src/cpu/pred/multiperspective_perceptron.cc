@@ -39,6 +39,7 @@
 #include "cpu/pred/multiperspective_perceptron.hh"
 
 #include "base/random.hh"
+#include "cpu/pred/perceptron_weights.hh"
 #include "debug/Branch.hh"
 
 int
@@ -98,15 +99,26 @@ MultiperspectivePerceptron::ThreadData::ThreadData(int num_filters,
         modpath_histories[modpath_indices[i]].resize(modpath_lengths[i]);
     }
 
+    size_t num_weights = 0;
+    for (int i = 0; i < table_sizes.size(); i += 1) {
+        num_weights += table_sizes[i];
+    }
+    // Leave room for a partial word at the end, for the gathers
+    weights.resize(num_weights + sizeof(int) - 1, 0);
+    signs.resize(num_weights + sizeof(int) - 1, 0);
+    indices.resize(table_sizes.size());
+    values.resize(table_sizes.size());
+
+    size_t offset = 0;
     for (int i = 0; i < table_sizes.size(); i += 1) {
         mpreds.push_back(0);
-        tables.push_back(std::vector<short int>(table_sizes[i]));
-        sign_bits.push_back(std::vector<std::array<bool, 2>>(table_sizes[i]));
-        for (int j = 0; j < table_sizes[i]; j += 1) {
-            for (int k = 0; k < n_sign_bits; k += 1) {
-                sign_bits[i][j][k] = (i & 1) | (k & 1);
-            }
+        uint8_t initial_signs = 0;
+        for (int k = 0; k < n_sign_bits; k += 1) {
+            initial_signs |= ((i & 1) | (k & 1)) << k;
         }
+        std::fill(signs.begin() + offset,
+                  signs.begin() + offset + table_sizes[i], initial_signs);
+        offset += table_sizes[i];
     }
 }
 
@@ -156,6 +168,30 @@ MultiperspectivePerceptron::init()
     computeBits(p.num_filter_entries, p.num_local_histories,
                 p.local_history_length, p.ignore_path_size);
 
+    fatal_if(n_sign_bits < 1 || n_sign_bits > 8,
+             "The number of sign bits must be between 1 and 8.");
+
+    // Lay the tables out back to back and tabulate the transfer
+    // functions of each table, with and without its coefficient
+    unsigned int offset = 0;
+    for (int i = 0; i < specs.size(); i += 1) {
+        const HistorySpec &spec = *specs[i];
+        fatal_if(spec.width < 1 || spec.width > 6,
+                 "Perceptron table widths must be between 1 and 6.");
+        tableOffsets.push_back(offset);
+        offset += table_sizes[i];
+        maxWeights.push_back((1 << (spec.width - 1)) - 1);
+        for (int c = 0; c < xlatEntries; c += 1) {
+            int weight = 0;
+            if (c <= maxWeights[i]) {
+                weight = (spec.width == 5) ? xlat4[c] : xlat[c];
+            }
+            int scaled_weight = spec.coeff * weight;
+            rawXlat.push_back(weight);
+            scaledXlat.push_back(scaled_weight);
+        }
+    }
+
     for (int i = 0; i < threadData.size(); i += 1) {
         threadData[i] = new ThreadData(p.num_filter_entries,
                                        p.num_local_histories,
@@ -328,33 +364,18 @@ MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
     // begin computation of the sum for low-confidence branch
     int bestval = 0;
 
+    ThreadData &td = *threadData[tid];
+    computeIndices(tid, bi, td.indices.data());
+    gatherWeights(td, td.indices.data(), bi.getHPC() % n_sign_bits,
+                  scaledXlat.data(), td.values.data());
+
     for (int i = 0; i < specs.size(); i += 1) {
-        HistorySpec const &spec = *specs[i];
-        // get the hash to index the table
-        unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-        // add the weight; first get the weight's magnitude
-        int counter = threadData[tid]->tables[i][hashed_idx];
-        // get the sign
-        bool sign =
-          threadData[tid]->sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
-        // apply the transfer function and multiply by a coefficient
-        int weight = spec.coeff * ((spec.width == 5) ?
-                                   xlat4[counter] : xlat[counter]);
-        // apply the sign
-        int val = sign ? -weight : weight;
-        // add the value
-        bi.yout += val;
-        // if this is one of those good features, add the value to bestval
-        if (threshold >= 0) {
-            for (int j = 0;
-                 j < std::min(nbest, (int) best_preds.size());
-                 j += 1)
-            {
-                if (best_preds[j] == i) {
-                    bestval += val;
-                    break;
-                }
-            }
+        bi.yout += td.values[i];
+    }
+    // add the values of those good features to bestval
+    if (threshold >= 0) {
+        for (int j = 0; j < std::min(nbest, (int) best_preds.size()); j += 1) {
+            bestval += td.values[best_preds[j]];
         }
     }
     // apply a fudge factor to affect when training is triggered
@@ -363,68 +384,65 @@ MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
 }
 
 void
-MultiperspectivePerceptron::satIncDec(bool taken, bool &sign, int &counter,
-                                      int max_weight) const
+MultiperspectivePerceptron::computeIndices(ThreadID tid,
+        const MPPBranchInfo &bi, unsigned int *indices) const
 {
-    if (taken) {
-        // increment sign/magnitude
-        if (sign) {
-            // go toward 0 away from negative max weight
-            if (counter == 0) {
-                sign = false; // moved to positive 0
-            } else {
-                counter -= 1;
-            }
-        } else {
-            // go toward max weight away from 0
-            if (counter < max_weight) {
-                counter += 1;
-            }
-        }
-    } else {
-        // decrement sign/magnitude
-        if (sign) {
-            // go toward negative max weight down from 0
-            if (counter < max_weight) {
-                counter += 1;
-            }
-        } else {
-            // go toward 0 away from max weight
-            if (counter == 0) {
-                sign = true; // negative 0
-            } else {
-                counter -= 1;
-            }
-        }
+    for (int i = 0; i < specs.size(); i += 1) {
+        indices[i] = tableOffsets[i] + getIndex(tid, bi, *specs[i], i);
     }
 }
 
+void
+MultiperspectivePerceptron::gatherWeights(const ThreadData &td,
+        const unsigned int *indices, unsigned int sign_bit,
+        const int *table_xlat, int *values) const
+{
+    gatherPerceptronWeights(td.weights.data(), td.signs.data(), indices,
+                            specs.size(), sign_bit, table_xlat, xlatEntries,
+                            values);
+}
+
+int
+MultiperspectivePerceptron::updateWeights(ThreadData &td,
+        const unsigned int *indices, unsigned int sign_bit, bool taken) const
+{
+    return updatePerceptronWeights(td.weights.data(), td.signs.data(),
+                                   indices, specs.size(), sign_bit, taken,
+                                   maxWeights.data(), rawXlat.data(),
+                                   xlatEntries);
+}
+
 void
 MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
 {
-    std::vector<std::vector<short int>> &tables = threadData[tid]->tables;
-    std::vector<std::vector<std::array<bool, 2>>> &sign_bits =
-            threadData[tid]->sign_bits;
-    std::vector<int> &mpreds = threadData[tid]->mpreds;
+    ThreadData &td = *threadData[tid];
+    std::vector<int> &mpreds = td.mpreds;
     // was the prediction correct?
     bool correct = (bi.yout >= 1) == taken;
     // what is the magnitude of yout?
     int abs_yout = abs(bi.yout);
+    // if the branch was predicted incorrectly or the correct
+    // prediction was weak, update the weights
+    bool do_train = !correct || (abs_yout <= theta);
+    bool track_mpreds =
+        (threshold >= 0) && (!tuneonly || (abs_yout <= threshold));
+    if (!track_mpreds && !do_train) return;
+
+    // the histories do not change while training, so the entries of the
+    // tables only need to be located once
+    unsigned int *indices = td.indices.data();
+    const unsigned int sign_bit = bi.getHPC() % n_sign_bits;
+    computeIndices(tid, bi, indices);
+
     // keep track of mispredictions per table
-    if (threshold >= 0) if (!tuneonly || (abs_yout <= threshold)) {
+    if (track_mpreds) {
         bool halve = false;
 
         // for each table, figure out if there was a misprediction
+        int *values = td.values.data();
+        gatherWeights(td, indices, sign_bit, scaledXlat.data(), values);
         for (int i = 0; i < specs.size(); i += 1) {
-            HistorySpec const &spec = *specs[i];
-            // get the hash to index the table
-            unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-            bool sign = sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
-            int counter = tables[i][hashed_idx];
-            int weight = spec.coeff * ((spec.width == 5) ?
-                                       xlat4[counter] : xlat[counter]);
-            if (sign) weight = -weight;
-            bool pred = weight >= 1;
+            bool pred = values[i] >= 1;
             if (pred != taken) {
                 mpreds[i] += 1;
                 if (mpreds[i] == (1 << tunebits) - 1) {
@@ -439,9 +457,6 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
             }
         }
     }
-    // if the branch was predicted incorrectly or the correct
-    // prediction was weak, update the weights
-    bool do_train = !correct || (abs_yout <= theta);
     if (!do_train) return;
 
     // adaptive theta training, adapted from O-GEHL
@@ -462,27 +477,7 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
 
     // train the weights, computing what the value of yout
     // would have been if these updates had been applied before
-    int newyout = 0;
-    for (int i = 0; i < specs.size(); i += 1) {
-        HistorySpec const &spec = *specs[i];
-        // get the magnitude
-        unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-        int counter = tables[i][hashed_idx];
-        // get the sign
-        bool sign = sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
-        // increment/decrement if taken/not taken
-        satIncDec(taken, sign, counter, (1 << (spec.width - 1)) - 1);
-        // update the magnitude and sign
-        tables[i][hashed_idx] = counter;
-        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits] = sign;
-        int weight = ((spec.width == 5) ? xlat4[counter] : xlat[counter]);
-        // update the new version of yout
-        if (sign) {
-            newyout -= weight;
-        } else {
-            newyout += weight;
-        }
-    }
+    int newyout = updateWeights(td, indices, sign_bit, taken);
 
     // if the prediction still would have been incorrect even
     // with the updated weights, update some more weights to
@@ -499,13 +494,9 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                 found = false;
                 for (int j = 0; j < specs.size(); j += 1) {
                     int i = (nrand + j) % specs.size();
-                    HistorySpec const &spec = *specs[i];
-                    unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-                    int counter = tables[i][hashed_idx];
-                    bool sign =
-                        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
-                    int weight = ((spec.width == 5) ?
-                            xlat4[counter] : xlat[counter]);
+                    int counter = td.weights[indices[i]];
+                    bool sign = (td.signs[indices[i]] >> sign_bit) & 1;
+                    int weight = rawXlat[i * xlatEntries + counter];
                     int signed_weight = sign ? -weight : weight;
                     pout = newyout - signed_weight;
                     if ((pout >= 1) == taken) {
@@ -517,17 +508,13 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                 }
                 if (besti != -1) {
                     int i = besti;
-                    HistorySpec const &spec = *specs[i];
-                    unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-                    int counter = tables[i][hashed_idx];
-                    bool sign =
-                        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+                    int counter = td.weights[indices[i]];
+                    bool sign = (td.signs[indices[i]] >> sign_bit) & 1;
                     if (counter > 1) {
                         counter--;
-                        tables[i][hashed_idx] = counter;
+                        td.weights[indices[i]] = counter;
                     }
-                    int weight = ((spec.width == 5) ?
-                            xlat4[counter] : xlat[counter]);
+                    int weight = rawXlat[i * xlatEntries + counter];
                     int signed_weight = sign ? -weight : weight;
                     int out = pout + signed_weight;
                     round_counter += 1;
@@ -39,7 +39,6 @@
 #ifndef __CPU_PRED_MULTIPERSPECTIVE_PERCEPTRON_HH__
 #define __CPU_PRED_MULTIPERSPECTIVE_PERCEPTRON_HH__
 
-#include <array>
 #include <vector>
 
 #include "cpu/pred/bpred_unit.hh"
@@ -283,6 +282,8 @@ class MultiperspectivePerceptron : public BPredUnit
     static int xlat[];
     /** Transfer function for 5-width tables */
     static int xlat4[];
+    /** Number of entries of the per table transfer functions */
+    static const int xlatEntries = 32;
 
     /** History data is kept for each thread */
     struct ThreadData {
@@ -342,14 +343,35 @@ class MultiperspectivePerceptron : public BPredUnit
         int occupancy;
 
         std::vector<int> mpreds;
-        std::vector<std::vector<short int>> tables;
-        std::vector<std::vector<std::array<bool, 2>>> sign_bits;
+        /**
+         * Weights of all the predictor tables, packed back to back (see
+         * tableOffsets). The perceptron keeps the magnitude here and the
+         * sign in signs, MPP-TAGE keeps signed weights. Both arrays are
+         * padded so they can be gathered a word at a time.
+         */
+        std::vector<int8_t> weights;
+        /** Sign bits of the weights, bit k holds sign k of the entry */
+        std::vector<uint8_t> signs;
+        /** Per table indices and values of the branch being processed */
+        std::vector<unsigned int> indices;
+        std::vector<int> values;
     };
     std::vector<ThreadData *> threadData;
 
     /** Predictor tables */
     std::vector<HistorySpec *> specs;
     std::vector<int> table_sizes;
+    /** Offset of each table in the packed weight arrays */
+    std::vector<unsigned int> tableOffsets;
+    /**
+     * Per table transfer functions, indexed by
+     * table * xlatEntries + magnitude. scaledXlat includes the
+     * coefficient of the feature, rawXlat does not.
+     */
+    std::vector<int> scaledXlat;
+    std::vector<int> rawXlat;
+    /** Per table maximum weight magnitude */
+    std::vector<int> maxWeights;
 
     /** runtime values and data used to count the size in bits */
     bool doing_local;
@@ -436,6 +458,39 @@ class MultiperspectivePerceptron : public BPredUnit
      */
     unsigned int getIndex(ThreadID tid, const MPPBranchInfo &bi,
             const HistorySpec &spec, int index) const;
+
+    /**
+     * Computes the position of the entry of every predictor table in the
+     * packed weight arrays
+     * @param tid Thread ID of the branch
+     * @param bi branch informaiton data
+     * @param indices array to write the positions to, one per table
+     */
+    void computeIndices(ThreadID tid, const MPPBranchInfo &bi,
+            unsigned int *indices) const;
+
+    /**
+     * Gathers the signed weight of the entry of every predictor table
+     * @param td history data of the thread
+     * @param indices positions of the entries, from computeIndices
+     * @param sign_bit which of the sign bits of the entries to use
+     * @param table_xlat per table transfer functions
+     * @param values array to write the signed weights to, one per table
+     */
+    void gatherWeights(const ThreadData &td, const unsigned int *indices,
+            unsigned int sign_bit, const int *table_xlat, int *values) const;
+
+    /**
+     * Moves the entry of every predictor table towards the direction of
+     * the branch, saturating at the maximum magnitude
+     * @param td history data of the thread
+     * @param indices positions of the entries, from computeIndices
+     * @param sign_bit which of the sign bits of the entries to use
+     * @param taken whether the branch was taken
+     * @return sum of the updated (unscaled) weights
+     */
+    int updateWeights(ThreadData &td, const unsigned int *indices,
+            unsigned int sign_bit, bool taken) const;
     /**
      * Finds the best subset of features to use in case of a low-confidence
      * branch, returns the result as an ordered vector of the indices to the
@@ -462,16 +517,6 @@ class MultiperspectivePerceptron : public BPredUnit
      */
     void train(ThreadID tid, MPPBranchInfo &bi, bool taken);
 
-    /**
-     * Auxiliary function to increase a table counter depending on the
-     * direction of the branch
-     * @param taken whether the branch was taken
-     * @param sign current sign of the table
-     * @param c current value of the table
-     * @param max_weight maximum value of the counter
-     */
-    void satIncDec(bool taken, bool &sign, int &c, int max_weight) const;
-
     /** Add a table spec to the prefetcher */
     void addSpec(HistorySpec *spec)
     {
@@ -138,9 +138,7 @@ MPP_TAGE::handleUReset()
     if (tCounter >= ((ULL(1) << logUResetPeriod))) {
         // Update the u bits for the short tags table
         for (int i = 1; i <= nHistoryTables; i++) {
-            for (int j = 0; j < (ULL(1) << logTagTableSizes[i]); j++) {
-                resetUctr(gtable[i][j].u);
-            }
+            resetUctrs(gtable[i].u, ULL(1) << logTagTableSizes[i]);
         }
 
         tCounter = 0;
@@ -148,11 +146,11 @@ MPP_TAGE::handleUReset()
 }
 
 void
-MPP_TAGE::resetUctr(uint8_t &u)
+MPP_TAGE::resetUctrs(uint8_t *u, size_t count)
 {
     // On real HW it should be u >>= 1 instead of if > 0 then u--
-    if (u > 0) {
-        u--;
+    for (size_t j = 0; j < count; j++) {
+        u[j] -= (u[j] > 0);
     }
 }
 
@@ -220,11 +218,7 @@ MPP_TAGE::updatePathAndGlobalHistory(
         path >>= 1;
         updateGHist(tHist.gHist, dir, tHist.globalHistory, tHist.ptGhist);
         tHist.pathHist = (tHist.pathHist << 1) ^ pathbit;
-        for (int i = 1; i <= nHistoryTables; i++) {
-            tHist.computeIndices[i].update(tHist.gHist);
-            tHist.computeTags[0][i].update(tHist.gHist);
-            tHist.computeTags[1][i].update(tHist.gHist);
-        }
+        tHist.folded.update(tHist.gHist);
     }
 }
 
@@ -423,10 +417,11 @@ int
 MultiperspectivePerceptronTAGE::computePartialSum(ThreadID tid,
                                                   MPPTAGEBranchInfo &bi) const
 {
+    const int8_t *weights = threadData[tid]->weights.data();
     int yout = 0;
     for (int i = 0; i < specs.size(); i += 1) {
         yout += specs[i]->coeff *
-            threadData[tid]->tables[i][getIndex(tid, bi, *specs[i], i)];
+            weights[tableOffsets[i] + getIndex(tid, bi, *specs[i], i)];
     }
     return yout;
 }
@@ -436,22 +431,14 @@ MultiperspectivePerceptronTAGE::updatePartial(ThreadID tid,
                                               MPPTAGEBranchInfo &bi,
                                               bool taken)
 {
-    // update tables
+    // update tables, saturating at the weight limits
+    int8_t *weights = threadData[tid]->weights.data();
     for (int i = 0; i < specs.size(); i += 1) {
-        unsigned int idx = getIndex(tid, bi, *specs[i], i);
-        short int *c =
-            &threadData[tid]->tables[i][idx];
-        short int max_weight = (1 << (specs[i]->width - 1)) - 1;
-        short int min_weight = -(1 << (specs[i]->width - 1));
-        if (taken) {
-            if (*c < max_weight) {
-                *c += 1;
-            }
-        } else {
-            if (*c > min_weight) {
-                *c -= 1;
-            }
-        }
+        unsigned int idx = tableOffsets[i] + getIndex(tid, bi, *specs[i], i);
+        const int c = weights[idx];
+        const int max_weight = maxWeights[i];
+        const int min_weight = -max_weight - 1;
+        weights[idx] = c + (taken ? (c < max_weight) : -(c > min_weight));
     }
 }
 
@@ -611,9 +598,11 @@ MultiperspectivePerceptronTAGE::update(ThreadID tid, Addr instPC, bool taken,
         tage->updateHistories(tid, instPC, taken, bi->tageBranchInfo, false,
                 inst, corrTarget);
     } else {
-        tage->updateStats(taken, bi->tageBranchInfo);
-        loopPredictor->updateStats(taken, bi->lpBranchInfo);
-        statisticalCorrector->updateStats(taken, bi->scBranchInfo);
+        if (!warming) {
+            tage->updateStats(taken, bi->tageBranchInfo);
+            loopPredictor->updateStats(taken, bi->lpBranchInfo);
+            statisticalCorrector->updateStats(taken, bi->scBranchInfo);
+        }
 
         loopPredictor->condBranchUpdate(tid, instPC, taken,
                 bi->tageBranchInfo->tagePred, bi->lpBranchInfo, instShiftAmt);
@@ -68,7 +68,7 @@ class MPP_TAGE : public TAGEBase {
     void handleAllocAndUReset(bool alloc, bool taken, TAGEBase::BranchInfo* bi,
                               int nrand) override;
     void handleUReset() override;
-    void resetUctr(uint8_t &u) override;
+    void resetUctrs(uint8_t *u, size_t count) override;
     int bindex(Addr pc_in) const override;
     bool isHighConfidence(TAGEBase::BranchInfo *bi) const override;
 
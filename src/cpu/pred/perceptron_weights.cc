@@ -0,0 +1,105 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/perceptron_weights.hh"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+void
+gatherPerceptronWeights(const int8_t *weights, const uint8_t *signs,
+        const unsigned int *indices, int num_tables, unsigned int sign_bit,
+        const int *table_xlat, int xlat_entries, int *values)
+{
+    int i = 0;
+
+#if defined(__AVX2__)
+    // Eight tables at a time: gather the magnitudes and the sign bytes
+    // (as words, hence the padding of the arrays), then the transfer
+    // function entries, and apply the signs
+    const __m256i low_byte = _mm256_set1_epi32(0xff);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i entries = _mm256_set1_epi32(xlat_entries);
+    const __m128i sign_shift = _mm_cvtsi32_si128(sign_bit);
+    __m256i table = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    for (; i + 8 <= num_tables; i += 8) {
+        const __m256i idx =
+            _mm256_loadu_si256((const __m256i *)&indices[i]);
+        const __m256i magnitude = _mm256_and_si256(
+            _mm256_i32gather_epi32((const int *)weights, idx, 1), low_byte);
+        const __m256i sign = _mm256_and_si256(_mm256_srl_epi32(
+            _mm256_i32gather_epi32((const int *)signs, idx, 1), sign_shift),
+            one);
+        const __m256i xlat_idx = _mm256_add_epi32(
+            _mm256_mullo_epi32(table, entries), magnitude);
+        const __m256i weight =
+            _mm256_i32gather_epi32(table_xlat, xlat_idx, 4);
+        // (weight ^ -sign) + sign negates the weight if sign is set
+        const __m256i neg_sign = _mm256_sub_epi32(_mm256_setzero_si256(),
+                                                  sign);
+        _mm256_storeu_si256((__m256i *)&values[i], _mm256_add_epi32(
+            _mm256_xor_si256(weight, neg_sign), sign));
+        table = _mm256_add_epi32(table, _mm256_set1_epi32(8));
+    }
+#endif
+
+    for (; i < num_tables; i += 1) {
+        const unsigned int idx = indices[i];
+        const int sign = (signs[idx] >> sign_bit) & 1;
+        const int weight = table_xlat[i * xlat_entries + weights[idx]];
+        values[i] = (weight ^ -sign) + sign;
+    }
+}
+
+int
+updatePerceptronWeights(int8_t *weights, uint8_t *signs,
+        const unsigned int *indices, int num_tables, unsigned int sign_bit,
+        bool taken, const int *max_weights, const int *table_xlat,
+        int xlat_entries)
+{
+    int newyout = 0;
+    for (int i = 0; i < num_tables; i += 1) {
+        const unsigned int idx = indices[i];
+        int counter = weights[idx];
+        int sign = (signs[idx] >> sign_bit) & 1;
+        // Saturating sign/magnitude increment (taken) or decrement. The
+        // magnitude goes toward 0 when the sign disagrees with the
+        // direction, and the sign flips once it gets there; otherwise
+        // it grows up to the maximum weight.
+        const int toward_zero = (sign == taken);
+        const int at_zero = (counter == 0);
+        counter += (!toward_zero & (counter < max_weights[i])) -
+                   (toward_zero & !at_zero);
+        sign ^= toward_zero & at_zero;
+        // update the magnitude and sign
+        weights[idx] = counter;
+        signs[idx] = (signs[idx] & ~(1 << sign_bit)) | (sign << sign_bit);
+        // update the new version of yout
+        const int weight = table_xlat[i * xlat_entries + counter];
+        newyout += (weight ^ -sign) + sign;
+    }
+    return newyout;
+}
@@ -0,0 +1,75 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Kernels over the packed weights of the multiperspective perceptron.
+ *
+ * The weights of all the predictor tables are stored back to back. Each
+ * entry has a magnitude in one array, and a byte of sign bits in another
+ * one. Both arrays must be padded with sizeof(int) - 1 bytes, as they may
+ * be read a word at a time.
+ */
+
+#ifndef __CPU_PRED_PERCEPTRON_WEIGHTS_HH__
+#define __CPU_PRED_PERCEPTRON_WEIGHTS_HH__
+
+#include <cstdint>
+
+/**
+ * Gathers the signed weight of one entry of every predictor table
+ * @param weights magnitudes of the packed entries
+ * @param signs sign bits of the packed entries
+ * @param indices positions of the entries, one per table
+ * @param num_tables number of predictor tables
+ * @param sign_bit which of the sign bits of the entries to use
+ * @param table_xlat per table transfer functions, indexed by
+ * table * xlat_entries + magnitude
+ * @param xlat_entries number of entries of each transfer function
+ * @param values array to write the signed weights to, one per table
+ */
+void gatherPerceptronWeights(const int8_t *weights, const uint8_t *signs,
+        const unsigned int *indices, int num_tables, unsigned int sign_bit,
+        const int *table_xlat, int xlat_entries, int *values);
+
+/**
+ * Moves one entry of every predictor table towards the direction of the
+ * branch, saturating at the maximum magnitude of the table
+ * @param weights magnitudes of the packed entries
+ * @param signs sign bits of the packed entries
+ * @param indices positions of the entries, one per table
+ * @param num_tables number of predictor tables
+ * @param sign_bit which of the sign bits of the entries to use
+ * @param taken whether the branch was taken
+ * @param max_weights per table maximum magnitude
+ * @param table_xlat per table transfer functions, as above
+ * @param xlat_entries number of entries of each transfer function
+ * @return sum of the updated signed weights
+ */
+int updatePerceptronWeights(int8_t *weights, uint8_t *signs,
+        const unsigned int *indices, int num_tables, unsigned int sign_bit,
+        bool taken, const int *max_weights, const int *table_xlat,
+        int xlat_entries);
+
+#endif // __CPU_PRED_PERCEPTRON_WEIGHTS_HH__
@@ -0,0 +1,193 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "cpu/pred/perceptron_weights.hh"
+
+namespace {
+
+const int xlatEntries = 32;
+
+/**
+ * Predictor tables laid out as the multiperspective perceptron originally
+ * kept them, one vector of magnitudes and one of sign pairs per table,
+ * updated by the original sign/magnitude saturating counter. It is the
+ * reference the packed kernels (eight tables at a time with AVX2) are
+ * checked against.
+ */
+struct ReferenceTables
+{
+    std::vector<std::vector<short>> tables;
+    std::vector<std::vector<std::array<bool, 2>>> signBits;
+
+    static void
+    satIncDec(bool taken, bool &sign, int &counter, int max_weight)
+    {
+        if (taken) {
+            if (sign) {
+                if (counter == 0) {
+                    sign = false;
+                } else {
+                    counter -= 1;
+                }
+            } else if (counter < max_weight) {
+                counter += 1;
+            }
+        } else {
+            if (sign) {
+                if (counter < max_weight) {
+                    counter += 1;
+                }
+            } else if (counter == 0) {
+                sign = true;
+            } else {
+                counter -= 1;
+            }
+        }
+    }
+};
+
+/**
+ * Trains num_tables random tables on random branches with both
+ * implementations, checking the gathered weights and the updated outputs
+ * on every branch, and the whole table state at the end.
+ */
+void
+checkPerceptronWeights(int num_tables, int n_sign_bits, std::mt19937 &rng)
+{
+    // Random transfer functions, one per table width, and coefficients
+    std::array<std::vector<int>, 2> xlat;
+    for (auto &fn : xlat) {
+        int value = 0;
+        for (int m = 0; m < xlatEntries; m++) {
+            value += 1 + rng() % 5;
+            fn.push_back(value);
+        }
+    }
+
+    ReferenceTables ref;
+    std::vector<int> widths, coeffs, max_weights, offsets;
+    std::vector<int> scaled_xlat, raw_xlat;
+    int num_weights = 0;
+    for (int i = 0; i < num_tables; i++) {
+        const int size = 1 + rng() % 1024;
+        widths.push_back(5 + rng() % 2);
+        coeffs.push_back(1 + rng() % 4);
+        max_weights.push_back((1 << (widths[i] - 1)) - 1);
+        offsets.push_back(num_weights);
+        num_weights += size;
+        ref.tables.emplace_back(size, 0);
+        ref.signBits.emplace_back(size, std::array<bool, 2>{false, false});
+        for (int m = 0; m < xlatEntries; m++) {
+            const int weight = xlat[widths[i] - 5][m];
+            raw_xlat.push_back(weight);
+            scaled_xlat.push_back(coeffs[i] * weight);
+        }
+    }
+
+    // The packed arrays, with the padding the kernels expect
+    std::vector<int8_t> weights(num_weights + sizeof(int) - 1, 0);
+    std::vector<uint8_t> signs(num_weights + sizeof(int) - 1, 0);
+
+    std::vector<unsigned int> indices(num_tables);
+    std::vector<int> values(num_tables);
+    for (int branch = 0; branch < 20000; branch++) {
+        const unsigned int sign_bit = rng() % n_sign_bits;
+        const bool taken = rng() % 2;
+        // Few entries per table, so that they saturate
+        for (int i = 0; i < num_tables; i++) {
+            indices[i] = offsets[i] + rng() % std::min<int>(
+                ref.tables[i].size(), 8);
+        }
+
+        gatherPerceptronWeights(weights.data(), signs.data(),
+                                indices.data(), num_tables, sign_bit,
+                                scaled_xlat.data(), xlatEntries,
+                                values.data());
+        for (int i = 0; i < num_tables; i++) {
+            const int idx = indices[i] - offsets[i];
+            const int counter = ref.tables[i][idx];
+            const bool sign = ref.signBits[i][idx][sign_bit];
+            const int weight = coeffs[i] * xlat[widths[i] - 5][counter];
+            ASSERT_EQ(sign ? -weight : weight, values[i]);
+        }
+
+        const int newyout = updatePerceptronWeights(weights.data(),
+                signs.data(), indices.data(), num_tables, sign_bit, taken,
+                max_weights.data(), raw_xlat.data(), xlatEntries);
+        int ref_newyout = 0;
+        for (int i = 0; i < num_tables; i++) {
+            const int idx = indices[i] - offsets[i];
+            int counter = ref.tables[i][idx];
+            bool sign = ref.signBits[i][idx][sign_bit];
+            ReferenceTables::satIncDec(taken, sign, counter,
+                                       max_weights[i]);
+            ref.tables[i][idx] = counter;
+            ref.signBits[i][idx][sign_bit] = sign;
+            const int weight = xlat[widths[i] - 5][counter];
+            ref_newyout += sign ? -weight : weight;
+        }
+        ASSERT_EQ(ref_newyout, newyout);
+    }
+
+    for (int i = 0; i < num_tables; i++) {
+        for (size_t idx = 0; idx < ref.tables[i].size(); idx++) {
+            const int k = offsets[i] + idx;
+            EXPECT_EQ(ref.tables[i][idx], weights[k]);
+            for (int bit = 0; bit < n_sign_bits; bit++) {
+                EXPECT_EQ(ref.signBits[i][idx][bit], (signs[k] >> bit) & 1);
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+/** Table counts around those of the 8KB and 64KB configurations */
+TEST(PerceptronWeightsTest, PredictorConfigurations)
+{
+    std::mt19937 rng(0x3e2f);
+    for (int num_tables : { 16, 37, 45, 57 }) {
+        for (int n_sign_bits = 1; n_sign_bits <= 2; n_sign_bits++) {
+            checkPerceptronWeights(num_tables, n_sign_bits, rng);
+        }
+    }
+}
+
+/** Any number of tables, including fewer than a vector holds */
+TEST(PerceptronWeightsTest, RandomConfigurations)
+{
+    std::mt19937 rng(0x9e1c);
+    for (int num_tables = 1; num_tables <= 20; num_tables++) {
+        checkPerceptronWeights(num_tables, 1 + rng() % 2, rng);
+    }
+}
@@ -350,18 +350,15 @@ StatisticalCorrector::condBranchUpdate(ThreadID tid, Addr branch_pc,
         unsigned indBiasSK = getIndBiasSK(branch_pc, bi);
         unsigned indBiasBank = getIndBiasBank(branch_pc, bi, hitBank, altBank);
 
-        int xsum = bi->lsum -
-                      ((wb[indUpds] >= 0) * ((2 * bias[indBias] + 1) +
-                          (2 * biasSK[indBiasSK] + 1) +
-                          (2 * biasBank[indBiasBank] + 1)));
-
-        if ((xsum + ((2 * bias[indBias] + 1) + (2 * biasSK[indBiasSK] + 1) +
-            (2 * biasBank[indBiasBank] + 1)) >= 0) != (xsum >= 0))
-        {
-            ctrUpdate(wb[indUpds],
-                      (((2 * bias[indBias] + 1) +
-                        (2 * biasSK[indBiasSK] + 1) +
-                        (2 * biasBank[indBiasBank] + 1) >= 0) == taken),
+        // Contribution of the bias tables to lsum, before weighting
+        const int bias_sum = (2 * bias[indBias] + 1) +
+                             (2 * biasSK[indBiasSK] + 1) +
+                             (2 * biasBank[indBiasBank] + 1);
+
+        int xsum = bi->lsum - ((wb[indUpds] >= 0) * bias_sum);
+
+        if ((xsum + bias_sum >= 0) != (xsum >= 0)) {
+            ctrUpdate(wb[indUpds], ((bias_sum >= 0) == taken),
                       extraWeightsWidth);
         }
 
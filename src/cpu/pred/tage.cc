@@ -69,7 +69,8 @@ TAGE::update(ThreadID tid, Addr branch_pc, bool taken, void* bp_history,
     if (bi->tageBranchInfo->condBranch) {
         DPRINTF(Tage, "Updating tables for branch:%lx; taken?:%d\n",
                 branch_pc, taken);
-        tage->updateStats(taken, bi->tageBranchInfo);
+        if (!warming)
+            tage->updateStats(taken, bi->tageBranchInfo);
         tage->condBranchUpdate(tid, branch_pc, taken, tage_bi, nrand,
                                corrTarget, bi->tageBranchInfo->tagePred);
     }
@@ -37,6 +37,9 @@
 
 #include "cpu/pred/tage_base.hh"
 
+#include <cstring>
+
+#include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base/logging.hh"
 #include "debug/Fetch.hh"
@@ -61,6 +64,7 @@ TAGEBase::TAGEBase(const TAGEBaseParams &p)
      useAltOnNaBits(p.useAltOnNaBits),
      maxNumAlloc(p.maxNumAlloc),
      noSkip(p.noSkip),
+     noSkipMask(0),
      speculativeHistUpdate(p.speculativeHistUpdate),
      instShiftAmt(p.instShiftAmt),
      initialized(false),
@@ -99,13 +103,26 @@ TAGEBase::init()
 
     assert(histBufferSize > maxHist * 2);
 
+    // The tag matching keeps one hit bit per table
+    fatal_if(nHistoryTables >= 64,
+             "TAGE supports at most 63 tagged tables, %d requested.",
+             nHistoryTables);
+    for (int i = 1; i <= nHistoryTables; i++) {
+        if (noSkip[i]) {
+            noSkipMask |= ULL(1) << i;
+        }
+    }
+
     useAltPredForNewlyAllocated.resize(numUseAltOnNa, 0);
 
     for (auto& history : threadHistory) {
         history.pathHist = 0;
-        history.globalHistory = new uint8_t[histBufferSize];
+        // The folded history update reads the history a word at a time,
+        // so leave room for a partial word past the end of the buffer
+        const size_t size = histBufferSize + sizeof(int) - 1;
+        history.globalHistory = new uint8_t[size];
         history.gHist = history.globalHistory;
-        memset(history.gHist, 0, histBufferSize);
+        memset(history.gHist, 0, size);
         history.ptGhist = 0;
     }
 
@@ -121,9 +138,7 @@ TAGEBase::init()
     assert(tagTableTagWidths[0] == 0);
 
     for (auto& history : threadHistory) {
-        history.computeIndices = new FoldedHistory[nHistoryTables+1];
-        history.computeTags[0] = new FoldedHistory[nHistoryTables+1];
-        history.computeTags[1] = new FoldedHistory[nHistoryTables+1];
+        history.folded.resize(nHistoryTables + 1);
 
         initFoldedHistories(history);
     }
@@ -133,7 +148,7 @@ TAGEBase::init()
     btableHysteresis.resize(bimodalTableSize >> logRatioBiModalHystEntries,
                             true);
 
-    gtable = new TageEntry*[nHistoryTables + 1];
+    gtable.resize(nHistoryTables + 1);
     buildTageTables();
 
     tableIndices = new int [nHistoryTables+1];
@@ -145,22 +160,40 @@ void
 TAGEBase::initFoldedHistories(ThreadHistory & history)
 {
     for (int i = 1; i <= nHistoryTables; i++) {
-        history.computeIndices[i].init(
+        history.folded.init(FoldedHistories::IndexFold, i,
             histLengths[i], (logTagTableSizes[i]));
-        history.computeTags[0][i].init(
-            history.computeIndices[i].origLength, tagTableTagWidths[i]);
-        history.computeTags[1][i].init(
-            history.computeIndices[i].origLength, tagTableTagWidths[i]-1);
+        history.folded.init(FoldedHistories::TagFold0, i,
+            histLengths[i], tagTableTagWidths[i]);
+        history.folded.init(FoldedHistories::TagFold1, i,
+            histLengths[i], tagTableTagWidths[i]-1);
         DPRINTF(Tage, "HistLength:%d, TTSize:%d, TTTWidth:%d\n",
                 histLengths[i], logTagTableSizes[i], tagTableTagWidths[i]);
     }
 }
 
+TAGEBase::TageTable
+TAGEBase::allocTageTable(size_t num_entries)
+{
+    // One zeroed allocation per table: tags first as they are the
+    // widest field, then the counters and the u bits
+    const size_t bytes = num_entries *
+        (sizeof(uint16_t) + sizeof(int8_t) + sizeof(uint8_t));
+    gtableStorage.emplace_back(new uint8_t[bytes]());
+    uint8_t *base = gtableStorage.back().get();
+
+    TageTable table;
+    table.tag = reinterpret_cast<uint16_t *>(base);
+    table.ctr = reinterpret_cast<int8_t *>(
+        base + num_entries * sizeof(uint16_t));
+    table.u = base + num_entries * (sizeof(uint16_t) + sizeof(int8_t));
+    return table;
+}
+
 void
 TAGEBase::buildTageTables()
 {
     for (int i = 1; i <= nHistoryTables; i++) {
-        gtable[i] = new TageEntry[1<<(logTagTableSizes[i])];
+        gtable[i] = allocTageTable(1<<(logTagTableSizes[i]));
     }
 }
 
@@ -186,14 +219,8 @@ TAGEBase::btbUpdate(ThreadID tid, Addr branch_pc, BranchInfo* &bi)
         DPRINTF(Tage, "BTB miss resets prediction: %lx\n", branch_pc);
         assert(tHist.gHist == &tHist.globalHistory[tHist.ptGhist]);
         tHist.gHist[0] = 0;
-        for (int i = 1; i <= nHistoryTables; i++) {
-            tHist.computeIndices[i].comp = bi->ci[i];
-            tHist.computeTags[0][i].comp = bi->ct0[i];
-            tHist.computeTags[1][i].comp = bi->ct1[i];
-            tHist.computeIndices[i].update(tHist.gHist);
-            tHist.computeTags[0][i].update(tHist.gHist);
-            tHist.computeTags[1][i].update(tHist.gHist);
-        }
+        tHist.folded.restore(bi->ci);
+        tHist.folded.update(tHist.gHist);
     }
 }
 
@@ -230,7 +257,7 @@ TAGEBase::gindex(ThreadID tid, Addr pc, int bank) const
     index =
         shiftedPc ^
         (shiftedPc >> ((int) abs(logTagTableSizes[bank] - bank) + 1)) ^
-        threadHistory[tid].computeIndices[bank].comp ^
+        threadHistory[tid].folded.indexFold(bank) ^
         F(threadHistory[tid].pathHist, hlen, bank);
 
     return (index & ((ULL(1) << (logTagTableSizes[bank])) - 1));
@@ -242,8 +269,8 @@ uint16_t
 TAGEBase::gtag(ThreadID tid, Addr pc, int bank) const
 {
     int tag = (pc >> instShiftAmt) ^
-              threadHistory[tid].computeTags[0][bank].comp ^
-              (threadHistory[tid].computeTags[1][bank].comp << 1);
+              threadHistory[tid].folded.tagFold(0, bank) ^
+              (threadHistory[tid].folded.tagFold(1, bank) << 1);
 
     return (tag & ((ULL(1) << tagTableTagWidths[bank]) - 1));
 }
@@ -366,22 +393,22 @@ TAGEBase::tagePredict(ThreadID tid, Addr branch_pc,
 
         bi->hitBank = 0;
         bi->altBank = 0;
-        //Look for the bank with longest matching history
-        for (int i = nHistoryTables; i > 0; i--) {
-            if (noSkip[i] &&
-                gtable[i][tableIndices[i]].tag == tableTags[i]) {
-                bi->hitBank = i;
-                bi->hitBankIndex = tableIndices[bi->hitBank];
-                break;
-            }
+        // Compare the tags of all the tables without branching, then
+        // pick the bank with longest matching history and the alternate
+        // bank from the resulting hit mask
+        uint64_t hits = 0;
+        for (int i = 1; i <= nHistoryTables; i++) {
+            hits |= uint64_t(gtable[i].tag[tableIndices[i]] ==
+                             tableTags[i]) << i;
         }
-        //Look for the alternate bank
-        for (int i = bi->hitBank - 1; i > 0; i--) {
-            if (noSkip[i] &&
-                gtable[i][tableIndices[i]].tag == tableTags[i]) {
-                bi->altBank = i;
+        hits &= noSkipMask;
+        if (hits) {
+            bi->hitBank = findMsbSet(hits);
+            bi->hitBankIndex = tableIndices[bi->hitBank];
+            hits &= ~(ULL(1) << bi->hitBank);
+            if (hits) {
+                bi->altBank = findMsbSet(hits);
                 bi->altBankIndex = tableIndices[bi->altBank];
-                break;
             }
         }
         //computes the prediction and the alternate prediction
@@ -491,17 +518,17 @@ TAGEBase::handleUReset()
         // reset least significant bit
         // most significant bit becomes least significant bit
         for (int i = 1; i <= nHistoryTables; i++) {
-            for (int j = 0; j < (ULL(1) << logTagTableSizes[i]); j++) {
-                resetUctr(gtable[i][j].u);
-            }
+            resetUctrs(gtable[i].u, ULL(1) << logTagTableSizes[i]);
         }
     }
 }
 
 void
-TAGEBase::resetUctr(uint8_t & u)
+TAGEBase::resetUctrs(uint8_t *u, size_t count)
 {
-    u >>= 1;
+    for (size_t j = 0; j < count; j++) {
+        u[j] >>= 1;
+    }
 }
 
 void
@@ -601,17 +628,10 @@ TAGEBase::updateHistories(ThreadID tid, Addr branch_pc, bool taken,
     }
 
     //prepare next index and tag computations for user branchs
-    for (int i = 1; i <= nHistoryTables; i++)
-    {
-        if (speculative) {
-            bi->ci[i]  = tHist.computeIndices[i].comp;
-            bi->ct0[i] = tHist.computeTags[0][i].comp;
-            bi->ct1[i] = tHist.computeTags[1][i].comp;
-        }
-        tHist.computeIndices[i].update(tHist.gHist);
-        tHist.computeTags[0][i].update(tHist.gHist);
-        tHist.computeTags[1][i].update(tHist.gHist);
+    if (speculative) {
+        tHist.folded.save(bi->ci);
     }
+    tHist.folded.update(tHist.gHist);
     DPRINTF(Tage, "Updating global histories with branch:%lx; taken?:%d, "
             "path Hist: %x; pointer:%d\n", branch_pc, taken, tHist.pathHist,
             tHist.ptGhist);
@@ -635,14 +655,8 @@ TAGEBase::squash(ThreadID tid, bool taken, TAGEBase::BranchInfo *bi,
     tHist.ptGhist = bi->ptGhist;
     tHist.gHist = &(tHist.globalHistory[tHist.ptGhist]);
     tHist.gHist[0] = (taken ? 1 : 0);
-    for (int i = 1; i <= nHistoryTables; i++) {
-        tHist.computeIndices[i].comp = bi->ci[i];
-        tHist.computeTags[0][i].comp = bi->ct0[i];
-        tHist.computeTags[1][i].comp = bi->ct1[i];
-        tHist.computeIndices[i].update(tHist.gHist);
-        tHist.computeTags[0][i].update(tHist.gHist);
-        tHist.computeTags[1][i].update(tHist.gHist);
-    }
+    tHist.folded.restore(bi->ci);
+    tHist.folded.update(tHist.gHist);
 }
 
 void
@@ -48,9 +48,11 @@
 #ifndef __CPU_PRED_TAGE_BASE
 #define __CPU_PRED_TAGE_BASE
 
+#include <memory>
 #include <vector>
 
 #include "base/statistics.hh"
+#include "cpu/pred/folded_histories.hh"
 #include "cpu/static_inst.hh"
 #include "params/TAGEBase.hh"
 #include "sim/sim_object.hh"
@@ -64,44 +66,31 @@ class TAGEBase : public SimObject
   protected:
     // Prediction Structures
 
-    // Tage Entry
-    struct TageEntry
+    // Tagged table storage. The entries of a table are kept as a
+    // structure of arrays: ctr, tag and u each live in their own
+    // contiguous array, so that the tag compare touches only tags and
+    // the periodic u reset is a straight loop over a byte array.
+    // Indexing a table yields a TageEntryRef, which keeps the familiar
+    // gtable[bank][index].field syntax.
+    struct TageEntryRef
     {
-        int8_t ctr;
-        uint16_t tag;
-        uint8_t u;
-        TageEntry() : ctr(0), tag(0), u(0) { }
+        int8_t &ctr;
+        uint16_t &tag;
+        uint8_t &u;
     };
 
-    // Folded History Table - compressed history
-    // to mix with instruction PC to index partially
-    // tagged tables.
-    struct FoldedHistory
+    struct TageTable
     {
-        unsigned comp;
-        int compLength;
-        int origLength;
-        int outpoint;
-        int bufferSize;
+        int8_t *ctr;
+        uint16_t *tag;
+        uint8_t *u;
 
-        FoldedHistory()
-        {
-            comp = 0;
-        }
-
-        void init(int original_length, int compressed_length)
-        {
-            origLength = original_length;
-            compLength = compressed_length;
-            outpoint = original_length % compressed_length;
-        }
+        TageTable() : ctr(nullptr), tag(nullptr), u(nullptr) { }
 
-        void update(uint8_t * h)
+        TageEntryRef
+        operator[](size_t idx) const
         {
-            comp = (comp << 1) | h[0];
-            comp ^= h[origLength] << outpoint;
-            comp ^= (comp >> compLength);
-            comp &= (ULL(1) << compLength) - 1;
+            return {ctr[idx], tag[idx], u[idx]};
         }
     };
 
@@ -140,7 +129,8 @@ class TAGEBase : public SimObject
         int *storage;
 
         // Pointers to actual saved array within the dynamically
-        // allocated storage.
+        // allocated storage. ci, ct0 and ct1 must stay contiguous, they
+        // are saved and restored in one go by FoldedHistories.
         int *tableIndices;
         int *tableTags;
         int *ci;
@@ -389,9 +379,17 @@ class TAGEBase : public SimObject
         Addr branch_pc, bool taken, BranchInfo* bi);
 
     /**
-     * Algorithm for resetting a single U counter
+     * Algorithm for resetting the U counters of a table
+     * @param u The U counter array of the table
+     * @param count Number of entries in the array
      */
-    virtual void resetUctr(uint8_t & u);
+    virtual void resetUctrs(uint8_t *u, size_t count);
+
+    /**
+     * Allocates zero initialized storage for a tagged table
+     * @param num_entries Number of entries of the table
+     */
+    TageTable allocTageTable(size_t num_entries);
 
     /**
      * Extra steps for calculating altTaken
@@ -427,7 +425,8 @@ class TAGEBase : public SimObject
 
     std::vector<bool> btablePrediction;
     std::vector<bool> btableHysteresis;
-    TageEntry **gtable;
+    std::vector<TageTable> gtable;
+    std::vector<std::unique_ptr<uint8_t[]>> gtableStorage;
 
     // Keep per-thread histories to
     // support SMT.
@@ -448,8 +447,7 @@ class TAGEBase : public SimObject
         int ptGhist;
 
         // Speculative folded histories.
-        FoldedHistory *computeIndices;
-        FoldedHistory *computeTags[2];
+        FoldedHistories folded;
     };
 
     std::vector<ThreadHistory> threadHistory;
@@ -476,6 +474,9 @@ class TAGEBase : public SimObject
     // Some other classes use this for handling associativity
     std::vector<bool> noSkip;
 
+    // noSkip as a bit mask, used by the branchless tag matching
+    uint64_t noSkipMask;
+
     const bool speculativeHistUpdate;
 
     const unsigned instShiftAmt;
@@ -107,9 +107,9 @@ TAGE_SC_L_TAGE::buildTageTables()
     // Trick! We only allocate entries for tables 1 and firstLongTagTable and
     // make the other tables point to these allocated entries
 
-    gtable[1] = new TageEntry[shortTagsTageFactor * (1 << logTagTableSize)];
+    gtable[1] = allocTageTable(shortTagsTageFactor * (1 << logTagTableSize));
     gtable[firstLongTagTable] =
-        new TageEntry[longTagsTageFactor * (1 << logTagTableSize)];
+        allocTageTable(longTagsTageFactor * (1 << logTagTableSize));
     for (int i = 2; i < firstLongTagTable; ++i) {
         gtable[i] = gtable[1];
     }
@@ -181,7 +181,7 @@ TAGE_SC_L_TAGE::gindex(ThreadID tid, Addr pc, int bank) const
     // pc is not shifted by instShiftAmt in this implementation
     index = shortPc ^
             (shortPc >> ((int) abs(logTagTableSizes[bank] - bank) + 1)) ^
-            threadHistory[tid].computeIndices[bank].comp ^
+            threadHistory[tid].folded.indexFold(bank) ^
             F(threadHistory[tid].pathHist, hlen, bank);
 
     index = gindex_ext(index, bank);
@@ -247,11 +247,7 @@ TAGE_SC_L_TAGE::updatePathAndGlobalHistory(
             // The 8KB implementation does not do this truncation
             tHist.pathHist = (tHist.pathHist & ((ULL(1) << pathHistBits) - 1));
         }
-        for (int i = 1; i <= nHistoryTables; i++) {
-            tHist.computeIndices[i].update(tHist.gHist);
-            tHist.computeTags[0][i].update(tHist.gHist);
-            tHist.computeTags[1][i].update(tHist.gHist);
-        }
+        tHist.folded.update(tHist.gHist);
     }
 }
 
@@ -317,14 +313,11 @@ TAGE_SC_L_TAGE::handleUReset()
 
     if (tCounter >= ((ULL(1) << logUResetPeriod))) {
         // Update the u bits for the short tags table
-        for (int j = 0; j < (shortTagsTageFactor*(1<<logTagTableSize)); j++) {
-            resetUctr(gtable[1][j].u);
-        }
+        resetUctrs(gtable[1].u, shortTagsTageFactor * (1 << logTagTableSize));
 
         // Update the u bits for the long tags table
-        for (int j = 0; j < (longTagsTageFactor*(1<<logTagTableSize)); j++) {
-            resetUctr(gtable[firstLongTagTable][j].u);
-        }
+        resetUctrs(gtable[firstLongTagTable].u,
+                   longTagsTageFactor * (1 << logTagTableSize));
 
         tCounter = 0;
     }
@@ -429,11 +422,11 @@ TAGE_SC_L::update(ThreadID tid, Addr branch_pc, bool taken, void *bp_history,
     if (tage_bi->condBranch) {
         DPRINTF(TageSCL, "Updating tables for branch:%lx; taken?:%d\n",
                 branch_pc, taken);
-        tage->updateStats(taken, bi->tageBranchInfo);
-
-        loopPredictor->updateStats(taken, bi->lpBranchInfo);
-
-        statisticalCorrector->updateStats(taken, bi->scBranchInfo);
+        if (!warming) {
+            tage->updateStats(taken, bi->tageBranchInfo);
+            loopPredictor->updateStats(taken, bi->lpBranchInfo);
+            statisticalCorrector->updateStats(taken, bi->scBranchInfo);
+        }
 
         bool bias = (bi->tageBranchInfo->longestMatchPred !=
                      bi->tageBranchInfo->altTaken);
@@ -64,7 +64,7 @@ class TAGE_SC_L_TAGE_8KB : public TAGE_SC_L_TAGE
     void handleTAGEUpdate(
         Addr branch_pc, bool taken, TAGEBase::BranchInfo* bi) override;
 
-    void resetUctr(uint8_t & u) override;
+    void resetUctrs(uint8_t *u, size_t count) override;
 };
 
 class TAGE_SC_L_8KB_StatisticalCorrector : public StatisticalCorrector
@@ -59,8 +59,12 @@ class AtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    warm_icache = Param.BaseCache(NULL, "Cache on the icache port whose "
+        "hits bypass the port (functional warming)")
+    warm_dcache = Param.BaseCache(NULL, "Cache on the dcache port whose "
+        "hits bypass the port (functional warming)")
 
-    def addSimPointProbe(self, interval):
-        simpoint = SimPoint()
+    def addSimPointProbe(self, interval, **kwargs):
+        simpoint = SimPoint(**kwargs)
         simpoint.interval = interval
         self.probeListener = simpoint
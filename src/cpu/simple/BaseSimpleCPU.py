@@ -48,4 +48,10 @@ class BaseSimpleCPU(BaseCPU):
             print("ERROR: Checker only supported under ARM ISA!")
             exit(1)
 
+    def addBranchTraceProbe(self, trace_file):
+        from m5.objects.BranchTrace import BranchTrace
+        self.branchTrace = BranchTrace(trace_file=trace_file)
+
     branchPred = Param.BranchPredictor(NULL, "Branch Predictor")
+    warm_branch_pred = Param.BranchPredictor(NULL, "Branch predictor "
+        "trained on committed control instructions (functional warming)")
@@ -50,6 +50,7 @@
 #include "debug/Drain.hh"
 #include "debug/ExecFaulting.hh"
 #include "debug/SimpleCPU.hh"
+#include "mem/cache/base.hh"
 #include "mem/packet.hh"
 #include "mem/packet_access.hh"
 #include "mem/physical.hh"
@@ -68,6 +69,11 @@ AtomicSimpleCPU::init()
     data_read_req->setContext(cid);
     data_write_req->setContext(cid);
     data_amo_req->setContext(cid);
+
+    if (!switchedOut()) {
+        checkWarmCache(icachePort, warmICache);
+        checkWarmCache(dcachePort, warmDCache);
+    }
 }
 
 AtomicSimpleCPU::AtomicSimpleCPU(const AtomicSimpleCPUParams &p)
@@ -77,16 +83,17 @@ AtomicSimpleCPU::AtomicSimpleCPU(const AtomicSimpleCPUParams &p)
       width(p.width), locked(false),
       simulate_data_stalls(p.simulate_data_stalls),
       simulate_inst_stalls(p.simulate_inst_stalls),
+      warmICache(p.warm_icache), warmDCache(p.warm_dcache),
       icachePort(name() + ".icache_port", this),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
       ppCommit(nullptr)
 {
     _status = Idle;
-    ifetch_req = std::make_shared<Request>();
-    data_read_req = std::make_shared<Request>();
-    data_write_req = std::make_shared<Request>();
-    data_amo_req = std::make_shared<Request>();
+    ifetch_req = Request::create();
+    data_read_req = Request::create();
+    data_write_req = Request::create();
+    data_amo_req = Request::create();
 }
 
 
@@ -205,6 +212,18 @@ AtomicSimpleCPU::takeOverFrom(BaseCPU *old_cpu)
 
     // The tick event should have been descheduled by drain()
     assert(!tickEvent.scheduled());
+
+    checkWarmCache(icachePort, warmICache);
+    checkWarmCache(dcachePort, warmDCache);
+}
+
+void
+AtomicSimpleCPU::checkWarmCache(RequestPort &port, BaseCache *cache)
+{
+    fatal_if(cache && (!port.isConnected() ||
+                       &port.getPeer() != &cache->getPort("cpu_side")),
+             "%s: functional warming cache %s is not connected to %s.",
+             name(), cache->name(), port.name());
 }
 
 void
@@ -267,10 +286,53 @@ AtomicSimpleCPU::suspendContext(ThreadID thread_num)
     BaseCPU::suspendContext(thread_num);
 }
 
+void
+AtomicSimpleCPU::beginLockedRMW(const PacketPtr &pkt)
+{
+    if (inParallelMode && pkt->req->isLockedRMW() && pkt->isRead()) {
+        assert(!lockedRMWMigration);
+        lockedRMWMigration.reset(
+            new EventQueue::ScopedMigration(system->eventQueue()));
+    }
+}
+
+void
+AtomicSimpleCPU::endLockedRMW(const PacketPtr &pkt)
+{
+    if (pkt->req->isLockedRMW() && pkt->isWrite())
+        lockedRMWMigration.reset();
+}
+
 Tick
 AtomicSimpleCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
 {
-    return port.sendAtomic(pkt);
+    BaseCache *warm_cache = nullptr;
+    if (&port == &icachePort)
+        warm_cache = warmICache;
+    else if (&port == &dcachePort)
+        warm_cache = warmDCache;
+
+    // Hits in the cache the CPU accesses directly don't need the rest of
+    // the memory system, so cores simulated by separate host threads
+    // serve them in parallel. The cache serializes them with the snoops
+    // of the other cores.
+    Tick latency;
+    if (warm_cache && warm_cache->warmAccess(pkt, latency))
+        return latency;
+
+    beginLockedRMW(pkt);
+
+    {
+        // Everything else goes through the crossbars, snoop filters and
+        // memories, which are shared by all the cores without any locking.
+        // They are only accessed from the event queue servicing them.
+        EventQueue::ScopedMigration migrate(system->eventQueue(),
+                                            inParallelMode);
+        latency = port.sendAtomic(pkt);
+    }
+
+    endLockedRMW(pkt);
+    return latency;
 }
 
 Tick
@@ -392,6 +454,12 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t *data, unsigned size,
         // Now do the access.
         if (predicate && fault == NoFault &&
             !req->getFlags().isSet(Request::NO_ACCESS)) {
+            // Snoops of the other cores clear reservations from the queue
+            // of the memory system, keep it until this one is recorded
+            EventQueue::ScopedMigration migrate(system->eventQueue(),
+                                                inParallelMode &&
+                                                req->isLLSC());
+
             Packet pkt(req, Packet::makeReadCmd(req));
             pkt.dataStatic(data);
 
@@ -476,6 +544,12 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
 
         // Now do the access.
         if (predicate && fault == NoFault) {
+            // Check the reservation and write from the queue of the memory
+            // system, so that no other core takes the line in between
+            EventQueue::ScopedMigration migrate(system->eventQueue(),
+                                                inParallelMode &&
+                                                req->isLLSC());
+
             bool do_access = true;  // flag to suppress cache access
 
             if (req->isLLSC()) {
@@ -679,7 +753,7 @@ AtomicSimpleCPU::tick()
 
             Tick stall_ticks = 0;
             if (curStaticInst) {
-                fault = curStaticInst->execute(&t_info, traceData);
+                fault = t_info.execute(curStaticInst, traceData);
 
                 // keep an instruction count
                 if (fault == NoFault) {
@@ -754,7 +828,7 @@ AtomicSimpleCPU::fetchInstMem()
 void
 AtomicSimpleCPU::regProbePoints()
 {
-    BaseCPU::regProbePoints();
+    BaseSimpleCPU::regProbePoints();
 
     ppCommit = new ProbePointArg<std::pair<SimpleThread*, const StaticInstPtr>>
                                 (getProbeManager(), "Commit");
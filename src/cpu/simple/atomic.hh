@@ -41,12 +41,16 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <memory>
+
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
 #include "mem/request.hh"
 #include "params/AtomicSimpleCPU.hh"
 #include "sim/probe/probe.hh"
 
+class BaseCache;
+
 class AtomicSimpleCPU : public BaseSimpleCPU
 {
   public:
@@ -61,9 +65,34 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
     const int width;
     bool locked;
+
+    /**
+     * Migration to the event queue servicing the memory system held from
+     * the read to the write of a locked RMW when cores are simulated by
+     * separate host threads, so that no other core accesses memory in
+     * between.
+     */
+    std::unique_ptr<EventQueue::ScopedMigration> lockedRMWMigration;
+
+    void beginLockedRMW(const PacketPtr &pkt);
+    void endLockedRMW(const PacketPtr &pkt);
     const bool simulate_data_stalls;
     const bool simulate_inst_stalls;
 
+    /**
+     * Caches directly connected to the instruction and data ports whose
+     * hits are served through BaseCache::warmAccess (functional warming)
+     * rather than by sending the packet through the port.
+     */
+    BaseCache *warmICache;
+    BaseCache *warmDCache;
+
+    /**
+     * Check that a functional warming cache is the one connected to the
+     * given port, as its hit path bypasses the port.
+     */
+    void checkWarmCache(RequestPort &port, BaseCache *cache);
+
     // main simulation loop (one cycle)
     void tick();
 
@@ -81,6 +81,8 @@ BaseSimpleCPU::BaseSimpleCPU(const BaseSimpleCPUParams &p)
     : BaseCPU(p),
       curThread(0),
       branchPred(p.branchPred),
+      warmBranchPred(p.warm_branch_pred),
+      ppBranch(nullptr),
       traceData(NULL),
       inst(),
       _status(Idle)
@@ -126,6 +128,15 @@ BaseSimpleCPU::init()
     }
 }
 
+void
+BaseSimpleCPU::regProbePoints()
+{
+    BaseCPU::regProbePoints();
+
+    ppBranch = new ProbePointArg<CommittedBranch>(getProbeManager(),
+                                                  "Branch");
+}
+
 void
 BaseSimpleCPU::checkPcEventQueue()
 {
@@ -371,6 +382,14 @@ BaseSimpleCPU::preExecute()
 #endif // TRACING_ON
     }
 
+    // Execution overwrites the next PC of control instructions, keep the
+    // original PC state so that the fall through can be reported and the
+    // warmed predictor can be trained.
+    if (curStaticInst && curStaticInst->isControl() &&
+        (ppBranch->hasListeners() || warmBranchPred)) {
+        branchPC = thread->pcState();
+    }
+
     if (branchPred && curStaticInst &&
         curStaticInst->isControl()) {
         // Use a fake sequence number since we only have one
@@ -491,13 +510,29 @@ BaseSimpleCPU::advancePC(const Fault &fault)
         // instruction in flight at the same time.
         const InstSeqNum cur_sn(0);
 
-        if (t_info.predPC == thread->pcState()) {
-            // Correctly predicted branch
-            branchPred->update(cur_sn, curThread);
-        } else {
+        if (t_info.predPC != thread->pcState()) {
             // Mis-predicted branch
             branchPred->squash(cur_sn, thread->pcState(), branching, curThread);
             ++t_info.execContextStats.numBranchMispred;
         }
+
+        // The branch commits right away, whether or not it was
+        // mispredicted, so that the predictor is trained in program order
+        branchPred->update(cur_sn, curThread);
+    }
+
+    if (warmBranchPred && fault == NoFault && curStaticInst &&
+        curStaticInst->isControl()) {
+        warmBranchPred->warm(curStaticInst, branchPC, thread->pcState(),
+                             branching, curThread);
+    }
+
+    if (fault == NoFault && curStaticInst && curStaticInst->isControl() &&
+        ppBranch->hasListeners()) {
+        TheISA::PCState fall_through = branchPC;
+        TheISA::advancePC(fall_through, curStaticInst);
+        ppBranch->notify(CommittedBranch{curStaticInst, branchPC,
+                                         fall_through, thread->pcState(),
+                                         branching, t_info.numInst});
     }
 }
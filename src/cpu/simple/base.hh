@@ -55,6 +55,7 @@
 #include "mem/request.hh"
 #include "sim/eventq.hh"
 #include "sim/full_system.hh"
+#include "sim/probe/probe.hh"
 #include "sim/system.hh"
 
 // forward declarations
@@ -82,15 +83,49 @@ class BaseSimpleCPU : public BaseCPU
   protected:
     ThreadID curThread;
     BPredUnit *branchPred;
+    /**
+     * Predictor trained on committed control instructions without being
+     * used for prediction, e.g. that of a detailed CPU to be switched in.
+     */
+    BPredUnit *warmBranchPred;
 
     void checkPcEventQueue();
     void swapActiveThread();
 
+  public:
+    /**
+     * A committed control instruction, as passed to the Branch probe
+     * point.
+     */
+    struct CommittedBranch
+    {
+        /** The control instruction, which may be a micro-op */
+        StaticInstPtr inst;
+        /** PC state of the instruction before it was executed */
+        TheISA::PCState pc;
+        /** PC state the instruction would fall through to */
+        TheISA::PCState fallThrough;
+        /** PC state of the next instruction actually executed */
+        TheISA::PCState target;
+        /** Whether the control instruction redirected the PC */
+        bool taken;
+        /** Instructions committed by the thread, including this one */
+        Counter numInst;
+    };
+
+  protected:
+    /** PC state of the current control instruction before executing it */
+    TheISA::PCState branchPC;
+
+    /** Notifies listeners of every committed control instruction */
+    ProbePointArg<CommittedBranch> *ppBranch;
+
   public:
     BaseSimpleCPU(const BaseSimpleCPUParams &params);
     virtual ~BaseSimpleCPU();
     void wakeup(ThreadID tid) override;
     void init() override;
+    void regProbePoints() override;
   public:
     Trace::InstRecord *traceData;
     CheckerCPU *checker;
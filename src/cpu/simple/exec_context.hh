@@ -48,13 +48,14 @@
 #include "cpu/exec_context.hh"
 #include "cpu/reg_class.hh"
 #include "cpu/simple/base.hh"
+#include "cpu/static_inst.hh"
 #include "cpu/static_inst_fwd.hh"
 #include "cpu/translation.hh"
 #include "mem/request.hh"
 
 class BaseSimpleCPU;
 
-class SimpleExecContext : public ExecContext
+class SimpleExecContext final : public ExecContext
 {
   public:
     BaseSimpleCPU *cpu;
@@ -271,6 +272,19 @@ class SimpleExecContext : public ExecContext
         lastDcacheStall(0), execContextStats(cpu, thread)
     { }
 
+    /**
+     * Execute an instruction in this context. Uses the variant of its
+     * execute() specialized for this class if the ISA parser generated
+     * one, as register accesses then go to the thread directly.
+     */
+    Fault
+    execute(const StaticInstPtr &inst, Trace::InstRecord *traceData)
+    {
+        if (auto simple_execute = inst->simpleExecute())
+            return simple_execute(inst.get(), this, traceData);
+        return inst->execute(this, traceData);
+    }
+
     /** Reads an integer register. */
     RegVal
     readIntRegOperand(const StaticInst *si, int idx) override
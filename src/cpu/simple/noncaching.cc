@@ -59,8 +59,33 @@ NonCachingSimpleCPU::verifyMemoryMode() const
 Tick
 NonCachingSimpleCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
 {
+    // When cores are simulated by separate host threads, serve plain loads
+    // straight from the backdoors so that they don't need to synchronize
+    // with the other cores. Everything that updates memory or its
+    // reservations still goes through the memory system.
+    const RequestPtr &req = pkt->req;
+    if (inParallelMode && pkt->cmd == MemCmd::ReadReq && !req->isLLSC() &&
+            !req->isLockedRMW() && !req->isUncacheable()) {
+        auto bd_it = memBackdoors.contains(pkt->getAddrRange());
+        if (bd_it != memBackdoors.end()) {
+            auto *bd = bd_it->second;
+            pkt->setData(bd->ptr() + (pkt->getAddr() - bd->range().start()));
+            pkt->makeResponse();
+            return 0;
+        }
+    }
+
+    beginLockedRMW(pkt);
+
     MemBackdoorPtr bd = nullptr;
-    Tick latency = port.sendAtomicBackdoor(pkt, bd);
+    Tick latency;
+    {
+        EventQueue::ScopedMigration migrate(system->eventQueue(),
+                                            inParallelMode);
+        latency = port.sendAtomicBackdoor(pkt, bd);
+    }
+
+    endLockedRMW(pkt);
 
     // If the target gave us a backdoor for next time and we didn't
     // already have it, record it.
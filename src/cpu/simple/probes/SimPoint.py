@@ -44,3 +44,22 @@ class SimPoint(ProbeListenerObject):
 
     interval = Param.UInt64(100000000, "Interval Size (insts)")
     profile_file = Param.String("simpoint.bb.gz", "BBV (output) file")
+
+    binary_profile = Param.Bool(False, "Write the BBVs in a compact binary "
+        "sparse format instead of text (see util/decode_simpoint_bbv.py)")
+
+    # Online SimPoint selection: the BBV of every interval is randomly
+    # projected as it completes, and the projections are clustered with
+    # k-means at the end of the simulation.
+    clusters = Param.Unsigned(0, "Number of clusters for online SimPoint "
+        "selection (0 disables it)")
+    projection_dims = Param.Unsigned(15, "Dimensions of the random "
+        "projection of the BBVs")
+    kmeans_iterations = Param.Unsigned(100, "Maximum number of k-means "
+        "iterations")
+    seed = Param.UInt32(1, "Seed of the random projection and of the "
+        "k-means initialisation")
+    points_file = Param.String("simpoints", "Selected SimPoints (output) "
+        "file")
+    weights_file = Param.String("weights", "Weights of the selected "
+        "SimPoints (output) file")
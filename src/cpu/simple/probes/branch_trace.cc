@@ -0,0 +1,107 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/probes/branch_trace.hh"
+
+#include "base/output.hh"
+#include "proto/branch_trace.pb.h"
+#include "sim/core.hh"
+
+BranchTrace::BranchTrace(const BranchTraceParams &p)
+    : ProbeListenerObject(p),
+      traceStream(nullptr),
+      lastNumInst(0)
+{
+    fatal_if(p.trace_file == "", "Assign a trace file to %s.\n", name());
+
+    auto *cpu = dynamic_cast<BaseSimpleCPU *>(p.manager);
+    fatal_if(!cpu, "Manager of %s is not a simple CPU.\n", name());
+    fatal_if(cpu->numThreads > 1, "%s only supports single-threaded "
+             "CPUs.\n", name());
+
+    traceStream = new ProtoOutputStream(simout.resolve(p.trace_file));
+
+    ProtoMessage::BranchTraceHeader header;
+    header.set_obj_id(name());
+    header.set_ver(0);
+    traceStream->write(header);
+
+    registerExitCallback([this]() { close(); });
+}
+
+void
+BranchTrace::regProbeListeners()
+{
+    typedef ProbeListenerArg<BranchTrace, BaseSimpleCPU::CommittedBranch>
+        BranchListener;
+    listeners.push_back(new BranchListener(this, "Branch",
+                                           &BranchTrace::record));
+}
+
+void
+BranchTrace::record(const BaseSimpleCPU::CommittedBranch &branch)
+{
+    const StaticInstPtr &inst = branch.inst;
+
+    // Branches between the micro-ops of a macro-op do not leave the
+    // instruction and are not interesting to a branch predictor.
+    if (inst->isMicroop() && !inst->isLastMicroop())
+        return;
+
+    if (!traceStream)
+        return;
+
+    uint32_t flags = 0;
+    if (inst->isCondCtrl())
+        flags |= ProtoMessage::BranchRecord::COND;
+    if (inst->isUncondCtrl())
+        flags |= ProtoMessage::BranchRecord::UNCOND;
+    if (inst->isDirectCtrl())
+        flags |= ProtoMessage::BranchRecord::DIRECT;
+    if (inst->isIndirectCtrl())
+        flags |= ProtoMessage::BranchRecord::INDIRECT;
+    if (inst->isCall())
+        flags |= ProtoMessage::BranchRecord::CALL;
+    if (inst->isReturn())
+        flags |= ProtoMessage::BranchRecord::RETURN;
+
+    ProtoMessage::BranchRecord rec;
+    rec.set_pc(branch.pc.instAddr());
+    rec.set_target(branch.target.instAddr());
+    rec.set_size(branch.fallThrough.instAddr() - branch.pc.instAddr());
+    rec.set_flags(flags);
+    rec.set_taken(branch.taken);
+    rec.set_insts(branch.numInst - lastNumInst);
+    traceStream->write(rec);
+
+    lastNumInst = branch.numInst;
+}
+
+void
+BranchTrace::close()
+{
+    delete traceStream;
+    traceStream = nullptr;
+}
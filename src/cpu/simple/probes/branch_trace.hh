@@ -1,7 +1,4 @@
 /*
- * Copyright (c) 2012 Google
- * All rights reserved.
- *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions are
  * met: redistributions of source code must retain the above copyright
@@ -26,11 +23,41 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include "arch/mips/decoder.hh"
+#ifndef __CPU_SIMPLE_PROBES_BRANCH_TRACE_HH__
+#define __CPU_SIMPLE_PROBES_BRANCH_TRACE_HH__
+
+#include "cpu/simple/base.hh"
+#include "params/BranchTrace.hh"
+#include "proto/protoio.hh"
+#include "sim/probe/probe.hh"
 
-namespace MipsISA
+/**
+ * Probe that records the committed control instructions of a simple CPU
+ * in a protobuf branch trace. Each record holds the PC, the target, the
+ * size of the instruction, the kind of control instruction and its
+ * outcome, together with the number of instructions committed since the
+ * previous record. Such traces can be replayed against any branch
+ * predictor using BranchTraceReplay.
+ */
+class BranchTrace : public ProbeListenerObject
 {
+  public:
+    BranchTrace(const BranchTraceParams &params);
+
+    void regProbeListeners() override;
+
+    /** Write a record for a committed control instruction. */
+    void record(const BaseSimpleCPU::CommittedBranch &branch);
+
+  private:
+    /** Flush and close the trace, called at exit. */
+    void close();
+
+    /** Output stream of the trace, null once closed */
+    ProtoOutputStream *traceStream;
 
-GenericISA::BasicDecodeCache<Decoder, ExtMachInst> Decoder::defaultCache;
+    /** Instruction count of the thread at the previous record */
+    Counter lastNumInst;
+};
 
-}
+#endif // __CPU_SIMPLE_PROBES_BRANCH_TRACE_HH__
@@ -37,20 +37,54 @@
 
 #include "cpu/simple/probes/simpoint.hh"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "base/output.hh"
+#include "base/random.hh"
+#include "sim/byteswap.hh"
+#include "sim/core.hh"
 
 SimPoint::SimPoint(const SimPointParams &p)
     : ProbeListenerObject(p),
       intervalSize(p.interval),
+      binaryProfile(p.binary_profile),
+      numClusters(p.clusters),
+      projectionDims(p.projection_dims),
+      kmeansIterations(p.kmeans_iterations),
+      seed(p.seed),
+      pointsFile(p.points_file),
+      weightsFile(p.weights_file),
       intervalCount(0),
       intervalDrift(0),
       simpointStream(NULL),
       currentBBV(0, 0),
       currentBBVInstCount(0)
 {
-    simpointStream = simout.create(p.profile_file, false);
+    simpointStream = simout.create(p.profile_file, binaryProfile);
     if (!simpointStream)
         fatal("unable to open SimPoint profile_file");
+
+    if (binaryProfile) {
+        std::ostream &os = *simpointStream->stream();
+        const uint32_t magic = htole(binaryMagic);
+        const uint32_t version = htole(binaryVersion);
+        const uint64_t interval = htole(intervalSize);
+        os.write((const char *)&magic, sizeof(magic));
+        os.write((const char *)&version, sizeof(version));
+        os.write((const char *)&interval, sizeof(interval));
+    }
+
+    if (numClusters) {
+        fatal_if(projectionDims == 0,
+                 "%s: online clustering needs at least one projection "
+                 "dimension.\n", name());
+        fatal_if(kmeansIterations == 0,
+                 "%s: online clustering needs at least one k-means "
+                 "iteration.\n", name());
+        registerExitCallback([this]() { selectSimPoints(); });
+    }
 }
 
 SimPoint::~SimPoint()
@@ -113,7 +147,7 @@ SimPoint::profile(const std::pair<SimpleThread*, StaticInstPtr>& p)
         // interval (intervalDrift) is greater than/equal to the interval size.
         if (intervalCount + intervalDrift >= intervalSize) {
             // summarize interval and display BBV info
-            std::vector<std::pair<uint64_t, uint64_t> > counts;
+            IntervalBBV counts;
             for (auto map_itr = bbMap.begin(); map_itr != bbMap.end();
                     ++map_itr) {
                 BBInfo& info = map_itr->second;
@@ -125,16 +159,206 @@ SimPoint::profile(const std::pair<SimpleThread*, StaticInstPtr>& p)
             std::sort(counts.begin(), counts.end());
 
             // Print output BBV info
-            *simpointStream->stream() << "T";
-            for (auto cnt_itr = counts.begin(); cnt_itr != counts.end();
-                    ++cnt_itr) {
-                *simpointStream->stream() << ":" << cnt_itr->first
-                                << ":" << cnt_itr->second << " ";
-            }
-            *simpointStream->stream() << "\n";
+            if (binaryProfile)
+                writeBinaryInterval(counts);
+            else
+                writeTextInterval(counts);
+
+            if (numClusters)
+                projectInterval(counts);
 
             intervalDrift = (intervalCount + intervalDrift) - intervalSize;
             intervalCount = 0;
         }
     }
 }
+
+void
+SimPoint::writeTextInterval(const IntervalBBV &counts)
+{
+    *simpointStream->stream() << "T";
+    for (auto cnt_itr = counts.begin(); cnt_itr != counts.end();
+            ++cnt_itr) {
+        *simpointStream->stream() << ":" << cnt_itr->first
+                        << ":" << cnt_itr->second << " ";
+    }
+    *simpointStream->stream() << "\n";
+}
+
+void
+SimPoint::writeVarint(uint64_t val)
+{
+    std::ostream &os = *simpointStream->stream();
+    while (val >= 0x80) {
+        os.put((char)((val & 0x7f) | 0x80));
+        val >>= 7;
+    }
+    os.put((char)val);
+}
+
+void
+SimPoint::writeBinaryInterval(const IntervalBBV &counts)
+{
+    // The IDs are sorted, so delta encoding keeps most of them to a
+    // single byte
+    writeVarint(counts.size());
+    uint64_t last_id = 0;
+    for (const auto &cnt : counts) {
+        writeVarint(cnt.first - last_id);
+        writeVarint(cnt.second);
+        last_id = cnt.first;
+    }
+}
+
+double
+SimPoint::projection(uint64_t bb_id, unsigned dim) const
+{
+    // splitmix64 of (seed, basic block, dimension), scaled to [-1, 1)
+    uint64_t x = ((uint64_t)seed << 32) ^ (bb_id * projectionDims + dim);
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return (x >> 11) * (2.0 / (1ULL << 53)) - 1.0;
+}
+
+void
+SimPoint::projectInterval(const IntervalBBV &counts)
+{
+    uint64_t total = 0;
+    for (const auto &cnt : counts)
+        total += cnt.second;
+
+    // Normalise the BBV so that intervals of slightly different length
+    // (because of the drift) compare equal, then project it
+    const size_t base = projectedBBVs.size();
+    projectedBBVs.resize(base + projectionDims, 0.0);
+    if (!total)
+        return;
+    for (const auto &cnt : counts) {
+        const double freq = (double)cnt.second / total;
+        for (unsigned d = 0; d < projectionDims; ++d)
+            projectedBBVs[base + d] += freq * projection(cnt.first, d);
+    }
+}
+
+void
+SimPoint::selectSimPoints()
+{
+    const size_t dims = projectionDims;
+    const size_t num_intervals = projectedBBVs.size() / dims;
+    const size_t k = std::min<size_t>(numClusters, num_intervals);
+    const double *points = projectedBBVs.data();
+
+    auto distance = [dims](const double *a, const double *b) {
+        double dist = 0;
+        for (size_t d = 0; d < dims; ++d)
+            dist += (a[d] - b[d]) * (a[d] - b[d]);
+        return dist;
+    };
+
+    // k-means++ seeding: the first centroid is a random interval, the
+    // next ones are drawn with probability proportional to the squared
+    // distance to the closest centroid chosen so far
+    Random rng(seed);
+    std::vector<double> centroids;
+    std::vector<double> min_dist(num_intervals,
+                                 std::numeric_limits<double>::max());
+    if (k) {
+        size_t first = rng.random<size_t>(0, num_intervals - 1);
+        centroids.insert(centroids.end(), points + first * dims,
+                         points + (first + 1) * dims);
+    }
+    while (centroids.size() < k * dims) {
+        const double *last = &centroids[centroids.size() - dims];
+        double total = 0;
+        for (size_t i = 0; i < num_intervals; ++i) {
+            min_dist[i] = std::min(min_dist[i],
+                                   distance(points + i * dims, last));
+            total += min_dist[i];
+        }
+        size_t next = num_intervals - 1;
+        double target = rng.random<double>() * total;
+        for (size_t i = 0; i < num_intervals; ++i) {
+            if (target < min_dist[i]) {
+                next = i;
+                break;
+            }
+            target -= min_dist[i];
+        }
+        centroids.insert(centroids.end(), points + next * dims,
+                         points + (next + 1) * dims);
+    }
+
+    // Lloyd iterations until the assignment is stable
+    std::vector<size_t> cluster(num_intervals, k);
+    std::vector<size_t> sizes(k);
+    for (unsigned iter = 0; iter < kmeansIterations; ++iter) {
+        bool changed = false;
+        for (size_t i = 0; i < num_intervals; ++i) {
+            size_t best = 0;
+            double best_dist = std::numeric_limits<double>::max();
+            for (size_t c = 0; c < k; ++c) {
+                const double dist =
+                    distance(points + i * dims, &centroids[c * dims]);
+                if (dist < best_dist) {
+                    best_dist = dist;
+                    best = c;
+                }
+            }
+            changed |= cluster[i] != best;
+            cluster[i] = best;
+        }
+        if (!changed)
+            break;
+
+        // Empty clusters keep their previous centroid
+        std::vector<double> sums(k * dims, 0.0);
+        std::fill(sizes.begin(), sizes.end(), 0);
+        for (size_t i = 0; i < num_intervals; ++i) {
+            ++sizes[cluster[i]];
+            for (size_t d = 0; d < dims; ++d)
+                sums[cluster[i] * dims + d] += points[i * dims + d];
+        }
+        for (size_t c = 0; c < k; ++c) {
+            if (!sizes[c])
+                continue;
+            for (size_t d = 0; d < dims; ++d)
+                centroids[c * dims + d] = sums[c * dims + d] / sizes[c];
+        }
+    }
+
+    // Each cluster is represented by the interval closest to its
+    // centroid, weighted by the fraction of intervals in the cluster
+    std::fill(sizes.begin(), sizes.end(), 0);
+    std::vector<size_t> rep(k, num_intervals);
+    std::vector<double> rep_dist(k, std::numeric_limits<double>::max());
+    for (size_t i = 0; i < num_intervals; ++i) {
+        const size_t c = cluster[i];
+        ++sizes[c];
+        const double dist = distance(points + i * dims, &centroids[c * dims]);
+        if (dist < rep_dist[c]) {
+            rep_dist[c] = dist;
+            rep[c] = i;
+        }
+    }
+
+    OutputStream *points_os = simout.create(pointsFile);
+    OutputStream *weights_os = simout.create(weightsFile);
+    fatal_if(!points_os || !weights_os,
+             "%s: unable to open the simpoints/weights files.\n", name());
+    unsigned id = 0;
+    for (size_t c = 0; c < k; ++c) {
+        if (!sizes[c])
+            continue;
+        *points_os->stream() << rep[c] << " " << id << "\n";
+        *weights_os->stream() << (double)sizes[c] / num_intervals << " "
+                              << id << "\n";
+        ++id;
+    }
+    simout.close(points_os);
+    simout.close(weights_os);
+
+    inform("%s: selected %d simulation points out of %d intervals.\n",
+           name(), id, num_intervals);
+}
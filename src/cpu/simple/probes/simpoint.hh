@@ -38,7 +38,10 @@
 #ifndef __CPU_SIMPLE_PROBES_SIMPOINT_HH__
 #define __CPU_SIMPLE_PROBES_SIMPOINT_HH__
 
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "base/output.hh"
 #include "cpu/simple_thread.hh"
@@ -86,10 +89,59 @@ class SimPoint : public ProbeListenerObject
      */
     void profile(const std::pair<SimpleThread*, StaticInstPtr>&);
 
+    /** Magic number of binary BBV files, "gBBV" */
+    static const uint32_t binaryMagic = 0x56424267;
+    /** Version of the binary BBV format */
+    static const uint32_t binaryVersion = 1;
+
   private:
+    /** Sparse BBV of an interval: (basic block ID, inst count) pairs */
+    typedef std::vector<std::pair<uint64_t, uint64_t>> IntervalBBV;
+
+    /** Write the BBV of an interval in the SimPoint text format */
+    void writeTextInterval(const IntervalBBV &counts);
+
+    /**
+     * Write the BBV of an interval in the binary format: the number of
+     * basic blocks, then a (basic block ID delta, count) pair per block,
+     * all as LEB128 varints.
+     */
+    void writeBinaryInterval(const IntervalBBV &counts);
+    void writeVarint(uint64_t val);
+
+    /**
+     * Element of the random projection matrix for a basic block, in
+     * [-1, 1). It is derived from the seed, so it is not stored.
+     */
+    double projection(uint64_t bb_id, unsigned dim) const;
+
+    /** Project the normalised BBV of an interval and keep the result */
+    void projectInterval(const IntervalBBV &counts);
+
+    /**
+     * Cluster the projected intervals with k-means and write the
+     * interval closest to each centroid, and the weight of its cluster,
+     * to the simpoints and weights files.
+     */
+    void selectSimPoints();
+
     /** SimPoint profiling interval size in instructions */
     const uint64_t intervalSize;
 
+    /** Write the BBVs in the binary format instead of text */
+    const bool binaryProfile;
+
+    /** Online clustering parameters, numClusters == 0 disables it */
+    const unsigned numClusters;
+    const unsigned projectionDims;
+    const unsigned kmeansIterations;
+    const uint32_t seed;
+    const std::string pointsFile;
+    const std::string weightsFile;
+
+    /** Projected BBVs of the completed intervals, projectionDims each */
+    std::vector<double> projectedBBVs;
+
     /** Inst count in current basic block */
     uint64_t intervalCount;
     /** Excess inst count from previous interval*/
@@ -137,6 +137,11 @@ SimpleThread::activate()
     if (status() == ThreadContext::Active)
         return;
 
+    // Threads may be woken up by syscalls emulated for other cores which
+    // run on separate host threads, so act from the queue of our CPU.
+    EventQueue::ScopedMigration migrate(baseCpu->eventQueue(),
+                                        inParallelMode);
+
     lastActivate = curTick();
     _status = ThreadContext::Active;
     baseCpu->activateContext(_threadId);
@@ -148,6 +153,9 @@ SimpleThread::suspend()
     if (status() == ThreadContext::Suspended)
         return;
 
+    EventQueue::ScopedMigration migrate(baseCpu->eventQueue(),
+                                        inParallelMode);
+
     lastActivate = curTick();
     lastSuspend = curTick();
     _status = ThreadContext::Suspended;
@@ -161,6 +169,9 @@ SimpleThread::halt()
     if (status() == ThreadContext::Halted)
         return;
 
+    EventQueue::ScopedMigration migrate(baseCpu->eventQueue(),
+                                        inParallelMode);
+
     _status = ThreadContext::Halted;
     baseCpu->haltContext(_threadId);
 }
@@ -168,7 +179,23 @@ SimpleThread::halt()
 void
 SimpleThread::copyArchRegs(ThreadContext *src_tc)
 {
-    TheISA::copyRegs(src_tc, this);
+    auto *src = dynamic_cast<SimpleThread *>(src_tc);
+    if (!src) {
+        TheISA::copyRegs(src_tc, this);
+        return;
+    }
+
+    // Both threads keep their register files flat, so copy them as a
+    // whole rather than register by register through the ThreadContext
+    // interface. Only the misc registers need the ISA, as writing some
+    // of them has side effects.
+    intRegs = src->intRegs;
+    floatRegs = src->floatRegs;
+    vecRegs = src->vecRegs;
+    vecPredRegs = src->vecPredRegs;
+    ccRegs = src->ccRegs;
+    TheISA::copyMiscRegs(src, this);
+    pcState(src->pcState());
 }
 
 // hardware transactional memory
@@ -29,6 +29,8 @@
 #include "cpu/static_inst.hh"
 
 #include <iostream>
+#include <typeindex>
+#include <unordered_map>
 
 #include "sim/core.hh"
 
@@ -75,6 +77,44 @@ StaticInst::~StaticInst()
         delete cachedDisassembly;
 }
 
+namespace {
+
+// Constructed on first use, as registration happens during static
+// initialization of the ISA's exec code.
+std::unordered_map<std::type_index, StaticInst::SimpleExecuteFunc> &
+simpleExecuteFuncs()
+{
+    static std::unordered_map<std::type_index, StaticInst::SimpleExecuteFunc>
+        funcs;
+    return funcs;
+}
+
+}
+
+bool
+StaticInst::registerSimpleExecute(const std::type_info &type,
+                                  SimpleExecuteFunc func)
+{
+    simpleExecuteFuncs()[std::type_index(type)] = func;
+    return true;
+}
+
+StaticInst::SimpleExecuteFunc
+StaticInst::findSimpleExecute(const std::type_info &type)
+{
+    auto &funcs = simpleExecuteFuncs();
+    auto it = funcs.find(std::type_index(type));
+    return it == funcs.end() ? nullptr : it->second;
+}
+
+bool
+StaticInst::setSimpleExecute(const std::type_info &type)
+{
+    _simpleExecute = findSimpleExecute(type);
+    simpleExecuteType = &type;
+    return true;
+}
+
 bool
 StaticInst::hasBranchTarget(const TheISA::PCState &pc, ThreadContext *tc,
                             TheISA::PCState &tgt) const
@@ -45,6 +45,7 @@
 #include <bitset>
 #include <memory>
 #include <string>
+#include <typeinfo>
 
 #include "arch/registers.hh"
 #include "arch/types.hh"
@@ -63,6 +64,7 @@
 class Packet;
 
 class ExecContext;
+class SimpleExecContext;
 
 namespace Loader
 {
@@ -81,12 +83,24 @@ class InstRecord;
  * associated methods for reading them.  Any object that can rely
  * solely on these flags can process instructions without being
  * recompiled for multiple ISAs.
+ *
+ * The reference count is atomic, since some instructions, e.g. the nop,
+ * are shared by all cores, which may be simulated by separate host
+ * threads.
  */
-class StaticInst : public RefCounted, public StaticInstFlags
+class StaticInst : public AtomicRefCounted, public StaticInstFlags
 {
   public:
     using RegIdArrayPtr = RegId (StaticInst:: *)[];
 
+    /**
+     * A variant of execute() specialized for the exec context of the
+     * simple CPUs, in which register accesses need no virtual calls.
+     */
+    using SimpleExecuteFunc = Fault (*)(const StaticInst *si,
+                                        SimpleExecContext *xc,
+                                        Trace::InstRecord *traceData);
+
   private:
     /// See srcRegIdx().
     RegIdArrayPtr _srcRegIdxPtr = nullptr;
@@ -94,7 +108,24 @@ class StaticInst : public RefCounted, public StaticInstFlags
     /// See destRegIdx().
     RegIdArrayPtr _destRegIdxPtr = nullptr;
 
+    /// See simpleExecute(). Set while the instruction is constructed.
+    SimpleExecuteFunc _simpleExecute = nullptr;
+    /// The class _simpleExecute was registered for.
+    const std::type_info *simpleExecuteType = nullptr;
+
+    static SimpleExecuteFunc findSimpleExecute(const std::type_info &type);
+
   protected:
+    /**
+     * Set the specialized execute() variant of the class under
+     * construction, or clear it if the class has none. The ISA parser
+     * generates calls to this in member initializers of the classes it
+     * generates variants for, so that the variant of the most derived
+     * of them is set once the instruction is constructed.
+     *
+     * @return true, so that the call can initialize a member.
+     */
+    bool setSimpleExecute(const std::type_info &type);
 
     /// Flag values for this instruction.
     std::bitset<Num_Flags> flags;
@@ -315,6 +346,30 @@ class StaticInst : public RefCounted, public StaticInstFlags
     virtual Fault execute(ExecContext *xc,
                           Trace::InstRecord *traceData) const = 0;
 
+    /**
+     * Register the specialized execute() variant of the instructions of
+     * a class. The ISA parser generates and registers these when gem5
+     * is built with SPECIALIZE_SIMPLE_EXEC.
+     *
+     * @return true, so that registration can initialize a static member.
+     */
+    static bool registerSimpleExecute(const std::type_info &type,
+                                      SimpleExecuteFunc func);
+
+    /**
+     * The specialized execute() variant of this instruction, or nullptr
+     * if its class has none and execute() has to be used instead.
+     */
+    SimpleExecuteFunc
+    simpleExecute() const
+    {
+        // A class deriving from the one the variant was set for may
+        // override execute() without having a variant of its own
+        if (_simpleExecute && typeid(*this) == *simpleExecuteType)
+            return _simpleExecute;
+        return nullptr;
+    }
+
     virtual Fault initiateAcc(ExecContext *xc,
                               Trace::InstRecord *traceData) const
     {
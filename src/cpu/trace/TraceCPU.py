@@ -83,3 +83,11 @@ class TraceCPU(BaseCPU):
     progressMsgInterval = Param.Unsigned(0, "Interval of committed "\
                                          "instructions at which to print a"\
                                          " progress msg")
+
+    # Decode the elastic data dependency trace in a separate host thread
+    # that runs ahead of the simulation. The decoded records are handed
+    # over through a bounded queue of readQueueSize entries.
+    readThread = Param.Bool(False, "Decode the data dependency trace in "\
+                            "a separate host thread")
+    readQueueSize = Param.Unsigned(4096, "Number of decoded trace records "\
+                                   "buffered by the reader thread")
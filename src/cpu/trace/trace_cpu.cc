@@ -37,6 +37,14 @@
 
 #include "cpu/trace/trace_cpu.hh"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+
+#include "sim/byteswap.hh"
 #include "sim/sim_exit.hh"
 
 // Declare and initialize the static counter for number of trace CPUs.
@@ -301,13 +309,11 @@ TraceCPU::ElasticDataGen::readNextWindow()
     uint32_t num_read = 0;
     while (num_read != windowSize) {
 
-        // Create a new graph node
-        GraphNode* new_node = new GraphNode;
-
-        // Read the next line to get the next record. If that fails then end of
-        // trace has been reached and traceComplete needs to be set in addition
-        // to returning false.
-        if (!trace.read(new_node)) {
+        // Read the next record as a new graph node. If that fails then end
+        // of trace has been reached and traceComplete needs to be set in
+        // addition to returning false.
+        GraphNode* new_node = trace.read();
+        if (!new_node) {
             DPRINTF(TraceCPUData, "\tTrace complete!\n");
             traceComplete = true;
             return false;
@@ -589,7 +595,7 @@ TraceCPU::ElasticDataGen::executeMemReq(GraphNode* node_ptr)
     }
 
     // Create a request and the packet containing request
-    auto req = std::make_shared<Request>(
+    auto req = Request::create(
         node_ptr->physAddr, node_ptr->size, node_ptr->flags, requestorId);
     req->setReqInstSeqNum(node_ptr->seqNum);
 
@@ -1078,7 +1084,7 @@ TraceCPU::FixedRetryGen::send(Addr addr, unsigned size, const MemCmd& cmd,
 {
 
     // Create new request
-    auto req = std::make_shared<Request>(addr, size, flags, requestorId);
+    auto req = Request::create(addr, size, flags, requestorId);
     req->setPC(pc);
 
     // If this is not done it triggers assert in L1 cache for invalid contextId
@@ -1183,101 +1189,308 @@ TraceCPU::DcachePort::recvReqRetry()
 }
 
 TraceCPU::ElasticDataGen::InputStream::InputStream(
-        const std::string& filename, const double time_multiplier) :
-    trace(filename),
+        const std::string& filename, const double time_multiplier,
+        unsigned read_queue_size) :
+    fileName(filename),
+    binData(nullptr),
+    binSize(0),
+    binOffset(0),
     timeMultiplier(time_multiplier),
-    microOpCount(0)
+    microOpCount(0),
+    decodedOpCount(0),
+    stopReading(false),
+    readDone(false)
 {
-    // Create a protobuf message for the header and read it from the stream
-    ProtoMessage::InstDepRecordHeader header_msg;
-    if (!trace.read(header_msg)) {
-        panic("Failed to read packet header from %s\n", filename);
-
-        if (header_msg.tick_freq() != SimClock::Frequency) {
-            panic("Trace %s was recorded with a different tick frequency %d\n",
-                  header_msg.tick_freq());
-        }
+    int fd = open(filename.c_str(), O_RDONLY);
+    panic_if(fd < 0, "Could not open %s for reading\n", filename);
+
+    uint32_t magic = 0;
+    bool is_binary = ::read(fd, &magic, sizeof(magic)) == sizeof(magic) &&
+        letoh(magic) == binaryMagic;
+
+    if (is_binary) {
+        off_t off = lseek(fd, 0, SEEK_END);
+        fatal_if(off < 0, "Failed to determine size of file %s.\n", filename);
+        binSize = static_cast<size_t>(off);
+        panic_if(binSize < sizeof(BinaryHeader),
+                 "Truncated header in binary trace %s\n", filename);
+
+        void *data = mmap(NULL, binSize, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        panic_if(data == MAP_FAILED, "Failed to mmap file %s.\n", filename);
+        // The trace is consumed front to back exactly once per replay.
+        madvise(data, binSize, MADV_SEQUENTIAL);
+        binData = static_cast<const uint8_t *>(data);
+
+        BinaryHeader header;
+        std::memcpy(&header, binData, sizeof(header));
+        panic_if(letoh(header.version) != binaryVersion,
+                 "Binary trace %s has unsupported version %d\n",
+                 filename, letoh(header.version));
+        panic_if(letoh(header.tickFreq) != SimClock::Frequency,
+                 "Trace %s was recorded with a different tick frequency %d\n",
+                 filename, letoh(header.tickFreq));
+        windowSize = letoh(header.windowSize);
+        binOffset = sizeof(BinaryHeader);
     } else {
-        // Assign window size equal to the field in the trace that was recorded
-        // when the data dependency trace was captured in the o3cpu model
-        windowSize = header_msg.window_size();
+        close(fd);
+        protoTrace.reset(new ProtoInputStream(filename));
+
+        // Create a protobuf message for the header and read it from the
+        // stream
+        ProtoMessage::InstDepRecordHeader header_msg;
+        if (!protoTrace->read(header_msg)) {
+            panic("Failed to read packet header from %s\n", filename);
+
+            if (header_msg.tick_freq() != SimClock::Frequency) {
+                panic("Trace %s was recorded with a different tick "
+                      "frequency %d\n", header_msg.tick_freq());
+            }
+        } else {
+            // Assign window size equal to the field in the trace that was
+            // recorded when the data dependency trace was captured in the
+            // o3cpu model
+            windowSize = header_msg.window_size();
+        }
     }
+
+    if (read_queue_size)
+        readQueue.reset(new SPSCQueue<GraphNode *>(read_queue_size));
+}
+
+TraceCPU::ElasticDataGen::InputStream::~InputStream()
+{
+    stopReader();
+    if (binData)
+        munmap(const_cast<uint8_t *>(binData), binSize);
 }
 
 void
 TraceCPU::ElasticDataGen::InputStream::reset()
 {
-    trace.reset();
+    // Nodes the reader thread decoded ahead are discarded, so the count
+    // of decoded ops falls back to what was actually consumed.
+    stopReader();
+    readDone = false;
+    decodedOpCount = microOpCount;
+
+    if (protoTrace) {
+        protoTrace->reset();
+    } else {
+        binOffset = sizeof(BinaryHeader);
+    }
+}
+
+TraceCPU::ElasticDataGen::GraphNode *
+TraceCPU::ElasticDataGen::InputStream::read()
+{
+    GraphNode *element = nullptr;
+
+    if (!readQueue) {
+        element = decode();
+    } else if (!readDone) {
+        // The reader thread is started lazily so that a stream which is
+        // reset on exit does not decode the whole trace once more.
+        if (!readThread.joinable())
+            startReader();
+
+        while (!readQueue->pop(element))
+            std::this_thread::yield();
+
+        // The reader thread terminates after queueing the end marker
+        readDone = !element;
+    }
+
+    if (element)
+        microOpCount = element->robNum;
+    return element;
+}
+
+TraceCPU::ElasticDataGen::GraphNode *
+TraceCPU::ElasticDataGen::InputStream::decode()
+{
+    GraphNode *element = new GraphNode;
+    uint32_t weight = 0;
+
+    bool valid = protoTrace ? decodeProto(element, weight) :
+        decodeBinary(element, weight);
+    if (!valid) {
+        // We have reached the end of the file
+        delete element;
+        return nullptr;
+    }
+
+    // ROB occupancy number
+    decodedOpCount += 1 + weight;
+    element->robNum = decodedOpCount;
+    return element;
 }
 
 bool
-TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
+TraceCPU::ElasticDataGen::InputStream::decodeProto(GraphNode* element,
+                                                   uint32_t &weight)
 {
     ProtoMessage::InstDepRecord pkt_msg;
-    if (trace.read(pkt_msg)) {
-        // Required fields
-        element->seqNum = pkt_msg.seq_num();
-        element->type = pkt_msg.type();
-        // Scale the compute delay to effectively scale the Trace CPU frequency
-        element->compDelay = pkt_msg.comp_delay() * timeMultiplier;
-
-        // Repeated field robDepList
-        element->robDep.clear();
-        for (int i = 0; i < (pkt_msg.rob_dep()).size(); i++) {
-            element->robDep.push_back(pkt_msg.rob_dep(i));
+    if (!protoTrace->read(pkt_msg))
+        return false;
+
+    // Required fields
+    element->seqNum = pkt_msg.seq_num();
+    element->type = pkt_msg.type();
+    // Scale the compute delay to effectively scale the Trace CPU frequency
+    element->compDelay = pkt_msg.comp_delay() * timeMultiplier;
+
+    // Repeated field robDepList
+    element->robDep.clear();
+    for (int i = 0; i < (pkt_msg.rob_dep()).size(); i++) {
+        element->robDep.push_back(pkt_msg.rob_dep(i));
+    }
+
+    // Repeated field
+    element->regDep.clear();
+    for (int i = 0; i < (pkt_msg.reg_dep()).size(); i++) {
+        // There is a possibility that an instruction has both, a register
+        // and order dependency on an instruction. In such a case, the
+        // register dependency is omitted
+        bool duplicate = false;
+        for (auto &dep: element->robDep) {
+            duplicate |= (pkt_msg.reg_dep(i) == dep);
         }
+        if (!duplicate)
+            element->regDep.push_back(pkt_msg.reg_dep(i));
+    }
 
-        // Repeated field
-        element->regDep.clear();
-        for (int i = 0; i < (pkt_msg.reg_dep()).size(); i++) {
-            // There is a possibility that an instruction has both, a register
-            // and order dependency on an instruction. In such a case, the
-            // register dependency is omitted
-            bool duplicate = false;
-            for (auto &dep: element->robDep) {
-                duplicate |= (pkt_msg.reg_dep(i) == dep);
-            }
-            if (!duplicate)
-                element->regDep.push_back(pkt_msg.reg_dep(i));
+    // Optional fields
+    if (pkt_msg.has_p_addr())
+        element->physAddr = pkt_msg.p_addr();
+    else
+        element->physAddr = 0;
+
+    if (pkt_msg.has_v_addr())
+        element->virtAddr = pkt_msg.v_addr();
+    else
+        element->virtAddr = 0;
+
+    if (pkt_msg.has_size())
+        element->size = pkt_msg.size();
+    else
+        element->size = 0;
+
+    if (pkt_msg.has_flags())
+        element->flags = pkt_msg.flags();
+    else
+        element->flags = 0;
+
+    if (pkt_msg.has_pc())
+        element->pc = pkt_msg.pc();
+    else
+        element->pc = 0;
+
+    weight = pkt_msg.has_weight() ? pkt_msg.weight() : 0;
+    return true;
+}
+
+bool
+TraceCPU::ElasticDataGen::InputStream::decodeBinary(GraphNode* element,
+                                                    uint32_t &weight)
+{
+    if (binOffset == binSize)
+        return false;
+
+    BinaryRecord rec;
+    panic_if(binSize - binOffset < sizeof(rec),
+             "Truncated record in binary trace %s\n", fileName);
+    std::memcpy(&rec, binData + binOffset, sizeof(rec));
+    binOffset += sizeof(rec);
+
+    const uint16_t num_rob_dep = letoh(rec.numRobDep);
+    const uint16_t num_reg_dep = letoh(rec.numRegDep);
+    panic_if(binSize - binOffset <
+             (num_rob_dep + num_reg_dep) * sizeof(uint64_t),
+             "Truncated record in binary trace %s\n", fileName);
+    panic_if(!ProtoMessage::InstDepRecord::RecordType_IsValid(rec.type),
+             "Invalid record type %d in binary trace %s\n",
+             rec.type, fileName);
+
+    element->seqNum = letoh(rec.seqNum);
+    element->type = static_cast<RecordType>(rec.type);
+    // Scale the compute delay to effectively scale the Trace CPU frequency
+    element->compDelay = letoh(rec.compDelay) * timeMultiplier;
+
+    element->robDep.clear();
+    for (int i = 0; i < num_rob_dep; i++) {
+        uint64_t dep;
+        std::memcpy(&dep, binData + binOffset, sizeof(dep));
+        binOffset += sizeof(dep);
+        element->robDep.push_back(letoh(dep));
+    }
+
+    element->regDep.clear();
+    for (int i = 0; i < num_reg_dep; i++) {
+        uint64_t dep;
+        std::memcpy(&dep, binData + binOffset, sizeof(dep));
+        binOffset += sizeof(dep);
+        dep = letoh(dep);
+        // As for the protobuf trace, a register dependency which is also
+        // an order dependency is omitted
+        bool duplicate = false;
+        for (auto &rob_dep: element->robDep) {
+            duplicate |= (dep == rob_dep);
         }
+        if (!duplicate)
+            element->regDep.push_back(dep);
+    }
+
+    element->physAddr = letoh(rec.physAddr);
+    element->virtAddr = letoh(rec.virtAddr);
+    element->size = letoh(rec.size);
+    element->flags = letoh(rec.flags);
+    element->pc = letoh(rec.pc);
+
+    weight = letoh(rec.weight);
+    return true;
+}
 
-        // Optional fields
-        if (pkt_msg.has_p_addr())
-            element->physAddr = pkt_msg.p_addr();
-        else
-            element->physAddr = 0;
-
-        if (pkt_msg.has_v_addr())
-            element->virtAddr = pkt_msg.v_addr();
-        else
-            element->virtAddr = 0;
-
-        if (pkt_msg.has_size())
-            element->size = pkt_msg.size();
-        else
-            element->size = 0;
-
-        if (pkt_msg.has_flags())
-            element->flags = pkt_msg.flags();
-        else
-            element->flags = 0;
-
-        if (pkt_msg.has_pc())
-            element->pc = pkt_msg.pc();
-        else
-            element->pc = 0;
-
-        // ROB occupancy number
-        ++microOpCount;
-        if (pkt_msg.has_weight()) {
-            microOpCount += pkt_msg.weight();
+void
+TraceCPU::ElasticDataGen::InputStream::readLoop()
+{
+    while (true) {
+        GraphNode *element = decode();
+        // Back off while the simulation thread catches up, the queue is
+        // normally deep enough to cover many windows.
+        while (!readQueue->push(element)) {
+            if (stopReading.load(std::memory_order_relaxed)) {
+                delete element;
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
         }
-        element->robNum = microOpCount;
-        return true;
+        // A null element marks the end of the trace
+        if (!element || stopReading.load(std::memory_order_relaxed))
+            return;
     }
+}
 
-    // We have reached the end of the file
-    return false;
+void
+TraceCPU::ElasticDataGen::InputStream::startReader()
+{
+    assert(readQueue && !readThread.joinable());
+    stopReading = false;
+    readThread = std::thread(&InputStream::readLoop, this);
+}
+
+void
+TraceCPU::ElasticDataGen::InputStream::stopReader()
+{
+    if (!readThread.joinable())
+        return;
+
+    stopReading = true;
+    readThread.join();
+
+    GraphNode *element;
+    while (readQueue->pop(element))
+        delete element;
 }
 
 bool
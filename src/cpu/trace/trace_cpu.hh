@@ -38,13 +38,17 @@
 #ifndef __CPU_TRACE_TRACE_CPU_HH__
 #define __CPU_TRACE_TRACE_CPU_HH__
 
+#include <atomic>
 #include <cstdint>
 #include <list>
+#include <memory>
 #include <queue>
 #include <set>
+#include <thread>
 #include <unordered_map>
 
 #include "arch/registers.hh"
+#include "base/spsc_queue.hh"
 #include "base/statistics.hh"
 #include "cpu/base.hh"
 #include "debug/TraceCPUData.hh"
@@ -755,12 +759,73 @@ class TraceCPU : public BaseCPU
          * The InputStream encapsulates a trace file and the
          * internal buffers and populates GraphNodes based on
          * the input.
+         *
+         * Two trace formats are accepted. The default is the (optionally
+         * gzipped) protobuf trace written by the ElasticTrace probe. The
+         * alternative is an uncompressed binary trace, recognised by its
+         * magic number, which is memory mapped and decoded in place; see
+         * util/convert_inst_dep_trace.py for the layout.
+         *
+         * Decoding can optionally be done by a reader thread which runs
+         * ahead of the simulation and hands fully decoded GraphNodes over
+         * through a bounded single-producer single-consumer queue. The
+         * nodes are linked into the dependency graph on the simulation
+         * thread, since that depends on which parents have completed.
          */
         class InputStream
         {
           private:
-            /** Input file stream for the protobuf trace */
-            ProtoInputStream trace;
+            /** Header of a binary elastic trace. */
+            struct BinaryHeader
+            {
+                uint32_t magic;
+                uint32_t version;
+                uint32_t windowSize;
+                uint32_t reserved;
+                uint64_t tickFreq;
+            };
+
+            /**
+             * Fixed-size part of a binary record. It is followed by
+             * numRobDep and then numRegDep 64-bit sequence numbers. All
+             * fields are little endian.
+             */
+            struct BinaryRecord
+            {
+                uint64_t seqNum;
+                uint64_t physAddr;
+                uint64_t virtAddr;
+                uint64_t pc;
+                uint64_t compDelay;
+                uint32_t size;
+                uint32_t flags;
+                uint32_t weight;
+                uint16_t numRobDep;
+                uint16_t numRegDep;
+                uint8_t type;
+                uint8_t reserved[7];
+            };
+
+            /** Magic number of a binary trace, "gEDT" in file order. */
+            static const uint32_t binaryMagic = 0x54444567;
+
+            /** Version of the binary trace layout. */
+            static const uint32_t binaryVersion = 1;
+
+            /** Name of the trace file, used for error messages. */
+            const std::string fileName;
+
+            /** Input file stream for a protobuf trace, if any */
+            std::unique_ptr<ProtoInputStream> protoTrace;
+
+            /** Memory mapped binary trace, null for a protobuf trace */
+            const uint8_t *binData;
+
+            /** Size of the mapped binary trace */
+            size_t binSize;
+
+            /** Offset of the next record in the binary trace */
+            size_t binOffset;
 
             /**
              * A multiplier for the compute delays in the trace to modulate
@@ -773,21 +838,67 @@ class TraceCPU : public BaseCPU
             /** Count of committed ops read from trace plus the filtered ops */
             uint64_t microOpCount;
 
+            /**
+             * Count of committed ops decoded so far, which may run ahead
+             * of microOpCount when the reader thread is in use. Only
+             * accessed by the decoding thread.
+             */
+            uint64_t decodedOpCount;
+
             /**
              * The window size that is read from the header of the protobuf
              * trace and used to process the dependency trace
              */
             uint32_t windowSize;
 
+            /** Decoded nodes, only allocated when using a reader thread */
+            std::unique_ptr<SPSCQueue<GraphNode *>> readQueue;
+
+            /** Thread decoding the trace into readQueue */
+            std::thread readThread;
+
+            /** Request to the reader thread to stop decoding */
+            std::atomic<bool> stopReading;
+
+            /** Set when the end-of-trace marker has been dequeued */
+            bool readDone;
+
+            /**
+             * Decode the next record into a newly allocated node.
+             *
+             * @return The node, or nullptr at the end of the trace
+             */
+            GraphNode *decode();
+
+            /** Decode the next protobuf record */
+            bool decodeProto(GraphNode *element, uint32_t &weight);
+
+            /** Decode the next binary record */
+            bool decodeBinary(GraphNode *element, uint32_t &weight);
+
+            /** Body of the reader thread */
+            void readLoop();
+
+            /** Start the reader thread at the current trace position */
+            void startReader();
+
+            /** Stop the reader thread and free the nodes it decoded */
+            void stopReader();
+
           public:
             /**
              * Create a trace input stream for a given file name.
              *
              * @param filename Path to the file to read from
              * @param time_multiplier used to scale the compute delays
+             * @param read_queue_size capacity of the queue filled by the
+             *        reader thread, or 0 to decode on the calling thread
              */
             InputStream(const std::string& filename,
-                        const double time_multiplier);
+                        const double time_multiplier,
+                        unsigned read_queue_size);
+
+            ~InputStream();
 
             /**
              * Reset the stream such that it can be played once
@@ -796,15 +907,13 @@ class TraceCPU : public BaseCPU
             void reset();
 
             /**
-             * Attempt to read a trace element from the stream,
-             * and also notify the caller if the end of the file
-             * was reached.
+             * Attempt to read the next trace element from the stream.
+             * Ownership of the returned node passes to the caller.
              *
-             * @param element Trace element to populate
-             * @param size of register dependency array stored in the element
-             * @return True if an element could be read successfully
+             * @return The next node, or nullptr if the end of the file was
+             *         reached
              */
-            bool read(GraphNode* element);
+            GraphNode *read();
 
             /** Get window size from trace */
             uint32_t getWindowSize() const { return windowSize; }
@@ -822,7 +931,8 @@ class TraceCPU : public BaseCPU
             owner(_owner),
             port(_port),
             requestorId(requestor_id),
-            trace(trace_file, 1.0 / params.freqMultiplier),
+            trace(trace_file, 1.0 / params.freqMultiplier,
+                  params.readThread ? params.readQueueSize : 0),
             genName(owner.name() + ".elastic." + _name),
             retryPkt(nullptr),
             traceComplete(false),
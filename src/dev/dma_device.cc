@@ -110,7 +110,7 @@ DmaPort::handleResp(DmaReqState *state, Addr addr, Addr size, Tick delay)
 PacketPtr
 DmaPort::DmaReqState::createPacket()
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
             gen.addr(), gen.size(), flags, id);
     req->setStreamId(sid);
     req->setSubstreamId(ssid);
@@ -257,8 +257,15 @@ DmaPort::sendAtomicBdReq(DmaReqState *state)
     bool done = false;
 
     auto bd_it = memBackdoors.contains(state->gen.addr());
+    // A backdoor may only allow some kinds of accesses, e.g. reads.
+    if (bd_it != memBackdoors.end() &&
+            !(MemCmd(state->cmd).isRead() ? bd_it->second->readable() :
+                                            bd_it->second->writeable())) {
+        bd_it = memBackdoors.end();
+    }
     if (bd_it == memBackdoors.end()) {
-        // We don't have a backdoor for this address, so use a packet.
+        // We don't have a usable backdoor for this address, so use a
+        // packet.
 
         PacketPtr pkt = state->createPacket();
         DPRINTF(DMA, "Sending DMA for addr: %#x size: %d\n",
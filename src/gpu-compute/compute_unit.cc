@@ -1224,7 +1224,7 @@ ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
            gpuDynInst->executedAs() == Enums::SC_GLOBAL);
 
     if (!req) {
-        req = std::make_shared<Request>(
+        req = Request::create(
             0, 0, 0, requestorId(), 0, gpuDynInst->wfDynId);
     }
 
@@ -1484,7 +1484,7 @@ ComputeUnit::DTLBPort::recvTimingResp(PacketPtr pkt)
             if (!stride)
                 break;
 
-            RequestPtr prefetch_req = std::make_shared<Request>(
+            RequestPtr prefetch_req = Request::create(
                 vaddr + stride * pf * X86ISA::PageBytes,
                 sizeof(uint8_t), 0,
                 computeUnit->requestorId(),
@@ -1984,7 +1984,7 @@ ComputeUnit::sendToLds(GPUDynInstPtr gpuDynInst)
 {
     // this is just a request to carry the GPUDynInstPtr
     // back and forth
-    RequestPtr newRequest = std::make_shared<Request>();
+    RequestPtr newRequest = Request::create();
     newRequest->setPaddr(0x0);
 
     // ReadReq is not evaluted by the LDS but the Packet ctor requires this
@@ -514,19 +514,19 @@ namespace X86ISA
                                 "at pc %#x.\n", vaddr, tc->instAddr());
 
                         Process *p = tc->getProcessPtr();
-                        const EmulationPageTable::Entry *pte =
-                            p->pTable->lookup(vaddr);
+                        EmulationPageTable::Entry pte;
+                        bool mapped = p->pTable->lookup(vaddr, pte);
 
-                        if (!pte && mode != BaseTLB::Execute) {
+                        if (!mapped && mode != BaseTLB::Execute) {
                             // penalize a "page fault" more
                             if (timing)
                                 latency += missLatency2;
 
                             if (p->fixupFault(vaddr))
-                                pte = p->pTable->lookup(vaddr);
+                                mapped = p->pTable->lookup(vaddr, pte);
                         }
 
-                        if (!pte) {
+                        if (!mapped) {
                             return std::make_shared<PageFault>(vaddr, true,
                                                                mode, true,
                                                                false);
@@ -534,10 +534,10 @@ namespace X86ISA
                             Addr alignedVaddr = p->pTable->pageAlign(vaddr);
 
                             DPRINTF(GPUTLB, "Mapping %#x to %#x\n",
-                                    alignedVaddr, pte->paddr);
+                                    alignedVaddr, pte.paddr);
 
                             TlbEntry gpuEntry(p->pid(), alignedVaddr,
-                                              pte->paddr, false, false);
+                                              pte.paddr, false, false);
                             entry = insert(alignedVaddr, gpuEntry);
                         }
 
@@ -964,18 +964,19 @@ namespace X86ISA
             Addr alignedVaddr = p->pTable->pageAlign(vaddr);
             assert(alignedVaddr == virtPageAddr);
     #endif
-            const EmulationPageTable::Entry *pte = p->pTable->lookup(vaddr);
-            if (!pte && sender_state->tlbMode != BaseTLB::Execute &&
+            EmulationPageTable::Entry pte;
+            bool mapped = p->pTable->lookup(vaddr, pte);
+            if (!mapped && sender_state->tlbMode != BaseTLB::Execute &&
                     p->fixupFault(vaddr)) {
-                pte = p->pTable->lookup(vaddr);
+                mapped = p->pTable->lookup(vaddr, pte);
             }
 
-            if (pte) {
+            if (mapped) {
                 DPRINTF(GPUTLB, "Mapping %#x to %#x\n", alignedVaddr,
-                        pte->paddr);
+                        pte.paddr);
 
                 sender_state->tlbEntry =
-                    new TlbEntry(p->pid(), virtPageAddr, pte->paddr, false,
+                    new TlbEntry(p->pid(), virtPageAddr, pte.paddr, false,
                                  false);
             } else {
                 sender_state->tlbEntry = nullptr;
@@ -1169,36 +1170,36 @@ namespace X86ISA
                 assert(alignedVaddr == virt_page_addr);
     #endif
 
-                const EmulationPageTable::Entry *pte =
-                        p->pTable->lookup(vaddr);
-                if (!pte && sender_state->tlbMode != BaseTLB::Execute &&
+                EmulationPageTable::Entry pte;
+                bool mapped = p->pTable->lookup(vaddr, pte);
+                if (!mapped && sender_state->tlbMode != BaseTLB::Execute &&
                         p->fixupFault(vaddr)) {
-                    pte = p->pTable->lookup(vaddr);
+                    mapped = p->pTable->lookup(vaddr, pte);
                 }
 
                 if (!sender_state->prefetch) {
                     // no PageFaults are permitted after
                     // the second page table lookup
-                    assert(pte);
+                    assert(mapped);
 
                     DPRINTF(GPUTLB, "Mapping %#x to %#x\n", alignedVaddr,
-                            pte->paddr);
+                            pte.paddr);
 
                     sender_state->tlbEntry =
                         new TlbEntry(p->pid(), virt_page_addr,
-                                     pte->paddr, false, false);
+                                     pte.paddr, false, false);
                 } else {
                     // If this was a prefetch, then do the normal thing if it
                     // was a successful translation.  Otherwise, send an empty
                     // TLB entry back so that it can be figured out as empty
                     // and handled accordingly.
-                    if (pte) {
+                    if (mapped) {
                         DPRINTF(GPUTLB, "Mapping %#x to %#x\n", alignedVaddr,
-                                pte->paddr);
+                                pte.paddr);
 
                         sender_state->tlbEntry =
                             new TlbEntry(p->pid(), virt_page_addr,
-                                         pte->paddr, false, false);
+                                         pte.paddr, false, false);
                     } else {
                         DPRINTF(GPUPrefetch, "Prefetch failed %#x\n",
                                 alignedVaddr);
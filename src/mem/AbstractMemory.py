@@ -66,6 +66,19 @@ class AbstractMemory(ClockedObject):
     # the kernel, e.g. using ATAG or ACPI
     conf_table_reported = Param.Bool(True, "Report to configuration table")
 
+    # Host NUMA node the backing store of this memory is bound to,
+    # typically the node running the thread of its event queue. All
+    # memories sharing an interleaved backing store must agree.
+    host_numa_node = Param.Int(-1, "Host NUMA node to bind the backing "
+                               "store to (-1 for no binding)")
+
+    # Track which pages of the backing store have been written, so that
+    # reads of the others, and zero writes to them, are served without
+    # the host having to provide the memory. The backdoor of a sparse
+    # memory is read-only. Tracking stops if the backing store is handed
+    # out, e.g. to KVM.
+    sparse = Param.Bool(False, "Serve unwritten pages as zero")
+
     # Image file to load into this memory as its initial contents. This is
     # particularly useful for ROMs.
     image_file = Param.String('',
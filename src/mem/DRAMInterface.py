@@ -56,6 +56,11 @@ class DRAMInterface(MemInterface):
     max_accesses_per_row = Param.Unsigned(16, "Max accesses per row before "
                                           "closing");
 
+    # check the FR-FCFS decisions made with the per-bank queues against a
+    # scan of the whole queue, for debugging the scheduler
+    verify_frfcfs = Param.Bool(False, "Verify FR-FCFS decisions against a "
+                               "queue scan")
+
     # default to 0 bank groups per rank, indicating bank group architecture
     # is not used
     # update per memory class when bank group architecture is supported
@@ -65,6 +70,11 @@ class DRAMInterface(MemInterface):
     # performance being lower when enabled
     enable_dram_powerdown = Param.Bool(False, "Enable powerdown states")
 
+    # perform the refreshes of idle ranks lazily, on the next request or
+    # stats event, rather than through events, only applies when
+    # powerdown is disabled as idle ranks otherwise go to self-refresh
+    lazy_refresh = Param.Bool(False, "Perform refreshes of idle ranks lazily")
+
     # For power modelling we need to know if the DRAM has a DLL or not
     dll = Param.Bool(True, "DRAM has DLL or not")
 
@@ -40,9 +40,12 @@
 
 #include "mem/abstract_mem.hh"
 
+#include <algorithm>
+#include <cstring>
 #include <vector>
 
 #include "arch/locked_mem.hh"
+#include "base/intmath.hh"
 #include "base/loader/memory_image.hh"
 #include "base/loader/object_file.hh"
 #include "cpu/thread_context.hh"
@@ -51,13 +54,20 @@
 #include "mem/packet_access.hh"
 #include "sim/system.hh"
 
+const Addr AbstractMemory::SparsePageBytes;
+
 AbstractMemory::AbstractMemory(const Params &p) :
     ClockedObject(p), range(p.range), pmemAddr(NULL),
     backdoor(params().range, nullptr,
+             // writes through the backdoor would not be seen by the
+             // tracking of a sparse memory, but reads return the zeros
+             // of unwritten pages as they are
              (MemBackdoor::Flags)(MemBackdoor::Readable |
-                                  MemBackdoor::Writeable)),
+                                  (p.sparse ? MemBackdoor::NoAccess :
+                                              MemBackdoor::Writeable))),
     confTableReported(p.conf_table_reported), inAddrMap(p.in_addr_map),
-    kvmMap(p.kvm_map), _system(NULL),
+    kvmMap(p.kvm_map), hostNumaNode(p.host_numa_node), sparse(p.sparse),
+    numWrittenPages(0), _system(NULL),
     stats(*this)
 {
     panic_if(!range.valid() || !range.size(),
@@ -107,6 +117,80 @@ AbstractMemory::setBackingStore(uint8_t* pmem_addr)
     backdoor.ptr(range.interleaved() ? nullptr : pmem_addr);
 
     pmemAddr = pmem_addr;
+
+    // the offsets of an interleaved memory span the whole backing store
+    if (sparse) {
+        writtenPages.assign(divCeil(range.end() - range.start(),
+                                    SparsePageBytes), false);
+        numWrittenPages = 0;
+    }
+}
+
+bool
+AbstractMemory::pagesUnwritten(Addr offset, Addr size) const
+{
+    const Addr last_page = (offset + size - 1) / SparsePageBytes;
+    for (Addr page = offset / SparsePageBytes; page <= last_page; ++page) {
+        if (writtenPages[page])
+            return false;
+    }
+    return true;
+}
+
+void
+AbstractMemory::setPagesWritten(Addr offset, Addr size)
+{
+    if (!sparse)
+        return;
+
+    const Addr last_page = (offset + size - 1) / SparsePageBytes;
+    for (Addr page = offset / SparsePageBytes; page <= last_page; ++page) {
+        if (!writtenPages[page]) {
+            writtenPages[page] = true;
+            ++numWrittenPages;
+        }
+    }
+}
+
+bool
+AbstractMemory::trackWrite(PacketPtr pkt)
+{
+    if (!sparse)
+        return true;
+
+    const Addr offset = pkt->getAddr() - range.start();
+
+    // the pages already hold zeros, so only the first non-zero write
+    // needs the host to provide them
+    if (pagesUnwritten(offset, pkt->getSize())) {
+        const uint8_t *data = pkt->getConstPtr<uint8_t>();
+        if (std::all_of(data, data + pkt->getSize(),
+                        [](uint8_t b) { return b == 0; })) {
+            stats.zeroPageWrites++;
+            return false;
+        }
+    }
+
+    setPagesWritten(offset, pkt->getSize());
+    return true;
+}
+
+void
+AbstractMemory::exposeBackingStore()
+{
+    if (!sparse)
+        return;
+
+    warn("%s: Backing store accessed directly, no longer tracking the "
+         "pages written.\n", name());
+
+    sparse = false;
+    numWrittenPages = writtenPages.size();
+    std::vector<bool>().swap(writtenPages);
+
+    // holders of the read-only backdoor may now get a writeable one
+    backdoor.invalidate();
+    backdoor.writeable(true);
 }
 
 AbstractMemory::MemStats::MemStats(AbstractMemory &_mem)
@@ -129,8 +213,15 @@ AbstractMemory::MemStats::MemStats(AbstractMemory &_mem)
     ADD_STAT(bwWrite, UNIT_RATE(Stats::Units::Byte, Stats::Units::Second),
              "Write bandwidth from this memory"),
     ADD_STAT(bwTotal, UNIT_RATE(Stats::Units::Byte, Stats::Units::Second),
-             "Total bandwidth to/from this memory")
+             "Total bandwidth to/from this memory"),
+    ADD_STAT(pagesWritten, UNIT_COUNT,
+             "Number of backing store pages written"),
+    ADD_STAT(zeroPageReads, UNIT_COUNT,
+             "Number of reads served as zero from unwritten pages"),
+    ADD_STAT(zeroPageWrites, UNIT_COUNT,
+             "Number of zero writes to unwritten pages skipped")
 {
+    pagesWritten.functor([this] { return mem.numWrittenPages; });
 }
 
 void
@@ -232,6 +323,10 @@ AbstractMemory::MemStats::regStats()
     bwInstRead = bytesInstRead / simSeconds;
     bwWrite = bytesWritten / simSeconds;
     bwTotal = (bytesRead + bytesWritten) / simSeconds;
+
+    pagesWritten.flags(nozero);
+    zeroPageReads.flags(nozero);
+    zeroPageWrites.flags(nozero);
 }
 
 AddrRange
@@ -386,6 +481,8 @@ AbstractMemory::access(PacketPtr pkt)
     if (pkt->cmd == MemCmd::SwapReq) {
         if (pkt->isAtomicOp()) {
             if (pmemAddr) {
+                setPagesWritten(pkt->getAddr() - range.start(),
+                                pkt->getSize());
                 pkt->setData(host_addr);
                 (*(pkt->getAtomicOp()))(host_addr);
             }
@@ -397,6 +494,8 @@ AbstractMemory::access(PacketPtr pkt)
             panic_if(!pmemAddr, "Swap only works if there is real memory " \
                      "(i.e. null=False)");
 
+            setPagesWritten(pkt->getAddr() - range.start(), pkt->getSize());
+
             bool overwrite_mem = true;
             // keep a copy of our possible write value, and copy what is at the
             // memory address into the packet
@@ -432,7 +531,13 @@ AbstractMemory::access(PacketPtr pkt)
             trackLoadLocked(pkt);
         }
         if (pmemAddr) {
-            pkt->setData(host_addr);
+            if (sparse && pagesUnwritten(pkt->getAddr() - range.start(),
+                                         pkt->getSize())) {
+                std::memset(pkt->getPtr<uint8_t>(), 0, pkt->getSize());
+                stats.zeroPageReads++;
+            } else {
+                pkt->setData(host_addr);
+            }
         }
         TRACE_PACKET(pkt->req->isInstFetch() ? "IFetch" : "Read");
         stats.numReads[pkt->req->requestorId()]++;
@@ -447,7 +552,7 @@ AbstractMemory::access(PacketPtr pkt)
         // no need to do anything
     } else if (pkt->isWrite()) {
         if (writeOK(pkt)) {
-            if (pmemAddr) {
+            if (pmemAddr && trackWrite(pkt)) {
                 pkt->writeData(host_addr);
                 DPRINTF(MemoryAccess, "%s write due to %s\n",
                         __func__, pkt->print());
@@ -475,12 +580,17 @@ AbstractMemory::functionalAccess(PacketPtr pkt)
 
     if (pkt->isRead()) {
         if (pmemAddr) {
-            pkt->setData(host_addr);
+            if (sparse && pagesUnwritten(pkt->getAddr() - range.start(),
+                                         pkt->getSize())) {
+                std::memset(pkt->getPtr<uint8_t>(), 0, pkt->getSize());
+            } else {
+                pkt->setData(host_addr);
+            }
         }
         TRACE_PACKET("Read");
         pkt->makeResponse();
     } else if (pkt->isWrite()) {
-        if (pmemAddr) {
+        if (pmemAddr && trackWrite(pkt)) {
             pkt->writeData(host_addr);
         }
         TRACE_PACKET("Write");
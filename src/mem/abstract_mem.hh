@@ -46,6 +46,8 @@
 #ifndef __MEM_ABSTRACT_MEMORY_HH__
 #define __MEM_ABSTRACT_MEMORY_HH__
 
+#include <vector>
+
 #include "mem/backdoor.hh"
 #include "mem/port.hh"
 #include "params/AbstractMemory.hh"
@@ -123,6 +125,37 @@ class AbstractMemory : public ClockedObject
     // Should KVM map this memory for the guest
     const bool kvmMap;
 
+    // Host NUMA node to bind the backing store to, if any
+    const int hostNumaNode;
+
+    // Track the pages written in the backing store, which is only
+    // possible as long as nothing accesses it directly
+    bool sparse;
+
+    // One bit per page of the backing store, set once the page may
+    // hold non-zero data, and the number of such pages
+    std::vector<bool> writtenPages;
+    uint64_t numWrittenPages;
+
+    /**
+     * Check if a part of the backing store has never been written,
+     * and thus holds zeros only.
+     *
+     * @param offset Offset in the backing store
+     * @param size Number of bytes
+     * @return true if all pages covering the bytes are unwritten
+     */
+    bool pagesUnwritten(Addr offset, Addr size) const;
+
+    /**
+     * Account for a write about to be done to the backing store.
+     *
+     * @param pkt Write packet
+     * @return false if the write is of zeros to unwritten pages only,
+     *         and can thus be skipped
+     */
+    bool trackWrite(PacketPtr pkt);
+
     std::list<LockedAddr> lockedAddrList;
 
     // helper function for checkLockedAddrs(): we really want to
@@ -191,6 +224,12 @@ class AbstractMemory : public ClockedObject
         Stats::Formula bwWrite;
         /** Total bandwidth from this memory */
         Stats::Formula bwTotal;
+        /** Number of backing store pages written */
+        Stats::Value pagesWritten;
+        /** Number of reads served as zero from unwritten pages */
+        Stats::Scalar zeroPageReads;
+        /** Number of zero writes to unwritten pages that were skipped */
+        Stats::Scalar zeroPageWrites;
     } stats;
 
 
@@ -204,6 +243,9 @@ class AbstractMemory : public ClockedObject
 
   public:
 
+    /** Granularity of the page tracking of a sparse memory */
+    static const Addr SparsePageBytes = 4096;
+
     PARAMS(AbstractMemory);
 
     AbstractMemory(const Params &p);
@@ -234,6 +276,29 @@ class AbstractMemory : public ClockedObject
             bd_ptr = &backdoor;
     }
 
+    /**
+     * Is this memory tracking the pages written in its backing store?
+     *
+     * @return true if sparse
+     */
+    bool isSparse() const { return sparse; }
+
+    /**
+     * Record that a part of the backing store was written outside of
+     * the memory, e.g. when restoring a checkpoint.
+     *
+     * @param offset Offset in the backing store
+     * @param size Number of bytes
+     */
+    void setPagesWritten(Addr offset, Addr size);
+
+    /**
+     * Stop tracking the pages written, as the caller is about to
+     * access the backing store directly. All pages are considered
+     * written from then on, and the backdoor becomes writeable.
+     */
+    void exposeBackingStore();
+
     /**
      * Get the list of locked addresses to allow checkpointing.
      */
@@ -324,6 +389,14 @@ class AbstractMemory : public ClockedObject
      */
     bool isKvmMap() const { return kvmMap; }
 
+    /**
+     * Host NUMA node that the backing store of this memory should be
+     * allocated on.
+     *
+     * @return the node, or -1 if placement is left to the host OS
+     */
+    int getHostNumaNode() const { return hostNumaNode; }
+
     /**
      * Perform an untimed memory access and update all the state
      * (e.g. locked addresses) and statistics accordingly. The packet
@@ -84,7 +84,10 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       writeAllocator(p.write_allocator),
       writebackClean(p.writeback_clean),
       tempBlockWriteback(nullptr),
-      writebackTempBlockAtomicEvent([this]{ writebackTempBlockAtomic(); },
+      writebackTempBlockAtomicEvent([this]{
+                                        auto lock = lockParallelAccess();
+                                        writebackTempBlockAtomic();
+                                    },
                                     name(), false,
                                     EventBase::Delayed_Writeback_Pri),
       blkSize(blk_size),
@@ -627,6 +630,72 @@ BaseCache::recvAtomic(PacketPtr pkt)
     return lat * clockPeriod();
 }
 
+bool
+BaseCache::warmAccess(PacketPtr pkt, Tick &lat)
+{
+    const bool is_write = pkt->cmd == MemCmd::WriteReq;
+    // Whole-line writes may be promoted and compressed blocks may have
+    // to be recompressed, so leave both to the generic path
+    if ((!is_write && pkt->cmd != MemCmd::ReadReq) ||
+        (is_write && (isReadOnly || pkt->getSize() == blkSize)) ||
+        compressor || pkt->req->isUncacheable() ||
+        pkt->isLLSC() || pkt->req->isLockedRMW() ||
+        pkt->req->isStrictlyOrdered()) {
+        return false;
+    }
+
+    auto lock = lockParallelAccess();
+
+    // Check the state before touching the replacement data so that a
+    // request falling back to the port is not accounted for twice
+    CacheBlk *blk = tags->findBlock(pkt->getAddr(), pkt->isSecure());
+    if (!blk || !blk->isSet(CacheBlk::ReadableBit) ||
+        (is_write && !blk->isSet(CacheBlk::WritableBit))) {
+        // The request is served through the port, but let the probe
+        // listeners (e.g., the prefetcher) train on the miss as they
+        // would in timing mode
+        ppMiss->notify(pkt);
+        return false;
+    }
+
+    Cycles tag_latency(0);
+    M5_VAR_USED CacheBlk *hit_blk =
+        tags->accessBlock(pkt->getAddr(), pkt->isSecure(), tag_latency);
+    assert(hit_blk == blk);
+
+    DPRINTF(Cache, "%s for %s hit %s\n", __func__, pkt->print(),
+            blk->print());
+
+    // Same latency as a hit through access()
+    const Cycles hit_lat = is_write ?
+        calculateTagOnlyLatency(pkt->headerDelay, tag_latency) :
+        calculateAccessLatency(blk, pkt->headerDelay, tag_latency);
+
+    if (is_write) {
+        if (blk->checkWrite(pkt)) {
+            updateBlockData(blk, pkt, true);
+        }
+        blk->setCoherenceBits(CacheBlk::DirtyBit);
+    } else {
+        pkt->setDataFromBlock(blk->data, blkSize);
+    }
+
+    incHitCount(pkt);
+
+    // Notify the listeners as a timing hit does, so that a prefetcher
+    // behind a warmed cache sees the same access stream
+    ppHit->notify(pkt);
+
+    if (prefetcher && blk->wasPrefetched()) {
+        blk->clearPrefetched();
+    }
+
+    pkt->makeAtomicResponse();
+
+    lat = hit_lat * clockPeriod();
+    return true;
+}
+
 void
 BaseCache::functionalAccess(PacketPtr pkt, bool from_cpu_side)
 {
@@ -1603,7 +1672,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 
     stats.writebacks[Request::wbRequestorId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1646,7 +1715,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure()) {
@@ -1720,7 +1789,7 @@ BaseCache::writebackVisitor(CacheBlk &blk)
     if (blk.isSet(CacheBlk::DirtyBit)) {
         assert(blk.isValid());
 
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = Request::create(
             regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
 
         request->taskId(blk.getTaskId());
@@ -2433,6 +2502,8 @@ BaseCache::CpuSidePort::recvTimingReq(PacketPtr pkt)
 Tick
 BaseCache::CpuSidePort::recvAtomic(PacketPtr pkt)
 {
+    auto lock = cache->lockParallelAccess();
+
     if (cache->system->bypassCaches()) {
         // Forward the request if the system is in cache bypass mode.
         return cache->memSidePort.sendAtomic(pkt);
@@ -2444,6 +2515,8 @@ BaseCache::CpuSidePort::recvAtomic(PacketPtr pkt)
 void
 BaseCache::CpuSidePort::recvFunctional(PacketPtr pkt)
 {
+    auto lock = cache->lockParallelAccess();
+
     if (cache->system->bypassCaches()) {
         // The cache should be flushed if we are in cache bypass mode,
         // so we don't need to check if we need to update anything.
@@ -2498,6 +2571,7 @@ BaseCache::MemSidePort::recvAtomicSnoop(PacketPtr pkt)
     // Snoops shouldn't happen when bypassing caches
     assert(!cache->system->bypassCaches());
 
+    auto lock = cache->lockParallelAccess();
     return cache->recvAtomicSnoop(pkt);
 }
 
@@ -2510,6 +2584,7 @@ BaseCache::MemSidePort::recvFunctionalSnoop(PacketPtr pkt)
     // functional snoop (note that in contrast to atomic we don't have
     // a specific functionalSnoop method, as they have the same
     // behaviour regardless)
+    auto lock = cache->lockParallelAccess();
     cache->functionalAccess(pkt, false);
 }
 
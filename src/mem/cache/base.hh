@@ -48,6 +48,7 @@
 
 #include <cassert>
 #include <cstdint>
+#include <mutex>
 #include <string>
 
 #include "base/addr_range.hh"
@@ -680,6 +681,26 @@ class BaseCache : public ClockedObject
      * recvAtomic finishes in cases where the block we filled is in
      * fact the tempBlock, and now needs to be written back.
      */
+    /**
+     * Serializes the atomic and functional accesses to the cache when the
+     * CPU in front of it and the rest of the memory system are simulated
+     * by separate host threads, see warmAccess().
+     */
+    std::recursive_mutex parallelAccessLock;
+
+    /**
+     * Take parallelAccessLock if the simulation runs in parallel mode.
+     *
+     * @return The lock, released when it goes out of scope.
+     */
+    std::unique_lock<std::recursive_mutex>
+    lockParallelAccess()
+    {
+        if (inParallelMode)
+            return std::unique_lock<std::recursive_mutex>(parallelAccessLock);
+        return std::unique_lock<std::recursive_mutex>();
+    }
+
     void writebackTempBlockAtomic() {
         assert(tempBlockWriteback != nullptr);
         PacketList writebacks{tempBlockWriteback};
@@ -1157,6 +1178,26 @@ class BaseCache : public ClockedObject
 
     const AddrRangeList &getAddrRanges() const { return addrRanges; }
 
+    /**
+     * Lightweight hit path for CPUs doing functional warming in atomic
+     * mode. Plain reads and writes that hit a block in a sufficient
+     * coherence state are satisfied with a direct call that updates the
+     * replacement state and the block data, without going through the
+     * port and the generic access path. Everything else (misses,
+     * upgrades, uncacheable, LL/SC and maintenance requests) is left
+     * untouched and has to be sent through the port as usual. Hits and
+     * plain misses notify the Hit and Miss probe points, so listeners
+     * such as the prefetcher are trained as in timing mode. The caller
+     * must be the only requestor connected to the CPU side of this cache.
+     * It may call this from its own host thread in parallel mode, the
+     * access is then serialized with those coming from the memory side.
+     *
+     * @param pkt The request, turned into a response when satisfied.
+     * @param lat Set to the latency of the access when satisfied.
+     * @return true if the access was satisfied by this cache.
+     */
+    bool warmAccess(PacketPtr pkt, Tick &lat);
+
     MSHR *allocateMissBuffer(PacketPtr pkt, Tick time, bool sched_send = true)
     {
         MSHR *mshr = mshrQueue.allocate(pkt->getBlockAddr(blkSize), blkSize,
@@ -112,13 +112,14 @@ Base::toChunks(const uint64_t* data) const
     const unsigned num_chunks_per_64 =
         (sizeof(uint64_t) * CHAR_BIT) / chunkSizeBits;
 
-    // Turn a 64-bit array into a chunkSizeBits-array
+    // Turn a 64-bit array into a chunkSizeBits-array. Plain shifts and
+    // masks let the compiler vectorize the loop
+    const uint64_t chunk_mask = mask(chunkSizeBits);
     std::vector<Chunk> chunks((blkSize * CHAR_BIT) / chunkSizeBits, 0);
-    for (int i = 0; i < chunks.size(); i++) {
-        const int index_64 = std::floor(i / (double)num_chunks_per_64);
+    for (unsigned i = 0; i < chunks.size(); i++) {
+        const unsigned index_64 = i / num_chunks_per_64;
         const unsigned start = i % num_chunks_per_64;
-        chunks[i] = bits(data[index_64],
-            (start + 1) * chunkSizeBits - 1, start * chunkSizeBits);
+        chunks[i] = (data[index_64] >> (start * chunkSizeBits)) & chunk_mask;
     }
 
     return chunks;
@@ -132,12 +133,12 @@ Base::fromChunks(const std::vector<Chunk>& chunks, uint64_t* data) const
         (sizeof(uint64_t) * CHAR_BIT) / chunkSizeBits;
 
     // Turn a chunkSizeBits-array into a 64-bit array
+    const uint64_t chunk_mask = mask(chunkSizeBits);
     std::memset(data, 0, blkSize);
-    for (int i = 0; i < chunks.size(); i++) {
-        const int index_64 = std::floor(i / (double)num_chunks_per_64);
+    for (unsigned i = 0; i < chunks.size(); i++) {
+        const unsigned index_64 = i / num_chunks_per_64;
         const unsigned start = i % num_chunks_per_64;
-        replaceBits(data[index_64], (start + 1) * chunkSizeBits - 1,
-            start * chunkSizeBits, chunks[i]);
+        data[index_64] |= (chunks[i] & chunk_mask) << (start * chunkSizeBits);
     }
 }
 
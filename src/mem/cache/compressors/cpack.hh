@@ -47,7 +47,7 @@ namespace Compressor {
 
 class CPack : public DictionaryCompressor<uint32_t>
 {
-  private:
+  protected:
     using DictionaryEntry = DictionaryCompressor<uint32_t>::DictionaryEntry;
 
     // Forward declaration of all possible patterns
@@ -96,6 +96,15 @@ class CPack : public DictionaryCompressor<uint32_t>
         return PatternFactory::getPattern(bytes, dict_bytes, match_location);
     }
 
+    std::size_t
+    getPatternSizeBits(const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes,
+        const int match_location) const override
+    {
+        return PatternFactory::getPatternSizeBits(bytes, dict_bytes,
+                                                  match_location);
+    }
+
     void addToDictionary(DictionaryEntry data) override;
 
   public:
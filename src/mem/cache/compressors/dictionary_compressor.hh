@@ -163,6 +163,23 @@ class DictionaryCompressor : public BaseDictionaryCompressor
                                                     match_location);
             }
         }
+
+        /**
+         * Get the size of the pattern getPattern() would instantiate. The
+         * pattern is only built on the stack to query its size, so no
+         * allocation takes place.
+         */
+        static std::size_t
+        getPatternSizeBits(const DictionaryEntry& bytes,
+            const DictionaryEntry& dict_bytes, const int match_location)
+        {
+            if (Head::isPattern(bytes, dict_bytes, match_location)) {
+                return Head(bytes, match_location).getSizeBits();
+            } else {
+                return Factory<Tail...>::getPatternSizeBits(bytes, dict_bytes,
+                                                            match_location);
+            }
+        }
     };
 
     /**
@@ -184,6 +201,13 @@ class DictionaryCompressor : public BaseDictionaryCompressor
         {
             return std::unique_ptr<Pattern>(new Head(bytes, match_location));
         }
+
+        static std::size_t
+        getPatternSizeBits(const DictionaryEntry& bytes,
+            const DictionaryEntry& dict_bytes, const int match_location)
+        {
+            return Head(bytes, match_location).getSizeBits();
+        }
     };
 
     /** The dictionary. */
@@ -198,6 +222,54 @@ class DictionaryCompressor : public BaseDictionaryCompressor
     getPattern(const DictionaryEntry& bytes, const DictionaryEntry& dict_bytes,
         const int match_location) const = 0;
 
+    /**
+     * Get the size of the pattern getPattern() would return. Searching the
+     * dictionary only needs the sizes of the candidate patterns, so
+     * compressors should forward this to their factory's, which does not
+     * allocate the candidates.
+     */
+    virtual std::size_t
+    getPatternSizeBits(const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes, const int match_location) const
+    {
+        return getPattern(bytes, dict_bytes, match_location)->getSizeBits();
+    }
+
+    /**
+     * Search a dictionary for the entry whose pattern encodes the given bytes
+     * in the fewest bits. The no-match pattern is tried first, and only a
+     * strictly smaller candidate replaces the current best one.
+     *
+     * @param bytes The bytes to be compressed.
+     * @param dictionary The dictionary to be searched.
+     * @param num_entries The number of valid entries in the dictionary.
+     * @param size_bits Gives the pattern size of (bytes, entry, location).
+     * @return The location of the best match, or -1 if there is none.
+     */
+    template <class SizeBits>
+    static int
+    findBestMatch(const DictionaryEntry& bytes,
+        const std::vector<DictionaryEntry>& dictionary,
+        std::size_t num_entries, SizeBits size_bits)
+    {
+        // A negative match location is used so that patterns that depend
+        // on the dictionary entry don't match
+        const DictionaryEntry no_match_bytes{};
+        int match_location = -1;
+        std::size_t best_size_bits =
+            size_bits(bytes, no_match_bytes, match_location);
+
+        for (std::size_t i = 0; i < num_entries; i++) {
+            const std::size_t temp_size_bits =
+                size_bits(bytes, dictionary[i], i);
+            if (temp_size_bits < best_size_bits) {
+                best_size_bits = temp_size_bits;
+                match_location = i;
+            }
+        }
+        return match_location;
+    }
+
     /**
      * Compress data.
      *
@@ -0,0 +1,268 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "mem/cache/compressors/base_delta.hh"
+#include "mem/cache/compressors/cpack.hh"
+#include "mem/cache/compressors/dictionary_compressor_impl.hh"
+#include "mem/cache/compressors/fpc.hh"
+#include "mem/cache/compressors/fpcd.hh"
+#include "mem/cache/compressors/repeated_qwords.hh"
+#include "mem/cache/compressors/zero.hh"
+
+using namespace Compressor;
+
+/**
+ * Exposes the pattern factory of a dictionary compressor. It is never
+ * instantiated: only the static members of the factory are used.
+ */
+template <class C>
+class PatternsOf : public C
+{
+  public:
+    using typename C::DictionaryEntry;
+    using typename C::PatternFactory;
+    using C::findBestMatch;
+};
+
+/**
+ * Generates dictionary entries biased towards the values the patterns look
+ * for: zeros, ones, small sign-extended values, repeated bytes, halfwords,
+ * and values that only differ from a dictionary entry in their low bytes.
+ */
+template <class C>
+class EntryGenerator
+{
+  public:
+    using DictionaryEntry = typename PatternsOf<C>::DictionaryEntry;
+
+    EntryGenerator() : rng(0x5eed) {}
+
+    DictionaryEntry
+    random()
+    {
+        uint64_t value = rng();
+        switch (rng() % 7) {
+          case 0:
+            value = 0;
+            break;
+          case 1:
+            value = ~0ULL;
+            break;
+          case 2: {
+            // Sign-extended 4, 8 or 16 bits
+            const int shift = 64 - ((rng() % 3) ? 8 * (rng() % 2 + 1) : 4);
+            value = (int64_t)(value << shift) >> shift;
+            break;
+          }
+          case 3:
+            value = (value & 0xFF) * 0x0101010101010101ULL;
+            break;
+          case 4:
+            value = (value & 0xFFFF) << (16 * (rng() % 4));
+            break;
+          default:
+            break;
+        }
+
+        DictionaryEntry entry;
+        for (std::size_t i = 0; i < entry.size(); i++) {
+            entry[i] = value >> (8 * (i % 8));
+        }
+        return entry;
+    }
+
+    /** Replace the k least significant bytes of an entry, k possibly 0. */
+    DictionaryEntry
+    near(DictionaryEntry entry)
+    {
+        const std::size_t num_bytes = rng() % (entry.size() + 1);
+        for (std::size_t i = 0; i < num_bytes; i++) {
+            entry[i] = rng();
+        }
+        return entry;
+    }
+
+    bool coin() { return rng() % 2; }
+    std::size_t below(std::size_t n) { return rng() % n; }
+
+  private:
+    std::mt19937_64 rng;
+};
+
+/**
+ * The size a factory gives without instantiating the pattern must be the
+ * size of the pattern it would instantiate.
+ */
+template <class C>
+void
+checkPatternSizeBits()
+{
+    using Factory = typename PatternsOf<C>::PatternFactory;
+    EntryGenerator<C> gen;
+
+    for (int i = 0; i < 100000; i++) {
+        const auto bytes = gen.random();
+        const auto dict_bytes = gen.coin() ? gen.near(bytes) : gen.random();
+        const int match_location = (int)gen.below(17) - 1;
+
+        EXPECT_EQ(Factory::getPattern(bytes, dict_bytes,
+                      match_location)->getSizeBits(),
+            Factory::getPatternSizeBits(bytes, dict_bytes, match_location));
+    }
+}
+
+/**
+ * Compress random blocks against a dictionary of the previous words, and
+ * compare the patterns chosen by searching with the sizes only to the ones
+ * chosen by instantiating every candidate, as was originally done.
+ */
+template <class C>
+void
+checkCompressedBlocks()
+{
+    using Factory = typename PatternsOf<C>::PatternFactory;
+    using DictionaryEntry = typename PatternsOf<C>::DictionaryEntry;
+    const std::size_t entries_per_block = 64 / sizeof(DictionaryEntry);
+    const std::size_t max_entries = 16;
+    EntryGenerator<C> gen;
+
+    for (int block = 0; block < 2000; block++) {
+        std::vector<DictionaryEntry> dictionary;
+        std::size_t old_size_bits = 0;
+        std::size_t new_size_bits = 0;
+
+        for (std::size_t word = 0; word < entries_per_block; word++) {
+            const DictionaryEntry bytes = (!dictionary.empty() && gen.coin()) ?
+                gen.near(dictionary[gen.below(dictionary.size())]) :
+                gen.random();
+            const DictionaryEntry no_match_bytes{};
+
+            auto old_pattern = Factory::getPattern(bytes, no_match_bytes, -1);
+            for (std::size_t i = 0; i < dictionary.size(); i++) {
+                auto temp_pattern =
+                    Factory::getPattern(bytes, dictionary[i], i);
+                if (temp_pattern->getSizeBits() <
+                    old_pattern->getSizeBits()) {
+                    old_pattern = std::move(temp_pattern);
+                }
+            }
+
+            const int match_location = PatternsOf<C>::findBestMatch(bytes,
+                dictionary, dictionary.size(), &Factory::getPatternSizeBits);
+            const DictionaryEntry& dict_bytes = (match_location < 0) ?
+                no_match_bytes : dictionary[match_location];
+            auto new_pattern =
+                Factory::getPattern(bytes, dict_bytes, match_location);
+
+            EXPECT_EQ(old_pattern->getPatternNumber(),
+                new_pattern->getPatternNumber());
+            EXPECT_EQ(old_pattern->getMatchLocation(),
+                new_pattern->getMatchLocation());
+            EXPECT_EQ(bytes, new_pattern->decompress(dict_bytes));
+            old_size_bits += old_pattern->getSizeBits();
+            new_size_bits += new_pattern->getSizeBits();
+
+            if (old_pattern->shouldAllocate()) {
+                if (dictionary.size() == max_entries) {
+                    dictionary.erase(dictionary.begin());
+                }
+                dictionary.push_back(bytes);
+            }
+        }
+
+        EXPECT_EQ(old_size_bits, new_size_bits);
+    }
+}
+
+TEST(DictionaryCompressorTest, CPackPatternSizeBits)
+{
+    checkPatternSizeBits<CPack>();
+}
+
+TEST(DictionaryCompressorTest, FPCDPatternSizeBits)
+{
+    checkPatternSizeBits<FPCD>();
+}
+
+TEST(DictionaryCompressorTest, FPCPatternSizeBits)
+{
+    checkPatternSizeBits<FPC>();
+}
+
+TEST(DictionaryCompressorTest, BaseDeltaPatternSizeBits)
+{
+    checkPatternSizeBits<Base64Delta8>();
+    checkPatternSizeBits<Base32Delta16>();
+    checkPatternSizeBits<Base16Delta8>();
+}
+
+TEST(DictionaryCompressorTest, RepeatedQwordsPatternSizeBits)
+{
+    checkPatternSizeBits<RepeatedQwords>();
+}
+
+TEST(DictionaryCompressorTest, ZeroPatternSizeBits)
+{
+    checkPatternSizeBits<Zero>();
+}
+
+TEST(DictionaryCompressorTest, CPackCompressedBlocks)
+{
+    checkCompressedBlocks<CPack>();
+}
+
+TEST(DictionaryCompressorTest, FPCDCompressedBlocks)
+{
+    checkCompressedBlocks<FPCD>();
+}
+
+TEST(DictionaryCompressorTest, FPCCompressedBlocks)
+{
+    checkCompressedBlocks<FPC>();
+}
+
+TEST(DictionaryCompressorTest, BaseDeltaCompressedBlocks)
+{
+    checkCompressedBlocks<Base64Delta8>();
+    checkCompressedBlocks<Base32Delta16>();
+    checkCompressedBlocks<Base16Delta8>();
+}
+
+TEST(DictionaryCompressorTest, RepeatedQwordsCompressedBlocks)
+{
+    checkCompressedBlocks<RepeatedQwords>();
+}
+
+TEST(DictionaryCompressorTest, ZeroCompressedBlocks)
+{
+    checkCompressedBlocks<Zero>();
+}
@@ -53,7 +53,7 @@ namespace Compressor {
 
 class FPCD : public DictionaryCompressor<uint32_t>
 {
-  private:
+  protected:
     using DictionaryEntry = DictionaryCompressor<uint32_t>::DictionaryEntry;
 
     /** Number of bits in a FPCD pattern prefix. */
@@ -137,6 +137,15 @@ class FPCD : public DictionaryCompressor<uint32_t>
         return PatternFactory::getPattern(bytes, dict_bytes, match_location);
     }
 
+    std::size_t
+    getPatternSizeBits(const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes,
+        const int match_location) const override
+    {
+        return PatternFactory::getPatternSizeBits(bytes, dict_bytes,
+                                                  match_location);
+    }
+
     void addToDictionary(DictionaryEntry data) override;
 
   public:
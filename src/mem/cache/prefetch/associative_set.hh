@@ -29,6 +29,9 @@
 #ifndef __CACHE_PREFETCH_ASSOCIATIVE_SET_HH__
 #define __CACHE_PREFETCH_ASSOCIATIVE_SET_HH__
 
+#include <vector>
+
+#include "base/types.hh"
 #include "mem/cache/replacement_policies/base.hh"
 #include "mem/cache/tags/indexing_policies/base.hh"
 #include "mem/cache/tags/tagged_entry.hh"
@@ -37,6 +40,10 @@
  * Associative container based on the previosuly defined Entry type
  * Each element is indexed by a key of type Addr, an additional
  * bool value is used as an additional tag data of the entry.
+ *
+ * Lookups in sets laid out contiguously by the indexing policy scan the
+ * entries in place. When the replacement policy is LRU, its state is kept
+ * inline in the container instead of in per-entry replacement data.
  */
 template<class Entry>
 class AssociativeSet {
@@ -57,6 +64,25 @@ class AssociativeSet {
     ReplacementPolicy::Base* const replacementPolicy;
     /** Vector containing the entries of the container */
     std::vector<Entry> entries;
+    /**
+     * Whether the entries are assigned to the sets of the indexing policy
+     * in order, so that sets can be scanned in place
+     */
+    bool flatSets;
+    /**
+     * Whether the replacement policy is exactly LRU, in which case the
+     * entries have no replacement data, and lastTouchTicks is used instead
+     */
+    const bool inlineLRU;
+    /** Last touch tick of every entry, when using the inline LRU */
+    std::vector<Tick> lastTouchTicks;
+
+    /** Position of the given entry in the entries vector */
+    std::size_t
+    index(const Entry *entry) const
+    {
+        return entry - entries.data();
+    }
 
   public:
     /**
@@ -29,15 +29,23 @@
 #ifndef __CACHE_PREFETCH_ASSOCIATIVE_SET_IMPL_HH__
 #define __CACHE_PREFETCH_ASSOCIATIVE_SET_IMPL_HH__
 
+#include <cassert>
+#include <typeinfo>
+
 #include "base/intmath.hh"
 #include "mem/cache/prefetch/associative_set.hh"
+#include "mem/cache/replacement_policies/lru_rp.hh"
+#include "sim/cur_tick.hh"
 
 template<class Entry>
 AssociativeSet<Entry>::AssociativeSet(int assoc, int num_entries,
         BaseIndexingPolicy *idx_policy, ReplacementPolicy::Base *rpl_policy,
         Entry const &init_value)
   : associativity(assoc), numEntries(num_entries), indexingPolicy(idx_policy),
-    replacementPolicy(rpl_policy), entries(numEntries, init_value)
+    replacementPolicy(rpl_policy), entries(numEntries, init_value),
+    flatSets(false),
+    inlineLRU(typeid(*rpl_policy) == typeid(ReplacementPolicy::LRU)),
+    lastTouchTicks(inlineLRU ? numEntries : 0, 0)
 {
     fatal_if(!isPowerOf2(num_entries), "The number of entries of an "
              "AssociativeSet<> must be a power of 2");
@@ -46,8 +54,14 @@ AssociativeSet<Entry>::AssociativeSet(int assoc, int num_entries,
     for (unsigned int entry_idx = 0; entry_idx < numEntries; entry_idx += 1) {
         Entry* entry = &entries[entry_idx];
         indexingPolicy->setEntry(entry, entry_idx);
-        entry->replacementData = replacementPolicy->instantiateEntry();
+        if (!inlineLRU) {
+            entry->replacementData = replacementPolicy->instantiateEntry();
+        }
     }
+    // The indexing policy fills its sets with entries in order, so the
+    // sets are contiguous only if it agrees on the associativity
+    flatSets = (numEntries == associativity) ||
+        (indexingPolicy->getEntry(1, 0) == &entries[associativity]);
 }
 
 template<class Entry>
@@ -55,7 +69,22 @@ Entry*
 AssociativeSet<Entry>::findEntry(Addr addr, bool is_secure) const
 {
     Addr tag = indexingPolicy->extractTag(addr);
-    const std::vector<ReplaceableEntry*> selected_entries =
+
+    uint32_t set;
+    if (flatSets && indexingPolicy->contiguousSet(addr, set)) {
+        // Scan the ways of the set in place
+        const Entry *ways = &entries[set * associativity];
+        for (int way = 0; way < associativity; way++) {
+            const Entry &entry = ways[way];
+            if ((entry.getTag() == tag) && entry.isValid() &&
+                entry.isSecure() == is_secure) {
+                return const_cast<Entry *>(&entry);
+            }
+        }
+        return nullptr;
+    }
+
+    const std::vector<ReplaceableEntry*> &selected_entries =
         indexingPolicy->getPossibleEntries(addr);
 
     for (const auto& location : selected_entries) {
@@ -72,7 +101,11 @@ template<class Entry>
 void
 AssociativeSet<Entry>::accessEntry(Entry *entry)
 {
-    replacementPolicy->touch(entry->replacementData);
+    if (inlineLRU) {
+        lastTouchTicks[index(entry)] = curTick();
+    } else {
+        replacementPolicy->touch(entry->replacementData);
+    }
 }
 
 template<class Entry>
@@ -80,10 +113,25 @@ Entry*
 AssociativeSet<Entry>::findVictim(Addr addr)
 {
     // Get possible entries to be victimized
-    const std::vector<ReplaceableEntry*> selected_entries =
+    const std::vector<ReplaceableEntry*> &selected_entries =
         indexingPolicy->getPossibleEntries(addr);
-    Entry* victim = static_cast<Entry*>(replacementPolicy->getVictim(
+    Entry* victim;
+    if (inlineLRU) {
+        // Same as ReplacementPolicy::LRU::getVictim(): the first of the
+        // least recently touched candidates
+        assert(selected_entries.size() > 0);
+        victim = static_cast<Entry*>(selected_entries[0]);
+        for (const auto& candidate : selected_entries) {
+            Entry* entry = static_cast<Entry*>(candidate);
+            if (lastTouchTicks[index(entry)] <
+                lastTouchTicks[index(victim)]) {
+                victim = entry;
+            }
+        }
+    } else {
+        victim = static_cast<Entry*>(replacementPolicy->getVictim(
                             selected_entries));
+    }
     // There is only one eviction for this replacement
     invalidate(victim);
     return victim;
@@ -94,7 +142,7 @@ template<class Entry>
 std::vector<Entry *>
 AssociativeSet<Entry>::getPossibleEntries(const Addr addr) const
 {
-    std::vector<ReplaceableEntry *> selected_entries =
+    const std::vector<ReplaceableEntry *> &selected_entries =
         indexingPolicy->getPossibleEntries(addr);
     std::vector<Entry *> entries(selected_entries.size(), nullptr);
 
@@ -110,7 +158,11 @@ void
 AssociativeSet<Entry>::insertEntry(Addr addr, bool is_secure, Entry* entry)
 {
    entry->insert(indexingPolicy->extractTag(addr), is_secure);
-   replacementPolicy->reset(entry->replacementData);
+   if (inlineLRU) {
+       lastTouchTicks[index(entry)] = curTick();
+   } else {
+       replacementPolicy->reset(entry->replacementData);
+   }
 }
 
 template<class Entry>
@@ -118,7 +170,11 @@ void
 AssociativeSet<Entry>::invalidate(Entry* entry)
 {
     entry->invalidate();
-    replacementPolicy->invalidate(entry->replacementData);
+    if (inlineLRU) {
+        lastTouchTicks[index(entry)] = 0;
+    } else {
+        replacementPolicy->invalidate(entry->replacementData);
+    }
 }
 
 #endif//__CACHE_PREFETCH_ASSOCIATIVE_SET_IMPL_HH__
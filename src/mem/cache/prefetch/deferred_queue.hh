@@ -0,0 +1,278 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_CACHE_PREFETCH_DEFERRED_QUEUE_HH__
+#define __MEM_CACHE_PREFETCH_DEFERRED_QUEUE_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/types.hh"
+
+namespace Prefetcher {
+
+/**
+ * Bounded queue of deferred prefetches, ordered by decreasing priority
+ * and, within the same priority, by age. The entries live in a fixed
+ * pool of slots, so that their addresses remain stable while their
+ * translations are in flight, and the order is kept in a ring of slot
+ * indices. The queued block addresses are hashed into chains running
+ * through the slots, so that lookups do not walk the whole queue.
+ *
+ * @tparam Entry Type of the queued entries. It must be copyable, order
+ * its objects by priority with operator>, and have the same pfInfo,
+ * priority and translationRequest members as Queued::DeferredPacket.
+ */
+template <class Entry>
+class DeferredQueue
+{
+  private:
+    /** Index used to denote the end of a hash chain */
+    static constexpr unsigned Invalid = ~0U;
+
+    /** Maximum number of queued entries */
+    const unsigned capacity;
+
+    /** Log2 of the block size, used to hash the block addresses */
+    const unsigned lBlkSize;
+
+    /** Storage of the entries, never reallocated */
+    std::vector<Entry> slots;
+
+    /** Indices of the slots that do not hold a queued entry */
+    std::vector<unsigned> freeSlots;
+
+    /** Ring of slot indices, in queue order starting at head */
+    std::vector<unsigned> ring;
+
+    /** Position in the ring of every slot */
+    std::vector<unsigned> ringIdx;
+
+    /** Position in the ring of the first entry */
+    unsigned head;
+
+    /** Number of queued entries */
+    unsigned count;
+
+    /** First slot of every hash chain */
+    std::vector<unsigned> buckets;
+
+    /** Next slot in the hash chain of every slot */
+    std::vector<unsigned> hashNext;
+
+    /** Ring position of the entry at the given queue position */
+    unsigned
+    ringPos(unsigned pos) const
+    {
+        pos += head;
+        return (pos >= capacity) ? (pos - capacity) : pos;
+    }
+
+    /** Hash chain of the given block address */
+    unsigned
+    bucket(Addr addr) const
+    {
+        return (addr >> lBlkSize) & (buckets.size() - 1);
+    }
+
+    /** Place the given slot at the given queue position */
+    void
+    place(unsigned pos, unsigned slot)
+    {
+        const unsigned ring_pos = ringPos(pos);
+        ring[ring_pos] = slot;
+        ringIdx[slot] = ring_pos;
+    }
+
+  public:
+    /**
+     * @param _capacity maximum number of queued entries
+     * @param l_blk_size log2 of the block size
+     */
+    DeferredQueue(unsigned _capacity, unsigned l_blk_size)
+        : capacity(_capacity), lBlkSize(l_blk_size), ring(capacity),
+          ringIdx(capacity), head(0), count(0),
+          buckets(2ULL << ceilLog2(std::max(capacity, 1U)), Invalid),
+          hashNext(capacity, Invalid)
+    {
+        // The slots must never be reallocated, as in-flight translations
+        // keep pointers to them
+        slots.reserve(capacity);
+        freeSlots.reserve(capacity);
+    }
+
+    unsigned size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == capacity; }
+
+    /** @return the entry at the given queue position */
+    Entry &at(unsigned pos) { return slots[ring[ringPos(pos)]]; }
+    const Entry &at(unsigned pos) const { return slots[ring[ringPos(pos)]]; }
+
+    Entry &front() { return at(0); }
+    const Entry &front() const { return at(0); }
+
+    /**
+     * Finds the first queued entry of the given block.
+     * @param addr block address of the entry
+     * @param is_secure whether the entry targets the secure space
+     * @return its queue position, or size() if there is none
+     */
+    unsigned
+    find(Addr addr, bool is_secure) const
+    {
+        // Duplicates may exist when the queue is not filtered, so the
+        // entry closest to the head is the one to be found
+        unsigned found = count;
+        for (unsigned slot = buckets[bucket(addr)]; slot != Invalid;
+             slot = hashNext[slot]) {
+            const auto &pfi = slots[slot].pfInfo;
+            if (pfi.getAddr() == addr && pfi.isSecure() == is_secure) {
+                found = std::min(found, position(&slots[slot]));
+            }
+        }
+        return found;
+    }
+
+    /**
+     * @param e an entry of this queue
+     * @return the queue position of the entry
+     */
+    unsigned
+    position(const Entry *e) const
+    {
+        assert(e >= slots.data() && e < slots.data() + slots.size());
+        const unsigned ring_pos = ringIdx[e - slots.data()];
+        const unsigned pos = (ring_pos >= head) ? (ring_pos - head) :
+                                                  (ring_pos + capacity - head);
+        assert(pos < count);
+        return pos;
+    }
+
+    /**
+     * Queues a copy of the given entry after all the entries with the
+     * same or higher priority. The queue must not be full.
+     */
+    void
+    insert(const Entry &e)
+    {
+        assert(count < capacity);
+
+        unsigned slot;
+        if (freeSlots.empty()) {
+            slot = slots.size();
+            slots.push_back(e);
+        } else {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+            slots[slot] = e;
+        }
+
+        const unsigned b = bucket(e.pfInfo.getAddr());
+        hashNext[slot] = buckets[b];
+        buckets[b] = slot;
+
+        // Walk from the tail, shifting the entries with a lower priority
+        unsigned pos = count;
+        while (pos > 0 && e > at(pos - 1)) {
+            place(pos, ring[ringPos(pos - 1)]);
+            pos--;
+        }
+        place(pos, slot);
+        count++;
+    }
+
+    /** Removes the entry at the given queue position */
+    void
+    erase(unsigned pos)
+    {
+        assert(pos < count);
+        const unsigned slot = ring[ringPos(pos)];
+
+        // Unlink the slot from its hash chain
+        unsigned *link = &buckets[bucket(slots[slot].pfInfo.getAddr())];
+        while (*link != slot) {
+            assert(*link != Invalid);
+            link = &hashNext[*link];
+        }
+        *link = hashNext[slot];
+        hashNext[slot] = Invalid;
+
+        if (pos == 0) {
+            // Popping the head does not need to shift any entry
+            head = ringPos(1);
+        } else {
+            for (; pos + 1 < count; pos++) {
+                place(pos, ring[ringPos(pos + 1)]);
+            }
+        }
+        count--;
+
+        // Release the translation request held by the slot
+        slots[slot].translationRequest = nullptr;
+        freeSlots.push_back(slot);
+    }
+
+    /**
+     * Moves the entry at the given position, whose priority has been
+     * raised, ahead of all the entries with a lower priority.
+     */
+    void
+    promote(unsigned pos)
+    {
+        assert(pos < count);
+        const unsigned slot = ring[ringPos(pos)];
+        const Entry &e = slots[slot];
+        while (pos > 0 && e > at(pos - 1)) {
+            place(pos, ring[ringPos(pos - 1)]);
+            pos--;
+        }
+        place(pos, slot);
+    }
+
+    /** @return the position of the oldest lowest-priority entry */
+    unsigned
+    victim() const
+    {
+        assert(count > 0);
+        /* Look for oldest in the lowest level of priority */
+        unsigned pos = count - 1;
+        const int32_t priority = at(pos).priority;
+        while (pos > 0 && at(pos - 1).priority == priority) {
+            pos--;
+        }
+        return pos;
+    }
+};
+
+template <class Entry>
+constexpr unsigned DeferredQueue<Entry>::Invalid;
+
+} // namespace Prefetcher
+
+#endif // __MEM_CACHE_PREFETCH_DEFERRED_QUEUE_HH__
@@ -0,0 +1,270 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "mem/cache/prefetch/deferred_queue.hh"
+
+using namespace Prefetcher;
+
+namespace {
+
+/** Stand-in for the deferred packets of the Queued prefetcher. */
+struct FakeEntry
+{
+    struct Info
+    {
+        Addr addr;
+        bool secure;
+
+        Addr getAddr() const { return addr; }
+        bool isSecure() const { return secure; }
+    };
+
+    Info pfInfo;
+    int32_t priority;
+    std::shared_ptr<int> translationRequest;
+    /** Unique identifier of the entry */
+    int id;
+
+    FakeEntry(Addr addr, bool secure, int32_t prio, int _id)
+        : pfInfo{addr, secure}, priority(prio),
+          translationRequest(std::make_shared<int>(_id)), id(_id)
+    {}
+
+    bool operator>(const FakeEntry &that) const
+    {
+        return priority > that.priority;
+    }
+};
+
+const unsigned BlkBits = 6;
+
+/**
+ * Reference queue: a vector kept in queue order. Entries are placed after
+ * every entry of the same or higher priority.
+ */
+struct RefQueue
+{
+    std::vector<FakeEntry> entries;
+
+    void
+    insert(const FakeEntry &e)
+    {
+        auto it = std::find_if(entries.begin(), entries.end(),
+            [&e](const FakeEntry &q) { return q.priority < e.priority; });
+        entries.insert(it, e);
+    }
+
+    unsigned
+    find(Addr addr, bool secure) const
+    {
+        auto it = std::find_if(entries.begin(), entries.end(),
+            [&](const FakeEntry &q) {
+                return q.pfInfo.addr == addr && q.pfInfo.secure == secure;
+            });
+        return it - entries.begin();
+    }
+
+    unsigned
+    victim() const
+    {
+        int32_t lowest = entries[0].priority;
+        for (const auto &q : entries)
+            lowest = std::min(lowest, q.priority);
+        auto it = std::find_if(entries.begin(), entries.end(),
+            [&](const FakeEntry &q) { return q.priority == lowest; });
+        return it - entries.begin();
+    }
+
+    void
+    promote(unsigned pos, int32_t priority)
+    {
+        FakeEntry e = entries[pos];
+        e.priority = priority;
+        entries.erase(entries.begin() + pos);
+        // Ahead of the entries with a lower priority, behind the others
+        unsigned new_pos = pos;
+        while (new_pos > 0 && entries[new_pos - 1].priority < priority)
+            new_pos--;
+        entries.insert(entries.begin() + new_pos, e);
+    }
+};
+
+/** Checks that a queue holds the entries of the reference, in order. */
+void
+checkQueue(const DeferredQueue<FakeEntry> &queue, const RefQueue &ref)
+{
+    ASSERT_EQ(queue.size(), ref.entries.size());
+    for (unsigned pos = 0; pos < queue.size(); pos++) {
+        ASSERT_EQ(queue.at(pos).id, ref.entries[pos].id) << "at " << pos;
+        ASSERT_EQ(queue.position(&queue.at(pos)), pos);
+    }
+}
+
+/**
+ * Applies the same random inserts, promotions, victim evictions and
+ * erasures to a queue and to a reference, as the Queued prefetcher does,
+ * and checks that they agree. Few block addresses are used, so that
+ * duplicates and shared hash chains are common, and the head of the
+ * ring wraps around many times.
+ */
+void
+checkAgainstReference(unsigned capacity, unsigned num_blocks,
+                      std::mt19937 &rng)
+{
+    DeferredQueue<FakeEntry> queue(capacity, BlkBits);
+    RefQueue ref;
+    int next_id = 0;
+
+    // Entries must stay at the same address while they are queued
+    std::vector<const FakeEntry *> addresses;
+
+    auto random_block = [&]() {
+        // Blocks that are a multiple of twice the capacity apart, so
+        // that many of them share a hash chain
+        return (Addr(rng() % num_blocks) * 2 * capacity) << BlkBits;
+    };
+
+    for (int step = 0; step < 100000; step++) {
+        const int action = rng() % 8;
+        if (action < 3) {
+            // Queue a prefetch, evicting a victim if the queue is full
+            if (queue.full()) {
+                const unsigned victim = ref.victim();
+                ASSERT_EQ(queue.victim(), victim);
+                queue.erase(victim);
+                ref.entries.erase(ref.entries.begin() + victim);
+            }
+            const FakeEntry e(random_block(), rng() % 2, rng() % 4,
+                              next_id++);
+            queue.insert(e);
+            ref.insert(e);
+        } else if (action < 5) {
+            // Look up a block and raise the priority of its entry
+            const Addr addr = random_block();
+            const bool secure = rng() % 2;
+            const unsigned pos = queue.find(addr, secure);
+            ASSERT_EQ(pos, ref.find(addr, secure));
+            if (pos < queue.size()) {
+                const int32_t priority = queue.at(pos).priority + 1;
+                const FakeEntry *before = &queue.at(pos);
+                queue.at(pos).priority = priority;
+                queue.promote(pos);
+                ref.promote(pos, priority);
+                ASSERT_EQ(before, &queue.at(queue.position(before)));
+            }
+        } else if (action < 7 && !queue.empty()) {
+            // Issue the head
+            std::weak_ptr<int> request = queue.front().translationRequest;
+            queue.erase(0);
+            ref.entries.erase(ref.entries.begin());
+            ASSERT_TRUE(request.expired());
+        } else if (!queue.empty()) {
+            // Squash an arbitrary entry
+            const unsigned pos = rng() % queue.size();
+            queue.erase(pos);
+            ref.entries.erase(ref.entries.begin() + pos);
+        }
+
+        checkQueue(queue, ref);
+        if (::testing::Test::HasFatalFailure())
+            return;
+    }
+}
+
+} // anonymous namespace
+
+TEST(DeferredQueueTest, PriorityThenAge)
+{
+    DeferredQueue<FakeEntry> queue(8, BlkBits);
+    queue.insert(FakeEntry(0x000, false, 0, 0));
+    queue.insert(FakeEntry(0x040, false, 1, 1));
+    queue.insert(FakeEntry(0x080, false, 0, 2));
+    queue.insert(FakeEntry(0x0c0, false, 1, 3));
+
+    const int expected[] = {1, 3, 0, 2};
+    for (unsigned pos = 0; pos < queue.size(); pos++)
+        EXPECT_EQ(queue.at(pos).id, expected[pos]);
+
+    // The oldest entry of the lowest priority
+    EXPECT_EQ(queue.victim(), 2);
+}
+
+TEST(DeferredQueueTest, FindFirstDuplicate)
+{
+    DeferredQueue<FakeEntry> queue(8, BlkBits);
+    queue.insert(FakeEntry(0x040, false, 0, 0));
+    queue.insert(FakeEntry(0x040, true, 0, 1));
+    queue.insert(FakeEntry(0x040, false, 1, 2));
+
+    EXPECT_EQ(queue.at(queue.find(0x040, false)).id, 2);
+    EXPECT_EQ(queue.at(queue.find(0x040, true)).id, 1);
+    EXPECT_EQ(queue.find(0x080, false), queue.size());
+}
+
+TEST(DeferredQueueTest, SlotsAreStable)
+{
+    DeferredQueue<FakeEntry> queue(4, BlkBits);
+    queue.insert(FakeEntry(0x000, false, 0, 0));
+    const FakeEntry *entry = &queue.front();
+
+    // Entries moving around in the queue stay in their slots
+    queue.insert(FakeEntry(0x040, false, 1, 1));
+    queue.insert(FakeEntry(0x080, false, 2, 2));
+    EXPECT_EQ(&queue.at(2), entry);
+    queue.erase(0);
+    EXPECT_EQ(&queue.at(1), entry);
+    EXPECT_EQ(queue.position(entry), 1);
+}
+
+TEST(DeferredQueueTest, SingleEntry)
+{
+    std::mt19937 rng(1);
+    checkAgainstReference(1, 2, rng);
+}
+
+TEST(DeferredQueueTest, SmallQueue)
+{
+    std::mt19937 rng(2);
+    checkAgainstReference(4, 3, rng);
+}
+
+TEST(DeferredQueueTest, LargeQueue)
+{
+    std::mt19937 rng(3);
+    checkAgainstReference(32, 40, rng);
+}
+
+TEST(DeferredQueueTest, NonPowerOfTwoQueue)
+{
+    std::mt19937 rng(4);
+    checkAgainstReference(13, 7, rng);
+}
@@ -45,12 +45,15 @@
 
 #include "mem/cache/tags/base_set_assoc.hh"
 
+#include <algorithm>
 #include <string>
 
+#include "base/bitfield.hh"
 #include "base/intmath.hh"
 
 BaseSetAssoc::BaseSetAssoc(const Params &p)
-    :BaseTags(p), allocAssoc(p.assoc), blks(p.size / p.block_size),
+    :BaseTags(p), assoc(p.assoc), allocAssoc(p.assoc),
+     blks(p.size / p.block_size), tagKeys(blks.size(), 0),
      sequentialAccess(p.sequential_access),
      replacementPolicy(p.replacement_policy)
 {
@@ -82,10 +85,39 @@ BaseSetAssoc::tagsInit()
     }
 }
 
+CacheBlk*
+BaseSetAssoc::findBlock(Addr addr, bool is_secure) const
+{
+    uint32_t set;
+    if (!indexingPolicy->contiguousSet(addr, set))
+        return BaseTags::findBlock(addr, is_secure);
+
+    const uint64_t key = tagKey(extractTag(addr), is_secure);
+    const uint64_t *keys = &tagKeys[set * assoc];
+
+    // Compare a group of ways at a time into a hit mask. The inner loop has
+    // no early exit, so the compiler turns it into vector compares.
+    const unsigned group_size = 8;
+    for (unsigned base = 0; base < assoc; base += group_size) {
+        const unsigned ways = std::min(group_size, assoc - base);
+        uint32_t hits = 0;
+        for (unsigned way = 0; way < ways; way++)
+            hits |= uint32_t(keys[base + way] == key) << way;
+
+        if (hits)
+            return const_cast<CacheBlk*>(
+                &blks[set * assoc + base + ctz32(hits)]);
+    }
+
+    // Did not find block
+    return nullptr;
+}
+
 void
 BaseSetAssoc::invalidate(CacheBlk *blk)
 {
     BaseTags::invalidate(blk);
+    updateTagKey(blk);
 
     // Decrease the number of tags in use
     stats.tagsInUse--;
@@ -98,6 +130,8 @@ void
 BaseSetAssoc::moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk)
 {
     BaseTags::moveBlock(src_blk, dest_blk);
+    updateTagKey(src_blk);
+    updateTagKey(dest_blk);
 
     // Since the blocks were using different replacement data pointers,
     // we must touch the replacement data of the new entry, and invalidate
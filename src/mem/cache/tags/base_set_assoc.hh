@@ -72,12 +72,42 @@
 class BaseSetAssoc : public BaseTags
 {
   protected:
+    /** The associativity of the cache. */
+    const unsigned assoc;
+
     /** The allocatable associativity of the cache (alloc mask). */
     unsigned allocAssoc;
 
     /** The cache blocks. */
     std::vector<CacheBlk> blks;
 
+    /**
+     * Lookup keys of the blocks, laid out like blks, which combine the tag,
+     * secure and valid bits of a block. Keeping them apart from the blocks
+     * lets a lookup compare all ways of a set with a few vector compares
+     * on contiguous memory rather than chasing every block.
+     */
+    std::vector<uint64_t> tagKeys;
+
+    /**
+     * Get the lookup key of a tag. Tags are at least two bits shorter than
+     * addresses, as blocks are at least four bytes long, and invalid blocks
+     * have a zero key, which matches no tag.
+     */
+    static uint64_t
+    tagKey(Addr tag, bool is_secure)
+    {
+        return (tag << 2) | (is_secure ? 2 : 0) | 1;
+    }
+
+    /** Update the lookup key of a block after its tag or state changed. */
+    void
+    updateTagKey(const CacheBlk *blk)
+    {
+        tagKeys[blk->getSet() * assoc + blk->getWay()] = blk->isValid() ?
+            tagKey(blk->getTag(), blk->isSecure()) : 0;
+    }
+
     /** Whether tags and data are accessed sequentially. */
     const bool sequentialAccess;
 
@@ -111,6 +141,16 @@ class BaseSetAssoc : public BaseTags
      */
     void invalidate(CacheBlk *blk) override;
 
+    /**
+     * Find a block by comparing the lookup keys of all the possible
+     * entries of the address, if they form a set.
+     *
+     * @param addr The address to find.
+     * @param is_secure True if the target memory space is secure.
+     * @return Pointer to the cache block if found.
+     */
+    CacheBlk *findBlock(Addr addr, bool is_secure) const override;
+
     /**
      * Access block and update replacement data. May not succeed, in which case
      * nullptr is returned. This has all the implications of a cache access and
@@ -168,7 +208,7 @@ class BaseSetAssoc : public BaseTags
                          std::vector<CacheBlk*>& evict_blks) override
     {
         // Get possible entries to be victimized
-        const std::vector<ReplaceableEntry*> entries =
+        const std::vector<ReplaceableEntry*> &entries =
             indexingPolicy->getPossibleEntries(addr);
 
         // Choose replacement victim from replacement candidates
@@ -191,6 +231,7 @@ class BaseSetAssoc : public BaseTags
     {
         // Insert block
         BaseTags::insertBlock(pkt, blk);
+        updateTagKey(blk);
 
         // Increment tag counter
         stats.tagsInUse++;
@@ -138,13 +138,28 @@ class BaseIndexingPolicy : public SimObject
     /**
      * Find all possible entries for insertion and replacement of an address.
      * Should be called immediately before ReplacementPolicy's findVictim()
-     * not to break cache resizing.
+     * not to break cache resizing. The returned list is owned by the policy
+     * and is only guaranteed to be valid until the next call.
      *
      * @param addr The addr to a find possible entries for.
      * @return The possible entries.
      */
-    virtual std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr)
-                                                                    const = 0;
+    virtual const std::vector<ReplaceableEntry*>&
+    getPossibleEntries(const Addr addr) const = 0;
+
+    /**
+     * Check whether the possible entries of an address are exactly the ways
+     * of one set, i.e., entries set * assoc to set * assoc + assoc - 1 in
+     * setEntry() order, which lets tag stores search them in one go.
+     *
+     * @param addr The address to find the set of.
+     * @param set The set of the address, if any.
+     * @return True if the possible entries form a single set.
+     */
+    virtual bool contiguousSet(const Addr addr, uint32_t &set) const
+    {
+        return false;
+    }
 
     /**
      * Regenerate an entry's address from its tag and assigned indexing bits.
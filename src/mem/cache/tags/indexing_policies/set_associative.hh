@@ -112,8 +112,15 @@ class SetAssociative : public BaseIndexingPolicy
      * @param addr The addr to a find possible entries for.
      * @return The possible entries.
      */
-    std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
-                                                                     override;
+    const std::vector<ReplaceableEntry*>&
+    getPossibleEntries(const Addr addr) const override;
+
+    bool
+    contiguousSet(const Addr addr, uint32_t &set) const override
+    {
+        set = extractSet(addr);
+        return true;
+    }
 
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
@@ -40,6 +40,8 @@
 
 #include "mem/mem_ctrl.hh"
 
+#include <algorithm>
+
 #include "base/trace.hh"
 #include "debug/DRAM.hh"
 #include "debug/Drain.hh"
@@ -49,6 +51,52 @@
 #include "mem/mem_interface.hh"
 #include "sim/system.hh"
 
+const MemPacketQueue::BankQueue MemPacketQueue::emptyBankQueue;
+
+void
+MemPacketQueue::push_back(MemPacket* pkt)
+{
+    const uint64_t seq = nextSeq++;
+    packets.push_back(pkt);
+    seqs.push_back(seq);
+
+    if (pkt->isDram()) {
+        if (pkt->bankId >= bankQueues.size())
+            bankQueues.resize(pkt->bankId + 1);
+        bankQueues[pkt->bankId].push_back({seq, pkt});
+    }
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::erase(iterator it)
+{
+    MemPacket* pkt = *it;
+    if (pkt->isDram()) {
+        // packets mostly leave their bank in order, so start at the head
+        BankQueue& bank_queue = bankQueues[pkt->bankId];
+        auto entry = bank_queue.begin();
+        while (entry->pkt != pkt) {
+            ++entry;
+            assert(entry != bank_queue.end());
+        }
+        bank_queue.erase(entry);
+    }
+
+    seqs.erase(seqs.begin() + (it - packets.begin()));
+    return packets.erase(it);
+}
+
+MemPacketQueue::iterator
+MemPacketQueue::find(const BankEntry& entry)
+{
+    // the arrival numbers are increasing along the queue
+    auto seq_it = std::lower_bound(seqs.begin(), seqs.end(), entry.seq);
+    assert(seq_it != seqs.end() && *seq_it == entry.seq);
+    auto it = packets.begin() + (seq_it - seqs.begin());
+    assert(*it == entry.pkt);
+    return it;
+}
+
 MemCtrl::MemCtrl(const MemCtrlParams &p) :
     QoS::MemCtrl(p),
     port(name() + ".port", *this), isTimingMode(false),
@@ -425,6 +473,10 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
     panic_if(!(pkt->isRead() || pkt->isWrite()),
              "Should only see read and writes at memory controller\n");
 
+    // ranks left idle must be up to date before anything is queued
+    if (dram)
+        dram->catchUpRanks();
+
     // Calc avg gap between requests
     if (prevArrival != 0) {
         stats.totGap += curTick() - prevArrival;
@@ -806,6 +858,25 @@ MemCtrl::inWriteBusState(bool next_state) const
     }
 }
 
+bool
+MemCtrl::idleForLazyRefresh() const
+{
+    // without a turnaround policy and with nothing queued, a restart
+    // stays in the read state and returns straight away
+    return !totalReadQueueSize && !totalWriteQueueSize && respQueue.empty() &&
+        !nextReqEvent.scheduled() && !respondEvent.scheduled() &&
+        !turnPolicy && !nvm && (busState == MemCtrl::READ) &&
+        (busStateNext == MemCtrl::READ) &&
+        (drainState() == DrainState::Running);
+}
+
+void
+MemCtrl::replayIdleRestarts(uint64_t count)
+{
+    // all an idle restart leaves behind is the bus state stat
+    QoS::MemCtrl::stats.numStayReadState += count;
+}
+
 void
 MemCtrl::doBurstAccess(MemPacket* mem_pkt)
 {
@@ -1406,6 +1477,9 @@ MemCtrl::allIntfDrained() const
 DrainState
 MemCtrl::drain()
 {
+    if (dram)
+        dram->catchUpRanks();
+
     // if there is anything in any of our internal queues, keep track
     // of that as well
     if (!(!totalWriteQueueSize && !totalReadQueueSize && respQueue.empty() &&
@@ -1449,6 +1523,17 @@ MemCtrl::drainResume()
     isTimingMode = system()->isTimingMode();
 }
 
+void
+MemCtrl::resetStats()
+{
+    // the ranks may still owe stats to this controller, which is reset
+    // before its DRAM interface
+    if (dram)
+        dram->catchUpRanks();
+
+    QoS::MemCtrl::resetStats();
+}
+
 MemCtrl::MemoryPort::MemoryPort(const std::string& name, MemCtrl& _ctrl)
     : QueuedResponsePort(name, &_ctrl, queue), queue(_ctrl, *this, true),
       ctrl(_ctrl)
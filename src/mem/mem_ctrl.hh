@@ -207,7 +207,85 @@ class MemPacket
 
 // The memory packets are store in a multiple dequeue structure,
 // based on their QoS priority
-typedef std::deque<MemPacket*> MemPacketQueue;
+
+/**
+ * A queue of memory packets in arrival order, which behaves like the
+ * std::deque it wraps. The queue also keeps the DRAM packets of every
+ * bank in their own sub-queue, so that the FR-FCFS scheduler and the
+ * adaptive page policies only need to look at the banks, rather than
+ * at every queued packet.
+ */
+class MemPacketQueue
+{
+  public:
+    typedef std::deque<MemPacket*>::iterator iterator;
+    typedef std::deque<MemPacket*>::const_iterator const_iterator;
+
+    /** A queued DRAM packet and its arrival number in the queue. */
+    struct BankEntry
+    {
+        uint64_t seq;
+        MemPacket* pkt;
+    };
+
+    typedef std::deque<BankEntry> BankQueue;
+
+  private:
+    /** The queued packets, in arrival order */
+    std::deque<MemPacket*> packets;
+
+    /** Arrival number of every queued packet, increasing */
+    std::deque<uint64_t> seqs;
+
+    /** Arrival number of the next packet */
+    uint64_t nextSeq = 0;
+
+    /** Queued DRAM packets of every bank, indexed by bank id */
+    std::vector<BankQueue> bankQueues;
+
+    /** Sub-queue of the banks that have no packets queued */
+    static const BankQueue emptyBankQueue;
+
+  public:
+    iterator begin() { return packets.begin(); }
+    iterator end() { return packets.end(); }
+    const_iterator begin() const { return packets.begin(); }
+    const_iterator end() const { return packets.end(); }
+
+    bool empty() const { return packets.empty(); }
+    size_t size() const { return packets.size(); }
+
+    /** Append a packet to the queue. */
+    void push_back(MemPacket* pkt);
+
+    /**
+     * Remove a packet from the queue.
+     *
+     * @param it Iterator to the packet
+     * @return Iterator to the following packet
+     */
+    iterator erase(iterator it);
+
+    /**
+     * Get the queued DRAM packets of a bank, in arrival order.
+     *
+     * @param bank_id Bank id, see MemPacket::bankId
+     */
+    const BankQueue&
+    bankQueue(uint16_t bank_id) const
+    {
+        return bank_id < bankQueues.size() ? bankQueues[bank_id] :
+                                             emptyBankQueue;
+    }
+
+    /**
+     * Find the queue position of a DRAM packet of a bank sub-queue.
+     *
+     * @param entry Bank sub-queue entry of the packet
+     * @return Iterator to the packet
+     */
+    iterator find(const BankEntry& entry);
+};
 
 
 /**
@@ -677,6 +755,23 @@ class MemCtrl : public QoS::MemCtrl
      */
     void restartScheduler(Tick tick) { schedule(nextReqEvent, tick); }
 
+    /**
+     * Check if the controller is idle in a way that a DRAM refresh
+     * completing would only restart the scheduler for it to find
+     * nothing to do, which lets ranks perform refreshes lazily.
+     *
+     * @return true if refreshes can be deferred
+     */
+    bool idleForLazyRefresh() const;
+
+    /**
+     * Account for the scheduler restarts that refreshes performed
+     * lazily would have triggered on an idle controller.
+     *
+     * @param count Number of restarts
+     */
+    void replayIdleRestarts(uint64_t count);
+
     /**
      * Check the current direction of the memory channel
      *
@@ -700,6 +795,8 @@ class MemCtrl : public QoS::MemCtrl
     virtual void startup() override;
     virtual void drainResume() override;
 
+    void resetStats() override;
+
   protected:
 
     Tick recvAtomic(PacketPtr pkt);
@@ -167,6 +167,117 @@ MemInterface::decodePacket(const PacketPtr pkt, Addr pkt_addr,
 
 std::pair<MemPacketQueue::iterator, Tick>
 DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
+{
+    // The scan of the queue in chooseNextFRFCFSScan selects, in order of
+    // preference:
+    // 1) the oldest row hit that can issue seamlessly
+    // 2) the oldest row hit, or the oldest packet to a bank amongst the
+    //    earliest ones to be prepped when that is hidden, or when there
+    //    is no row hit
+    // All the packets of a bank share its readiness and timing, so only
+    // the oldest row hit and the oldest row miss of every bank can be
+    // selected, and there is no need to look at the rest of the queue.
+    const MemPacketQueue::BankEntry* seamless_hit = nullptr;
+    const MemPacketQueue::BankEntry* prepped_hit = nullptr;
+    const MemPacketQueue::BankEntry* earliest_miss = nullptr;
+    std::vector<const MemPacketQueue::BankEntry*> bank_misses(
+        ranksPerChannel * banksPerRank, nullptr);
+    bool found_miss = false;
+
+    auto older = [](const MemPacketQueue::BankEntry* a,
+                    const MemPacketQueue::BankEntry* b) {
+        return !b || a->seq < b->seq;
+    };
+
+    for (uint16_t bank_id = 0; bank_id < bank_misses.size(); ++bank_id) {
+        const auto& bank_queue = queue.bankQueue(bank_id);
+        if (bank_queue.empty() || !burstReady(bank_queue.front().pkt))
+            continue;
+
+        const MemPacket* first_pkt = bank_queue.front().pkt;
+        const Bank& bank = ranks[first_pkt->rank]->banks[first_pkt->bank];
+
+        // find the oldest row hit and the oldest row miss of the bank
+        const MemPacketQueue::BankEntry* hit = nullptr;
+        for (const auto& entry : bank_queue) {
+            if (entry.pkt->row == bank.openRow) {
+                if (!hit)
+                    hit = &entry;
+            } else if (!bank_misses[bank_id]) {
+                bank_misses[bank_id] = &entry;
+            }
+            if (hit && bank_misses[bank_id])
+                break;
+        }
+
+        if (hit) {
+            const Tick col_allowed_at = hit->pkt->isRead() ?
+                bank.rdAllowedAt : bank.wrAllowedAt;
+            if (col_allowed_at <= min_col_at) {
+                if (older(hit, seamless_hit))
+                    seamless_hit = hit;
+            } else if (older(hit, prepped_hit)) {
+                prepped_hit = hit;
+            }
+        }
+        found_miss |= bank_misses[bank_id] != nullptr;
+    }
+
+    const MemPacketQueue::BankEntry* selected = seamless_hit;
+    if (!selected) {
+        bool hidden_bank_prep = false;
+        if (found_miss) {
+            std::vector<uint32_t> earliest_banks;
+            std::tie(earliest_banks, hidden_bank_prep) =
+                minBankPrep(queue, min_col_at);
+
+            for (const auto* miss : bank_misses) {
+                if (miss && bits(earliest_banks[miss->pkt->rank],
+                                 miss->pkt->bank, miss->pkt->bank) &&
+                    older(miss, earliest_miss)) {
+                    earliest_miss = miss;
+                }
+            }
+        }
+
+        // give priority to packets that can issue bank commands 'behind
+        // the scenes', and otherwise to row hits
+        if (earliest_miss && (hidden_bank_prep || !prepped_hit))
+            selected = earliest_miss;
+        else
+            selected = prepped_hit;
+    }
+
+    auto selected_pkt_it = queue.end();
+    Tick selected_col_at = MaxTick;
+    if (selected) {
+        const Bank& bank = ranks[selected->pkt->rank]->banks[
+            selected->pkt->bank];
+        selected_pkt_it = queue.find(*selected);
+        selected_col_at = selected->pkt->isRead() ? bank.rdAllowedAt :
+                                                    bank.wrAllowedAt;
+        DPRINTF(DRAM, "%s selected packet in bank %d, row %d\n",
+                __func__, selected->pkt->bank, selected->pkt->row);
+    } else {
+        DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+    }
+
+    if (verifyFRFCFS) {
+        auto expected = chooseNextFRFCFSScan(queue, min_col_at);
+        panic_if(expected.first != selected_pkt_it ||
+                 expected.second != selected_col_at,
+                 "FR-FCFS selected packet %d at %d instead of packet %d "
+                 "at %d\n", selected_pkt_it - queue.begin(),
+                 selected_col_at, expected.first - queue.begin(),
+                 expected.second);
+    }
+
+    return std::make_pair(selected_pkt_it, selected_col_at);
+}
+
+std::pair<MemPacketQueue::iterator, Tick>
+DRAMInterface::chooseNextFRFCFSScan(MemPacketQueue& queue,
+                                    Tick min_col_at) const
 {
     std::vector<uint32_t> earliest_banks(ranksPerChannel, 0);
 
@@ -612,23 +723,21 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
         bool got_bank_conflict = false;
 
         for (uint8_t i = 0; i < ctrl->numPriorities(); ++i) {
-            auto p = queue[i].begin();
+            const auto& bank_queue = queue[i].bankQueue(mem_pkt->bankId);
+            auto p = bank_queue.begin();
             // keep on looking until we find a hit or reach the end of the
-            // queue
+            // packets to the same bank
             // 1) if a hit is found, then both open and close adaptive
             //    policies keep the page open
             // 2) if no hit is found, got_bank_conflict is set to true if a
             //    bank conflict request is waiting in the queue
             // 3) make sure we are not considering the packet that we are
             //    currently dealing with
-            while (!got_more_hits && p != queue[i].end()) {
-                if (mem_pkt != (*p)) {
-                    bool same_rank_bank = (mem_pkt->rank == (*p)->rank) &&
-                                          (mem_pkt->bank == (*p)->bank);
-
-                    bool same_row = mem_pkt->row == (*p)->row;
-                    got_more_hits |= same_rank_bank && same_row;
-                    got_bank_conflict |= same_rank_bank && !same_row;
+            while (!got_more_hits && p != bank_queue.end()) {
+                if (mem_pkt != p->pkt) {
+                    bool same_row = mem_pkt->row == p->pkt->row;
+                    got_more_hits |= same_row;
+                    got_bank_conflict |= !same_row;
                 }
                 ++p;
             }
@@ -750,6 +859,7 @@ DRAMInterface::DRAMInterface(const DRAMInterfaceParams &_p)
       rdToWrDlySameBG(_p.tRTW + _p.tBURST_MAX),
       pageMgmt(_p.page_policy),
       maxAccessesPerRow(_p.max_accesses_per_row),
+      verifyFRFCFS(_p.verify_frfcfs), lazyRefresh(_p.lazy_refresh),
       timeStampOffset(0), activeRank(0),
       enableDRAMPowerdown(_p.enable_dram_powerdown),
       lastStatsResetTick(0),
@@ -1033,6 +1143,21 @@ DRAMInterface::suspend()
     }
 }
 
+void
+DRAMInterface::catchUpRanks()
+{
+    // Every refresh completion restarts the scheduler, also when ranks
+    // complete in the same tick: the restart is inserted ahead of the
+    // power event of the next rank, and has run and found nothing to do
+    // by the time that rank checks requestEventScheduled()
+    uint64_t restarts = 0;
+    for (auto r : ranks) {
+        restarts += r->catchUp();
+    }
+
+    ctrl->replayIdleRestarts(restarts);
+}
+
 std::pair<std::vector<uint32_t>, bool>
 DRAMInterface::minBankPrep(const MemPacketQueue& queue,
                       Tick min_col_at) const
@@ -1054,9 +1179,9 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
     // determine if we have queued transactions targetting the
     // bank in question
     std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
-        if (p->isDram() && ranks[p->rank]->inRefIdleState())
-            got_waiting[p->bankId] = true;
+    for (uint16_t bank_id = 0; bank_id < got_waiting.size(); ++bank_id) {
+        got_waiting[bank_id] = !queue.bankQueue(bank_id).empty() &&
+            ranks[bank_id / banksPerRank]->inRefIdleState();
     }
 
     // Find command with optimal bank timing
@@ -1122,7 +1247,8 @@ DRAMInterface::Rank::Rank(const DRAMInterfaceParams &_p,
                          int _rank, DRAMInterface& _dram)
     : EventManager(&_dram), dram(_dram),
       pwrStateTrans(PWR_IDLE), pwrStatePostRefresh(PWR_IDLE),
-      pwrStateTick(0), refreshDueAt(0), pwrState(PWR_IDLE),
+      pwrStateTick(0), refreshDueAt(0), parked(false), parkedRefreshAt(0),
+      pwrState(PWR_IDLE),
       refreshState(REF_IDLE), inLowPowerState(false), rank(_rank),
       readEntries(0), writeEntries(0), outstandingEvents(0),
       wakeUpAllowedAt(0), power(_p, false), banks(_p.banks_per_rank),
@@ -1171,10 +1297,12 @@ DRAMInterface::Rank::startup(Tick ref_tick)
 void
 DRAMInterface::Rank::suspend()
 {
+    dram.catchUpRanks();
+
     deschedule(refreshEvent);
 
     // Update the stats
-    updatePowerStats();
+    updatePowerStats(curTick());
 
     // don't automatically transition back to LP state after next REF
     pwrStatePostRefresh = PWR_IDLE;
@@ -1207,7 +1335,7 @@ DRAMInterface::Rank::checkDrainDone()
 }
 
 void
-DRAMInterface::Rank::flushCmdList()
+DRAMInterface::Rank::flushCmdList(Tick now)
 {
     // at the moment sort the list of commands and update the counters
     // for DRAMPower libray when doing a refresh
@@ -1217,19 +1345,19 @@ DRAMInterface::Rank::flushCmdList()
     // push to commands to DRAMPower
     for ( ; next_iter != cmdList.end() ; ++next_iter) {
          Command cmd = *next_iter;
-         if (cmd.timeStamp <= curTick()) {
-             // Move all commands at or before curTick to DRAMPower
+         if (cmd.timeStamp <= now) {
+             // Move all commands at or before now to DRAMPower
              power.powerlib.doCommand(cmd.type, cmd.bank,
                                       divCeil(cmd.timeStamp, dram.tCK) -
                                       dram.timeStampOffset);
          } else {
-             // done - found all commands at or before curTick()
-             // next_iter references the 1st command after curTick
+             // done - found all commands at or before now
+             // next_iter references the 1st command after now
              break;
          }
     }
-    // reset cmdList to only contain commands after curTick
-    // if there are no commands after curTick, updated cmdList will be empty
+    // reset cmdList to only contain commands after now
+    // if there are no commands after now, updated cmdList will be empty
     // in this case, next_iter is cmdList.end()
     cmdList.assign(next_iter, cmdList.end());
 }
@@ -1289,6 +1417,16 @@ DRAMInterface::Rank::processWriteDoneEvent()
 void
 DRAMInterface::Rank::processRefreshEvent()
 {
+    // if nothing else will happen to the rank until the controller sees
+    // another request, leave the refreshes to catchUp()
+    if ((refreshState == REF_IDLE) && canPark()) {
+        DPRINTF(DRAMState, "Rank %d parked with refresh due at %llu\n",
+                rank, curTick());
+        parked = true;
+        parkedRefreshAt = curTick();
+        return;
+    }
+
     // when first preparing the refresh, remember when it was due
     if ((refreshState == REF_IDLE) || (refreshState == REF_SREF_EXIT)) {
         // remember when the refresh is due
@@ -1418,7 +1556,7 @@ DRAMInterface::Rank::processRefreshEvent()
         cmdList.push_back(Command(MemCommand::REF, 0, curTick()));
 
         // Update the stats
-        updatePowerStats();
+        updatePowerStats(curTick());
 
         DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(curTick(), dram.tCK) -
                 dram.timeStampOffset, rank);
@@ -1492,6 +1630,84 @@ DRAMInterface::Rank::processRefreshEvent()
     }
 }
 
+bool
+DRAMInterface::Rank::canPark() const
+{
+    // with power-down enabled an idle rank sits in self-refresh without
+    // any events, so only the auto-refresh of an idle rank is deferred
+    return dram.lazyRefresh && !dram.enableDRAMPowerdown &&
+        (pwrState == PWR_IDLE) && (pwrStatePostRefresh == PWR_IDLE) &&
+        !inLowPowerState && (outstandingEvents == 0) &&
+        (numBanksActive == 0) && (readEntries == 0) && (writeEntries == 0) &&
+        !writeDoneEvent.scheduled() && !activateEvent.scheduled() &&
+        !prechargeEvent.scheduled() && !powerEvent.scheduled() &&
+        !wakeUpEvent.scheduled() && dram.ctrl->idleForLazyRefresh();
+}
+
+uint64_t
+DRAMInterface::Rank::catchUp()
+{
+    if (!parked)
+        return 0;
+
+    parked = false;
+
+    // Perform the refreshes due before now the way processRefreshEvent
+    // and processPowerEvent do for an idle rank, each one restarting
+    // the controller scheduler once done. Anything due from now on is
+    // left to the event loop.
+    uint64_t restarts = 0;
+    Tick ref_at = parkedRefreshAt;
+    bool refreshing = false;
+
+    while (!refreshing && (ref_at < curTick())) {
+        stats.pwrStateTime[PWR_IDLE] += ref_at - pwrStateTick;
+        pwrState = PWR_REF;
+        pwrStateTick = ref_at;
+
+        Tick ref_done_at = ref_at + dram.tRFC;
+
+        for (auto &b : banks) {
+            b.actAllowedAt = ref_done_at;
+        }
+
+        cmdList.push_back(Command(MemCommand::REF, 0, ref_at));
+
+        updatePowerStats(ref_at);
+
+        refreshDueAt = ref_at + dram.tREFI;
+
+        if (refreshDueAt < ref_done_at) {
+            fatal("Refresh was delayed so long we cannot catch up\n");
+        }
+
+        if (ref_done_at >= curTick()) {
+            // still refreshing, as if the refresh event had just run in
+            // the REF_START state
+            ++outstandingEvents;
+            refreshState = REF_RUN;
+            schedule(refreshEvent, ref_done_at);
+            refreshing = true;
+        } else {
+            stats.pwrStateTime[PWR_REF] += dram.tRFC;
+            pwrState = PWR_IDLE;
+            pwrStateTick = ref_done_at;
+            ++restarts;
+
+            ref_at = refreshDueAt - dram.tRP;
+        }
+    }
+
+    if (!refreshing) {
+        schedule(refreshEvent, ref_at);
+    }
+
+    DPRINTF(DRAMState, "Rank %d caught up with %llu refreshes\n", rank,
+            restarts + (refreshing ? 1 : 0));
+
+    return restarts;
+}
+
 void
 DRAMInterface::Rank::schedulePowerEvent(PowerState pwr_state, Tick tick)
 {
@@ -1768,17 +1984,17 @@ DRAMInterface::Rank::processPowerEvent()
 }
 
 void
-DRAMInterface::Rank::updatePowerStats()
+DRAMInterface::Rank::updatePowerStats(Tick now)
 {
     // All commands up to refresh have completed
     // flush cmdList to DRAMPower
-    flushCmdList();
+    flushCmdList(now);
 
     // Call the function that calculates window energy at intermediate update
     // events like at refresh, stats dump as well as at simulation exit.
     // Window starts at the last time the calcWindowEnergy function was called
     // and is upto current time.
-    power.powerlib.calcWindowEnergy(divCeil(curTick(), dram.tCK) -
+    power.powerlib.calcWindowEnergy(divCeil(now, dram.tCK) -
                                     dram.timeStampOffset);
 
     // Get the energy from DRAMPower
@@ -1806,7 +2022,7 @@ DRAMInterface::Rank::updatePowerStats()
     // power (mW) = ----------- * ----------
     //              time (tick)   tick_frequency
     stats.averagePower = (stats.totalEnergy.value() /
-                    (curTick() - dram.lastStatsResetTick)) *
+                    (now - dram.lastStatsResetTick)) *
                     (SimClock::Frequency / 1000000000.0);
 }
 
@@ -1815,8 +2031,11 @@ DRAMInterface::Rank::computeStats()
 {
     DPRINTF(DRAM,"Computing stats due to a dump callback\n");
 
+    // Account for any refreshes done while parked
+    dram.catchUpRanks();
+
     // Update the stats
-    updatePowerStats();
+    updatePowerStats(curTick());
 
     // final update of power state times
     stats.pwrStateTime[pwrState] += (curTick() - pwrStateTick);
@@ -1825,6 +2044,8 @@ DRAMInterface::Rank::computeStats()
 
 void
 DRAMInterface::Rank::resetStats() {
+    dram.catchUpRanks();
+
     // The only way to clear the counters in DRAMPower is to call
     // calcWindowEnergy function as that then calls clearCounters. The
     // clearCounters method itself is private.
@@ -1842,6 +2063,9 @@ DRAMInterface::Rank::forceSelfRefreshExit() const {
 void
 DRAMInterface::DRAMStats::resetStats()
 {
+    // parked ranks still use the old reset tick for their average power
+    dram.catchUpRanks();
+
     dram.lastStatsResetTick = curTick();
 }
 
@@ -492,10 +492,30 @@ class DRAMInterface : public MemInterface
          */
         Tick refreshDueAt;
 
+        /**
+         * Set while the rank is idle and its refreshes are computed
+         * lazily rather than through refreshEvent and powerEvent, in
+         * which case the next refresh is due to start at
+         * parkedRefreshAt.
+         */
+        bool parked;
+        Tick parkedRefreshAt;
+
         /**
          * Function to update Power Stats
+         *
+         * @param now Tick up to which the energy window is computed
+         */
+        void updatePowerStats(Tick now);
+
+        /**
+         * Check if the refresh about to start can be left to catchUp(),
+         * i.e. nothing but refresh will happen to the rank until the
+         * controller sees another request.
+         *
+         * @return true if the rank can be parked
          */
-        void updatePowerStats();
+        bool canPark() const;
 
         /**
          * Schedule a power state transition in the future, and
@@ -646,11 +666,25 @@ class DRAMInterface : public MemInterface
 
         /**
          * Push command out of cmdList queue that are scheduled at
-         * or before curTick() to DRAMPower library
-         * All commands before curTick are guaranteed to be complete
+         * or before now to DRAMPower library
+         * All commands before now are guaranteed to be complete
          * and can safely be flushed.
+         *
+         * @param now Tick up to which commands are flushed
+         */
+        void flushCmdList(Tick now);
+
+        /**
+         * Bring a parked rank up to date, performing the refreshes the
+         * eager model would have done before curTick() and putting the
+         * refresh state machine back on the event queue. Only called
+         * through DRAMInterface::catchUpRanks(), which replays the
+         * scheduler restarts of all ranks at once.
+         *
+         * @return number of completed refreshes, each of which would
+         *         have restarted the controller scheduler
          */
-        void flushCmdList();
+        uint64_t catchUp();
 
         /**
          * Computes stats just prior to dump event
@@ -758,6 +792,18 @@ class DRAMInterface : public MemInterface
      */
     const uint32_t maxAccessesPerRow;
 
+    /**
+     * Check every FR-FCFS decision made using the per-bank sub-queues
+     * against a scan of the whole queue.
+     */
+    const bool verifyFRFCFS;
+
+    /**
+     * Let ranks left idle compute their refreshes on the next request
+     * or stats event rather than through events.
+     */
+    const bool lazyRefresh;
+
     // timestamp offset
     uint64_t timeStampOffset;
 
@@ -872,6 +918,19 @@ class DRAMInterface : public MemInterface
     std::pair<std::vector<uint32_t>, bool>
     minBankPrep(const MemPacketQueue& queue, Tick min_col_at) const;
 
+    /**
+     * Reference implementation of chooseNextFRFCFS, scanning all the
+     * packets of the queue in order. Only used to verify the decisions
+     * made using the per-bank sub-queues.
+     *
+     * @param queue Queued requests to consider
+     * @param min_col_at Minimum tick for 'seamless' issue
+     * @return an iterator to the selected packet, else queue.end()
+     * @return the tick when the packet selected will issue
+     */
+    std::pair<MemPacketQueue::iterator, Tick>
+    chooseNextFRFCFSScan(MemPacketQueue& queue, Tick min_col_at) const;
+
     /*
      * @return time to send a burst of data without gaps
      */
@@ -921,6 +980,14 @@ class DRAMInterface : public MemInterface
      */
     void suspend();
 
+    /**
+     * Iterate through DRAM ranks and bring any parked rank up to date,
+     * replaying the scheduler restarts of their completed refreshes.
+     * Ranks are always caught up together so that the controller is
+     * never seen with only part of its restarts accounted for.
+     */
+    void catchUpRanks();
+
     /*
      * @return time to offset next command
      */
@@ -57,6 +57,7 @@
 #include "base/flags.hh"
 #include "base/logging.hh"
 #include "base/printable.hh"
+#include "base/recycling_pool.hh"
 #include "base/types.hh"
 #include "mem/htm.hh"
 #include "mem/request.hh"
@@ -327,6 +328,8 @@ class Packet : public Printable
         /// the packet is destroyed. The pointer is assumed to be pointing
         /// to an array, and delete [] is consequently called
         DYNAMIC_DATA           = 0x00002000,
+        /// The data pointer points to the packet's own small buffer.
+        INLINE_DATA            = 0x00004000,
 
         /// suppress the error if this packet encounters a functional
         /// access failure.
@@ -360,6 +363,12 @@ class Packet : public Printable
     */
     PacketDataPtr data;
 
+    /**
+     * Storage for payloads of up to a cache line, which spares most
+     * packets allocating their data on the heap.
+     */
+    alignas(16) uint8_t inlineData[64];
+
     /// The address of the request.  This address could be virtual or
     /// physical, depending on the system configuration.
     Addr addr;
@@ -1007,6 +1016,27 @@ class Packet : public Printable
         deleteData();
     }
 
+    /**
+     * Packets are recycled through a per-thread pool rather than
+     * allocated from the heap every time.
+     */
+    static void *
+    operator new(size_t size)
+    {
+        if (size != sizeof(Packet))
+            return ::operator new(size);
+        return RecyclingPool<sizeof(Packet)>::allocate();
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        if (size != sizeof(Packet))
+            ::operator delete(p);
+        else
+            RecyclingPool<sizeof(Packet)>::release(p);
+    }
+
     /**
      * Take a request packet and modify it in place to be suitable for
      * returning as a response to that request.
@@ -1117,7 +1147,7 @@ class Packet : public Printable
     void
     dataStatic(T *p)
     {
-        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|INLINE_DATA));
         data = (PacketDataPtr)p;
         flags.set(STATIC_DATA);
     }
@@ -1134,7 +1164,7 @@ class Packet : public Printable
     void
     dataStaticConst(const T *p)
     {
-        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|INLINE_DATA));
         data = const_cast<PacketDataPtr>(p);
         flags.set(STATIC_DATA);
     }
@@ -1155,7 +1185,7 @@ class Packet : public Printable
     void
     dataDynamic(T *p)
     {
-        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|INLINE_DATA));
         data = (PacketDataPtr)p;
         flags.set(DYNAMIC_DATA);
     }
@@ -1167,7 +1197,7 @@ class Packet : public Printable
     T*
     getPtr()
     {
-        assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA|INLINE_DATA));
         assert(!isMaskedWrite());
         return (T*)data;
     }
@@ -1176,7 +1206,7 @@ class Packet : public Printable
     const T*
     getConstPtr() const
     {
-        assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(flags.isSet(STATIC_DATA|DYNAMIC_DATA|INLINE_DATA));
         return (const T*)data;
     }
 
@@ -1301,7 +1331,7 @@ class Packet : public Printable
         if (flags.isSet(DYNAMIC_DATA))
             delete [] data;
 
-        flags.clear(STATIC_DATA|DYNAMIC_DATA);
+        flags.clear(STATIC_DATA|DYNAMIC_DATA|INLINE_DATA);
         data = NULL;
     }
 
@@ -1312,9 +1342,14 @@ class Packet : public Printable
         // if either this command or the response command has a data
         // payload, actually allocate space
         if (hasData() || hasRespData()) {
-            assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
-            flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA|INLINE_DATA));
+            if (getSize() <= sizeof(inlineData)) {
+                flags.set(INLINE_DATA);
+                data = inlineData;
+            } else {
+                flags.set(DYNAMIC_DATA);
+                data = new uint8_t[getSize()];
+            }
         }
     }
 
@@ -0,0 +1,85 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/packet.hh"
+#include "mem/packet_access.hh"
+#include "mem/request.hh"
+
+// Instantiate the fake class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+/** Payloads up to a cache line are stored inline and accessed as usual. */
+TEST(PacketTest, InlineDataSetGet)
+{
+    RequestPtr req = Request::create(0x1000, sizeof(uint64_t), 0, 0);
+    Packet pkt(req, MemCmd::WriteReq);
+    pkt.allocate();
+
+    pkt.setRaw<uint64_t>(0x0123456789abcdefULL);
+    EXPECT_EQ(0x0123456789abcdefULL, pkt.getRaw<uint64_t>());
+
+    pkt.setLE<uint32_t>(0xdeadbeef);
+    EXPECT_EQ(0xdeadbeef, pkt.getLE<uint32_t>());
+    EXPECT_EQ(0xefbeadde, pkt.getBE<uint32_t>());
+
+    pkt.set<uint16_t>(0x1234, ByteOrder::big);
+    EXPECT_EQ(0x1234, pkt.get<uint16_t>(ByteOrder::big));
+}
+
+/** The largest inline payload behaves the same. */
+TEST(PacketTest, InlineDataCacheLine)
+{
+    RequestPtr req = Request::create(0x1000, 64, 0, 0);
+    Packet pkt(req, MemCmd::ReadReq);
+    pkt.allocate();
+
+    uint8_t line[64];
+    for (int i = 0; i < 64; i++)
+        line[i] = i;
+    pkt.setData(line);
+
+    EXPECT_EQ(0x03020100, pkt.getLE<uint32_t>());
+
+    uint8_t copy[64];
+    pkt.writeData(copy);
+    for (int i = 0; i < 64; i++)
+        EXPECT_EQ(i, copy[i]);
+}
+
+/** Larger payloads are still allocated separately. */
+TEST(PacketTest, DynamicDataSetGet)
+{
+    RequestPtr req = Request::create(0x1000, 128, 0, 0);
+    Packet pkt(req, MemCmd::ReadReq);
+    pkt.allocate();
+
+    pkt.setLE<uint64_t>(0x0123456789abcdefULL);
+    EXPECT_EQ(0x0123456789abcdefULL, pkt.getLE<uint64_t>());
+}
@@ -44,6 +44,7 @@
 void
 EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 {
+    std::lock_guard<std::shared_timed_mutex> lock(pTableLock);
     bool clobber = flags & Clobber;
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
@@ -71,6 +72,7 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 void
 EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
 {
+    std::lock_guard<std::shared_timed_mutex> lock(pTableLock);
     assert(pageOffset(vaddr) == 0);
     assert(pageOffset(new_vaddr) == 0);
 
@@ -93,6 +95,7 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
 void
 EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 {
+    std::shared_lock<std::shared_timed_mutex> lock(pTableLock);
     for (auto &iter : pTable)
         addr_maps->push_back(std::make_pair(iter.first, iter.second.paddr));
 }
@@ -100,6 +103,7 @@ EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 void
 EmulationPageTable::unmap(Addr vaddr, int64_t size)
 {
+    std::lock_guard<std::shared_timed_mutex> lock(pTableLock);
     assert(pageOffset(vaddr) == 0);
 
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
@@ -116,6 +120,7 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
 bool
 EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
 {
+    std::shared_lock<std::shared_timed_mutex> lock(pTableLock);
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
 
@@ -126,25 +131,29 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     return true;
 }
 
-const EmulationPageTable::Entry *
-EmulationPageTable::lookup(Addr vaddr)
+bool
+EmulationPageTable::lookup(Addr vaddr, Entry &entry)
 {
+    // The entry is copied out under the lock, a concurrent update may
+    // invalidate any reference into the table as soon as it is released.
+    std::shared_lock<std::shared_timed_mutex> lock(pTableLock);
     Addr page_addr = pageAlign(vaddr);
     PTableItr iter = pTable.find(page_addr);
     if (iter == pTable.end())
-        return nullptr;
-    return &(iter->second);
+        return false;
+    entry = iter->second;
+    return true;
 }
 
 bool
 EmulationPageTable::translate(Addr vaddr, Addr &paddr)
 {
-    const Entry *entry = lookup(vaddr);
-    if (!entry) {
+    Entry entry;
+    if (!lookup(vaddr, entry)) {
         DPRINTF(MMU, "Couldn't Translate: %#x\n", vaddr);
         return false;
     }
-    paddr = pageOffset(vaddr) + entry->paddr;
+    paddr = pageOffset(vaddr) + entry.paddr;
     DPRINTF(MMU, "Translating: %#x->%#x\n", vaddr, paddr);
     return true;
 }
@@ -35,6 +35,8 @@
 #ifndef __MEM_PAGE_TABLE_HH__
 #define __MEM_PAGE_TABLE_HH__
 
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 
@@ -63,6 +65,14 @@ class EmulationPageTable : public Serializable
     typedef PTable::iterator PTableItr;
     PTable pTable;
 
+    /**
+     * Lookups come from the TLBs of cores which may be simulated by
+     * separate host threads, while updates are made by syscalls and fault
+     * fixups which are serialized by the system. Lookups share the table,
+     * updates own it.
+     */
+    std::shared_timed_mutex pTableLock;
+
     const Addr _pageSize;
     const Addr offsetMask;
 
@@ -132,9 +142,10 @@ class EmulationPageTable : public Serializable
     /**
      * Lookup function
      * @param vaddr The virtual address.
-     * @return The page table entry corresponding to vaddr.
+     * @param entry Copy of the page table entry corresponding to vaddr.
+     * @return True if vaddr is mapped
      */
-    const Entry *lookup(Addr vaddr);
+    bool lookup(Addr vaddr, Entry &entry);
 
     /**
      * Translate function
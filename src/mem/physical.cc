@@ -44,9 +44,14 @@
 #include <unistd.h>
 #include <zlib.h>
 
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <string>
 
@@ -68,16 +73,47 @@
 #endif
 #endif
 
+/**
+ * Binding the backing store to a host NUMA node uses the mbind system
+ * call directly, rather than adding a dependency on libnuma just for
+ * its definitions.
+ */
+#if defined(__linux__)
+#ifndef MPOL_BIND
+#define MPOL_BIND 2
+#endif
+#endif
+
 PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
-                               const std::string& shared_backstore) :
+                               const std::string& shared_backstore,
+                               bool mmap_using_hugetlb,
+                               bool mmap_transparent_huge_pages,
+                               bool mmap_prefault) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
-    sharedBackstore(shared_backstore)
+    mmapUsingHugeTLB(mmap_using_hugetlb),
+    mmapTransparentHugePages(mmap_transparent_huge_pages),
+    mmapPrefault(mmap_prefault), sharedBackstore(shared_backstore)
 {
     if (mmap_using_noreserve)
         warn("Not reserving swap space. May cause SIGSEGV on actual usage\n");
 
+#if !defined(MAP_HUGETLB)
+    fatal_if(mmap_using_hugetlb,
+             "hugetlb backing store is not supported on this host\n");
+#endif
+#if !defined(MADV_HUGEPAGE)
+    fatal_if(mmap_transparent_huge_pages,
+             "Transparent huge pages are not supported on this host\n");
+#endif
+
+    fatal_if(mmap_using_hugetlb && !shared_backstore.empty(),
+             "A shared backing store cannot use hugetlb pages\n");
+
+    if (mmap_prefault && mmap_using_noreserve)
+        warn("Prefaulting the backing store commits all of it\n");
+
     // add the memories from the system to the address map as
     // appropriate
     for (const auto& m : _memories) {
@@ -112,7 +148,7 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
             std::vector<AbstractMemory*> unmapped_mems{m};
             createBackingStore(m->getAddrRange(), unmapped_mems,
                                m->isConfReported(), m->isInAddrMap(),
-                               m->isKvmMap());
+                               m->isKvmMap(), m->getHostNumaNode());
         }
     }
 
@@ -138,13 +174,14 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
                     for (const auto& c : curr_memories)
                         if (f->isConfReported() != c->isConfReported() ||
                             f->isInAddrMap() != c->isInAddrMap() ||
-                            f->isKvmMap() != c->isKvmMap())
+                            f->isKvmMap() != c->isKvmMap() ||
+                            f->getHostNumaNode() != c->getHostNumaNode())
                             fatal("Inconsistent flags in an interleaved "
                                   "range\n");
 
                     createBackingStore(merged_range, curr_memories,
                                        f->isConfReported(), f->isInAddrMap(),
-                                       f->isKvmMap());
+                                       f->isKvmMap(), f->getHostNumaNode());
 
                     intlv_ranges.clear();
                     curr_memories.clear();
@@ -156,7 +193,8 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
                 createBackingStore(r.first, single_memory,
                                    r.second->isConfReported(),
                                    r.second->isInAddrMap(),
-                                   r.second->isKvmMap());
+                                   r.second->isKvmMap(),
+                                   r.second->getHostNumaNode());
             }
         }
     }
@@ -170,20 +208,22 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
         for (const auto& c : curr_memories)
             if (f->isConfReported() != c->isConfReported() ||
                 f->isInAddrMap() != c->isInAddrMap() ||
-                f->isKvmMap() != c->isKvmMap())
+                f->isKvmMap() != c->isKvmMap() ||
+                f->getHostNumaNode() != c->getHostNumaNode())
                 fatal("Inconsistent flags in an interleaved "
                       "range\n");
 
         createBackingStore(merged_range, curr_memories,
                            f->isConfReported(), f->isInAddrMap(),
-                           f->isKvmMap());
+                           f->isKvmMap(), f->getHostNumaNode());
     }
 }
 
 void
 PhysicalMemory::createBackingStore(
         AddrRange range, const std::vector<AbstractMemory*>& _memories,
-        bool conf_table_reported, bool in_addr_map, bool kvm_map)
+        bool conf_table_reported, bool in_addr_map, bool kvm_map,
+        int numa_node)
 {
     panic_if(range.interleaved(),
              "Cannot create backing store for interleaved range %s\n",
@@ -196,6 +236,12 @@ PhysicalMemory::createBackingStore(
     int shm_fd;
     int map_flags;
 
+    for (const auto& m : _memories) {
+        fatal_if(m->isSparse() && !sharedBackstore.empty(),
+                 "Memory %s cannot be sparse with a shared backing store, "
+                 "as other processes may write it\n", m->name());
+    }
+
     if (sharedBackstore.empty()) {
         shm_fd = -1;
         map_flags =  MAP_ANON | MAP_PRIVATE;
@@ -216,6 +262,12 @@ PhysicalMemory::createBackingStore(
         map_flags |= MAP_NORESERVE;
     }
 
+#if defined(MAP_HUGETLB)
+    if (mmapUsingHugeTLB) {
+        map_flags |= MAP_HUGETLB;
+    }
+#endif
+
     uint8_t* pmem = (uint8_t*) mmap(NULL, range.size(),
                                     PROT_READ | PROT_WRITE,
                                     map_flags, shm_fd, 0);
@@ -226,10 +278,56 @@ PhysicalMemory::createBackingStore(
               range.to_string());
     }
 
+#if defined(MADV_HUGEPAGE)
+    if (mmapTransparentHugePages &&
+        madvise(pmem, range.size(), MADV_HUGEPAGE) != 0) {
+        warn("Could not use transparent huge pages for range %s: %s\n",
+             range.to_string(), strerror(errno));
+    }
+#endif
+
+    // the policy only applies to pages faulted in after it is set, so
+    // bind before the backing store is touched
+    if (numa_node >= 0) {
+#if defined(__linux__)
+        const unsigned bits_per_word = sizeof(unsigned long) * CHAR_BIT;
+        std::vector<unsigned long> node_mask(numa_node / bits_per_word + 1);
+        node_mask[numa_node / bits_per_word] |=
+            1UL << (numa_node % bits_per_word);
+
+        DPRINTF(AddrRanges, "Binding backing store to host NUMA node %d\n",
+                numa_node);
+
+        // the kernel takes one more than the number of bits in the mask
+        if (syscall(SYS_mbind, pmem, range.size(), MPOL_BIND,
+                    node_mask.data(), node_mask.size() * bits_per_word + 1,
+                    0) != 0) {
+            fatal("Could not bind range %s to host NUMA node %d: %s\n",
+                  range.to_string(), numa_node, strerror(errno));
+        }
+#else
+        fatal("Binding memory to a host NUMA node is not supported on "
+              "this host\n");
+#endif
+    }
+
+    // touch every page, preserving the contents of a shared backing
+    // store, so that the simulation does not take the page faults
+    if (mmapPrefault) {
+        DPRINTF(AddrRanges, "Prefaulting backing store for range %s\n",
+                range.to_string());
+
+        volatile uint8_t *page = pmem;
+        const Addr page_size = sysconf(_SC_PAGESIZE);
+        for (Addr offset = 0; offset < range.size(); offset += page_size)
+            page[offset] = page[offset];
+    }
+
     // remember this backing store so we can checkpoint it and unmap
     // it appropriately
     backingStore.emplace_back(range, pmem,
                               conf_table_reported, in_addr_map, kvm_map);
+    backingStoreMemories.push_back(_memories);
 
     // point the memories to their backing store
     for (const auto& m : _memories) {
@@ -239,6 +337,17 @@ PhysicalMemory::createBackingStore(
     }
 }
 
+std::vector<BackingStoreEntry>
+PhysicalMemory::getBackingStore() const
+{
+    for (const auto& store_memories : backingStoreMemories) {
+        for (const auto& m : store_memories)
+            m->exposeBackingStore();
+    }
+
+    return backingStore;
+}
+
 PhysicalMemory::~PhysicalMemory()
 {
     // unmap the backing store
@@ -439,6 +548,14 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
+    // sparse memories need to know which pages the checkpoint wrote
+    std::vector<AbstractMemory*> sparse_memories;
+    for (const auto& m : backingStoreMemories[store_id]) {
+        if (m->isSparse())
+            sparse_memories.push_back(m);
+    }
+    Addr last_page_written = MaxAddr;
+
     uint64_t curr_size = 0;
     long* temp_page = new long[chunk_size];
     long* pmem_current;
@@ -454,8 +571,16 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
             // Only copy bytes that are non-zero, so we don't give
             // the VM system hell
             if (*(temp_page + x) != 0) {
-                pmem_current = (long*)(pmem + curr_size + x * sizeof(long));
+                const Addr offset = curr_size + x * sizeof(long);
+                pmem_current = (long*)(pmem + offset);
                 *pmem_current = *(temp_page + x);
+
+                const Addr page = offset / AbstractMemory::SparsePageBytes;
+                if (page != last_page_written) {
+                    for (const auto& m : sparse_memories)
+                        m->setPagesWritten(offset, sizeof(long));
+                    last_page_written = page;
+                }
             }
         }
         curr_size += bytes_read;
@@ -133,12 +133,23 @@ class PhysicalMemory : public Serializable
     // Let the user choose if we reserve swap space when calling mmap
     const bool mmapUsingNoReserve;
 
+    // Let the user back the memory with huge pages, either from the
+    // hugetlb pool or by advising transparent huge pages
+    const bool mmapUsingHugeTLB;
+    const bool mmapTransparentHugePages;
+
+    // Let the user fault in the backing store when it is created
+    const bool mmapPrefault;
+
     const std::string sharedBackstore;
 
     // The physical memory used to provide the memory in the simulated
     // system
     std::vector<BackingStoreEntry> backingStore;
 
+    // The memories using each backing store
+    std::vector<std::vector<AbstractMemory*>> backingStoreMemories;
+
     // Prevent copying
     PhysicalMemory(const PhysicalMemory&);
 
@@ -153,11 +164,12 @@ class PhysicalMemory : public Serializable
      * @param range The address range covered
      * @param memories The memories this range maps to
      * @param kvm_map Should KVM map this memory for the guest
+     * @param numa_node Host NUMA node to bind the memory to, or -1
      */
     void createBackingStore(AddrRange range,
                             const std::vector<AbstractMemory*>& _memories,
                             bool conf_table_reported,
-                            bool in_addr_map, bool kvm_map);
+                            bool in_addr_map, bool kvm_map, int numa_node);
 
   public:
 
@@ -167,7 +179,10 @@ class PhysicalMemory : public Serializable
     PhysicalMemory(const std::string& _name,
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
-                   const std::string& shared_backstore);
+                   const std::string& shared_backstore,
+                   bool mmap_using_hugetlb,
+                   bool mmap_transparent_huge_pages,
+                   bool mmap_prefault);
 
     /**
      * Unmap all the backing store we have used.
@@ -216,10 +231,12 @@ class PhysicalMemory : public Serializable
      * the OS-visible global address map and thus are allowed to
      * overlap.
      *
+     * As the caller accesses the memory directly, sparse memories
+     * stop tracking the pages written.
+     *
      * @return Pointers to the memory backing store
      */
-    std::vector<BackingStoreEntry> getBackingStore() const
-    { return backingStore; }
+    std::vector<BackingStoreEntry> getBackingStore() const;
 
     /**
      * Perform an untimed memory access and update all the state
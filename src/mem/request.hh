@@ -54,10 +54,12 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "base/amo.hh"
 #include "base/flags.hh"
+#include "base/recycling_pool.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
 #include "mem/htm.hh"
@@ -475,6 +477,19 @@ class Request
 
     ~Request() {}
 
+    /**
+     * Create a shared request. The storage of the request and its
+     * reference count is recycled through a per-thread pool rather than
+     * allocated from the heap every time.
+     */
+    template <typename... Args>
+    static RequestPtr
+    create(Args&&... args)
+    {
+        return std::allocate_shared<Request>(RecyclingAllocator<Request>(),
+                                             std::forward<Args>(args)...);
+    }
+
     /**
      * Set up Context numbers.
      */
@@ -548,8 +563,8 @@ class Request
         assert(hasVaddr());
         assert(!hasPaddr());
         assert(split_addr > _vaddr && split_addr < _vaddr + _size);
-        req1 = std::make_shared<Request>(*this);
-        req2 = std::make_shared<Request>(*this);
+        req1 = Request::create(*this);
+        req2 = Request::create(*this);
         req1->_size = split_addr - _vaddr;
         req2->_vaddr = split_addr;
         req2->_size = _size - req1->_size;
@@ -49,12 +49,42 @@
 
 const int SnoopFilter::SNOOP_MASK_SIZE;
 
+SnoopFilter::SnoopItem
+SnoopFilter::getItem(size_t slot) const
+{
+    const unsigned mask_words = table.maskWords();
+    const uint64_t *words = table.sharers(slot);
+    SnoopItem item;
+    for (unsigned w = mask_words; w-- > 0; ) {
+        item.requested = (item.requested << 64) | SnoopMask(words[w]);
+        item.holder = (item.holder << 64) |
+            SnoopMask(words[mask_words + w]);
+    }
+    return item;
+}
+
+void
+SnoopFilter::setItem(size_t slot, const SnoopItem &item)
+{
+    const SnoopMask word_mask(~0ULL);
+    const unsigned mask_words = table.maskWords();
+    uint64_t *words = table.sharers(slot);
+    for (unsigned w = 0; w < mask_words; w++) {
+        words[w] = ((item.requested >> (64 * w)) & word_mask).to_ullong();
+        words[mask_words + w] =
+            ((item.holder >> (64 * w)) & word_mask).to_ullong();
+    }
+}
+
 void
-SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
+SnoopFilter::eraseIfNullEntry(size_t slot)
 {
-    SnoopItem& sf_item = sf_it->second;
-    if ((sf_item.requested | sf_item.holder).none()) {
-        cachedLocations.erase(sf_it);
+    const uint64_t *words = table.sharers(slot);
+    uint64_t any = 0;
+    for (unsigned w = 0; w < 2 * table.maskWords(); w++)
+        any |= words[w];
+    if (!any) {
+        table.erase(slot);
         DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
                 __func__);
     }
@@ -75,21 +105,23 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
         line_addr |= LineSecure;
     }
     SnoopMask req_port = portToMask(cpu_side_port);
-    reqLookupResult.it = cachedLocations.find(line_addr);
-    bool is_hit = (reqLookupResult.it != cachedLocations.end());
+    size_t slot = table.find(line_addr);
+    bool is_hit = (slot != SnoopLineTable::NoSlot);
 
     // If the snoop filter has no entry, and we should not allocate,
     // do not create a new snoop filter entry, simply return a NULL
     // portlist.
-    if (!is_hit && !allocate)
+    if (!is_hit && !allocate) {
+        reqLookupResult.lineAddr = SnoopLineTable::InvalidLine;
         return snoopDown(lookupLatency);
+    }
 
-    // If no hit in snoop filter create a new element and update iterator
+    // If no hit in snoop filter create a new element
     if (!is_hit) {
-        reqLookupResult.it =
-            cachedLocations.emplace(line_addr, SnoopItem()).first;
+        slot = table.insert(line_addr);
     }
-    SnoopItem& sf_item = reqLookupResult.it->second;
+    reqLookupResult.lineAddr = line_addr;
+    SnoopItem sf_item = getItem(slot);
     SnoopMask interested = sf_item.holder | sf_item.requested;
 
     // Store unmodified value of snoop filter item in temp storage in
@@ -149,6 +181,7 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
                     __func__,  sf_item.requested, sf_item.holder);
         }
     }
+    setItem(slot, sf_item);
 
     return snoopSelected(maskToPortList(interested & ~req_port), lookupLatency);
 }
@@ -156,26 +189,29 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
 void
 SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
 {
-    if (reqLookupResult.it != cachedLocations.end()) {
+    if (reqLookupResult.lineAddr != SnoopLineTable::InvalidLine) {
         // since we rely on the caller, do a basic check to ensure
         // that finishRequest is being called following lookupRequest
         Addr line_addr = (addr & ~(Addr(linesize - 1)));
         if (is_secure) {
             line_addr |= LineSecure;
         }
-        assert(reqLookupResult.it->first == line_addr);
+        assert(reqLookupResult.lineAddr == line_addr);
+        const size_t slot = table.find(line_addr);
+        assert(slot != SnoopLineTable::NoSlot);
         if (will_retry) {
             SnoopItem retry_item = reqLookupResult.retryItem;
             // Undo any changes made in lookupRequest to the snoop filter
             // entry if the request will come again. retryItem holds
             // the previous value of the snoopfilter entry.
-            reqLookupResult.it->second = retry_item;
+            setItem(slot, retry_item);
 
             DPRINTF(SnoopFilter, "%s:   restored SF value %x.%x\n",
                     __func__,  retry_item.requested, retry_item.holder);
         }
 
-        eraseIfNullEntry(reqLookupResult.it);
+        eraseIfNullEntry(slot);
+        reqLookupResult.lineAddr = SnoopLineTable::InvalidLine;
     }
 }
 
@@ -190,10 +226,10 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = (sf_it != cachedLocations.end());
+    const size_t slot = table.find(line_addr);
+    bool is_hit = (slot != SnoopLineTable::NoSlot);
 
-    panic_if(!is_hit && (cachedLocations.size() >= maxEntryCount),
+    panic_if(!is_hit && (table.size() >= maxEntryCount),
              "snoop filter exceeded capacity of %d cache blocks\n",
              maxEntryCount);
 
@@ -203,7 +239,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (!is_hit)
         return snoopDown(lookupLatency);
 
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem sf_item = getItem(slot);
 
     SnoopMask interested = (sf_item.holder | sf_item.requested);
 
@@ -233,7 +269,8 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
         sf_item.holder = 0;
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
-        eraseIfNullEntry(sf_it);
+        setItem(slot, sf_item);
+        eraseIfNullEntry(slot);
     }
 
     return snoopSelected(maskToPortList(interested), lookupLatency);
@@ -263,7 +300,11 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     }
     SnoopMask rsp_mask = portToMask(rsp_port);
     SnoopMask req_mask = portToMask(req_port);
-    SnoopItem& sf_item = cachedLocations[line_addr];
+    size_t slot = table.find(line_addr);
+    if (slot == SnoopLineTable::NoSlot) {
+        slot = table.insert(line_addr);
+    }
+    SnoopItem sf_item = getItem(slot);
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -292,6 +333,7 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     sf_item.holder |=  req_mask;
     sf_item.requested &= ~req_mask;
     assert((sf_item.requested | sf_item.holder).any());
+    setItem(slot, sf_item);
     DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
             __func__, sf_item.requested, sf_item.holder);
 }
@@ -310,8 +352,8 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = sf_it != cachedLocations.end();
+    const size_t slot = table.find(line_addr);
+    bool is_hit = slot != SnoopLineTable::NoSlot;
 
     // Nothing to do if it is not a hit
     if (!is_hit)
@@ -321,7 +363,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     // Modified state, and we know that there are no other copies, or
     // they will all be invalidated imminently
     if (!cpkt->hasSharers()) {
-        SnoopItem& sf_item = sf_it->second;
+        SnoopItem sf_item = getItem(slot);
 
         DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
@@ -329,7 +371,8 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
 
-        eraseIfNullEntry(sf_it);
+        setItem(slot, sf_item);
+        eraseIfNullEntry(slot);
     }
 }
 
@@ -352,12 +395,12 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    if (sf_it == cachedLocations.end())
+    const size_t slot = table.find(line_addr);
+    if (slot == SnoopLineTable::NoSlot)
         return;
 
     SnoopMask response_mask = portToMask(cpu_side_port);
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem sf_item = getItem(slot);
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -376,19 +419,21 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
         if (cpkt->isInvalidate()) {
             sf_item.holder &= ~response_mask;
         }
-        eraseIfNullEntry(sf_it);
+        setItem(slot, sf_item);
+        eraseIfNullEntry(slot);
     } else {
         // Any other response implies that a cache above will have the
         // block.
         sf_item.holder |= response_mask;
         assert((sf_item.holder | sf_item.requested).any());
+        setItem(slot, sf_item);
     }
     DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
             __func__, sf_item.requested, sf_item.holder);
 }
 
-SnoopFilter::SnoopFilterStats::SnoopFilterStats(Stats::Group *parent)
-    : Stats::Group(parent),
+SnoopFilter::SnoopFilterStats::SnoopFilterStats(SnoopFilter &sf)
+    : Stats::Group(&sf),
       ADD_STAT(totRequests, UNIT_COUNT,
                "Total number of requests made to the snoop filter."),
       ADD_STAT(hitSingleRequests, UNIT_COUNT,
@@ -404,8 +449,15 @@ SnoopFilter::SnoopFilterStats::SnoopFilterStats(Stats::Group *parent)
                "holder of the requested data."),
       ADD_STAT(hitMultiSnoops, UNIT_COUNT,
                "Number of snoops hitting in the snoop filter with multiple "
-               "(>1) holders of the requested data.")
-{}
+               "(>1) holders of the requested data."),
+      ADD_STAT(trackedLines, UNIT_COUNT,
+               "Number of lines currently tracked by the snoop filter."),
+      ADD_STAT(footprint, UNIT_BYTE,
+               "Host memory allocated to track the lines.")
+{
+    trackedLines.functor([&sf]() { return sf.table.size(); });
+    footprint.functor([&sf]() { return sf.table.footprint(); });
+}
 
 void
 SnoopFilter::regStats()
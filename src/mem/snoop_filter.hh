@@ -43,13 +43,16 @@
 #ifndef __MEM_SNOOP_FILTER_HH__
 #define __MEM_SNOOP_FILTER_HH__
 
+#include <algorithm>
 #include <bitset>
-#include <unordered_map>
+#include <cstdint>
 #include <utility>
+#include <vector>
 
 #include "mem/packet.hh"
 #include "mem/port.hh"
 #include "mem/qport.hh"
+#include "mem/snoop_line_table.hh"
 #include "params/SnoopFilter.hh"
 #include "sim/sim_object.hh"
 #include "sim/system.hh"
@@ -66,6 +69,11 @@
  * allows the snoop filter to model cache-line residency by snooping
  * the messages.
  *
+ * The map is an open-addressed hash table (SnoopLineTable). It stores
+ * the sharer bitmasks in flat arrays of 64-bit words, using only as many
+ * words per mask as needed for the snooping ports. This keeps the filter
+ * compact even when it tracks millions of lines.
+ *
  * The tracking happens in two fields to be able to distinguish
  * between in-flight requests (in requested) and already pulled in
  * lines (in holder). This distinction is used for producing tighter
@@ -92,10 +100,10 @@ class SnoopFilter : public SimObject {
     typedef std::vector<QueuedResponsePort*> SnoopList;
 
     SnoopFilter (const SnoopFilterParams &p) :
-        SimObject(p), reqLookupResult(cachedLocations.end()),
+        SimObject(p),
         linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
         maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
-        stats(this)
+        stats(*this)
     {
     }
 
@@ -121,6 +129,9 @@ class SnoopFilter : public SimObject {
         fatal_if(id > SNOOP_MASK_SIZE,
                  "Snoop filter only supports %d snooping ports, got %d\n",
                  SNOOP_MASK_SIZE, id);
+
+        // only store as many mask words as needed for the ports
+        table.setMaskWords(std::max(1, (id + 63) / 64));
     }
 
     /**
@@ -215,10 +226,6 @@ class SnoopFilter : public SimObject {
         SnoopMask requested;
         SnoopMask holder;
     };
-    /**
-     * HashMap of SnoopItems indexed by line address
-     */
-    typedef std::unordered_map<Addr, SnoopItem> SnoopFilterCache;
 
     /**
      * Simple factory methods for standard return values.
@@ -253,13 +260,19 @@ class SnoopFilter : public SimObject {
 
   private:
 
+    /** Read the item of a slot. */
+    SnoopItem getItem(size_t slot) const;
+
+    /** Write the item of a slot. */
+    void setItem(size_t slot, const SnoopItem &item);
+
     /**
      * Removes snoop filter items which have no requestors and no holders.
      */
-    void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
+    void eraseIfNullEntry(size_t slot);
 
-    /** Simple hash set of cached addresses. */
-    SnoopFilterCache cachedLocations;
+    /** Sharer masks of the tracked lines. */
+    SnoopLineTable table;
 
     /**
      * A request lookup must be followed by a call to finishRequest to inform
@@ -268,8 +281,11 @@ class SnoopFilter : public SimObject {
      * This structure keeps track of the state previous to such changes.
      */
     struct ReqLookupResult {
-        /** Iterator used to store the result from lookupRequest. */
-        SnoopFilterCache::iterator it;
+        /**
+         * Line found or allocated by lookupRequest, if any. Slots move
+         * when other lines are erased, so the line is looked up again.
+         */
+        Addr lineAddr = SnoopLineTable::InvalidLine;
 
         /**
          * Variable to temporarily store value of snoopfilter entry
@@ -277,18 +293,6 @@ class SnoopFilter : public SimObject {
          * (because of crossbar retry)
          */
         SnoopItem retryItem;
-
-        /**
-         * The constructor must be informed of the internal cache's end
-         * iterator, so do not allow the compiler to implictly define it.
-         *
-         * @param end_it Iterator to the end of the internal cache.
-         */
-        ReqLookupResult(SnoopFilterCache::iterator end_it)
-            : it(end_it), retryItem{0, 0}
-        {
-        }
-        ReqLookupResult() = delete;
     } reqLookupResult;
 
     /** List of all attached snooping CPU-side ports. */
@@ -312,7 +316,7 @@ class SnoopFilter : public SimObject {
 
     /** Statistics */
     struct SnoopFilterStats : public Stats::Group {
-        SnoopFilterStats(Stats::Group *parent);
+        SnoopFilterStats(SnoopFilter &sf);
 
         Stats::Scalar totRequests;
         Stats::Scalar hitSingleRequests;
@@ -321,6 +325,9 @@ class SnoopFilter : public SimObject {
         Stats::Scalar totSnoops;
         Stats::Scalar hitSingleSnoops;
         Stats::Scalar hitMultiSnoops;
+
+        Stats::Value trackedLines;
+        Stats::Value footprint;
     } stats;
 };
 
@@ -0,0 +1,132 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Implementation of the line table of a snoop filter.
+ */
+
+#include "mem/snoop_line_table.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/intmath.hh"
+
+const Addr SnoopLineTable::InvalidLine;
+const size_t SnoopLineTable::NoSlot;
+const size_t SnoopLineTable::MinTableSize;
+
+void
+SnoopLineTable::setMaskWords(unsigned mask_words)
+{
+    assert(numLines == 0);
+    assert(mask_words > 0);
+    _maskWords = mask_words;
+    sharerWords.assign(lineAddrs.size() * 2 * _maskWords, 0);
+}
+
+size_t
+SnoopLineTable::find(Addr line_addr) const
+{
+    if (numLines == 0)
+        return NoSlot;
+
+    // Linear probing, up to the first empty slot
+    for (size_t slot = homeSlot(line_addr); ; slot = (slot + 1) & tableMask) {
+        if (lineAddrs[slot] == line_addr)
+            return slot;
+        if (lineAddrs[slot] == InvalidLine)
+            return NoSlot;
+    }
+}
+
+size_t
+SnoopLineTable::insert(Addr line_addr)
+{
+    assert(line_addr != InvalidLine);
+    assert(find(line_addr) == NoSlot);
+
+    // Keep the load factor under one half, so that probes stay short
+    if (2 * (numLines + 1) > lineAddrs.size())
+        grow();
+
+    size_t slot = homeSlot(line_addr);
+    while (lineAddrs[slot] != InvalidLine)
+        slot = (slot + 1) & tableMask;
+
+    lineAddrs[slot] = line_addr;
+    std::fill_n(sharers(slot), 2 * _maskWords, 0);
+    numLines++;
+    return slot;
+}
+
+void
+SnoopLineTable::erase(size_t slot)
+{
+    assert(lineAddrs[slot] != InvalidLine);
+
+    // Move back every line of the cluster that can take the hole, i.e.,
+    // whose home slot is not between the hole and the line
+    size_t hole = slot;
+    for (size_t next = (hole + 1) & tableMask;
+         lineAddrs[next] != InvalidLine; next = (next + 1) & tableMask) {
+        const size_t home = homeSlot(lineAddrs[next]);
+        if (((next - home) & tableMask) >= ((next - hole) & tableMask)) {
+            lineAddrs[hole] = lineAddrs[next];
+            std::copy_n(sharers(next), 2 * _maskWords, sharers(hole));
+            hole = next;
+        }
+    }
+
+    lineAddrs[hole] = InvalidLine;
+    numLines--;
+}
+
+void
+SnoopLineTable::grow()
+{
+    std::vector<Addr> new_line_addrs(
+        std::max(MinTableSize, 2 * lineAddrs.size()), InvalidLine);
+    std::vector<uint64_t> new_sharer_words(
+        new_line_addrs.size() * 2 * _maskWords, 0);
+
+    tableMask = new_line_addrs.size() - 1;
+    tableBits = floorLog2(new_line_addrs.size());
+
+    for (size_t slot = 0; slot < lineAddrs.size(); slot++) {
+        if (lineAddrs[slot] == InvalidLine)
+            continue;
+        size_t new_slot = homeSlot(lineAddrs[slot]);
+        while (new_line_addrs[new_slot] != InvalidLine)
+            new_slot = (new_slot + 1) & tableMask;
+        new_line_addrs[new_slot] = lineAddrs[slot];
+        std::copy_n(sharers(slot), 2 * _maskWords,
+                    &new_sharer_words[new_slot * 2 * _maskWords]);
+    }
+
+    lineAddrs.swap(new_line_addrs);
+    sharerWords.swap(new_sharer_words);
+}
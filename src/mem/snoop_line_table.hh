@@ -0,0 +1,158 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definition of the line table of a snoop filter.
+ */
+
+#ifndef __MEM_SNOOP_LINE_TABLE_HH__
+#define __MEM_SNOOP_LINE_TABLE_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "base/types.hh"
+
+/**
+ * Open-addressed hash table from line addresses to the sharer masks of
+ * a snoop filter. Collisions are resolved by linear probing, and erasing
+ * a line moves back the lines that probed past it, so no tombstones are
+ * needed. The masks are stored in a flat array of 64-bit words, as a
+ * configurable number of requested words followed by as many holder
+ * words. Slots move when lines are erased or the table grows, so they
+ * must not be kept across such changes.
+ */
+class SnoopLineTable
+{
+  public:
+    /** Line address marking an empty slot of the table */
+    static const Addr InvalidLine = MaxAddr;
+
+    /** Slot index denoting that a line is not tracked */
+    static const size_t NoSlot = (size_t)-1;
+
+    /** Minimum number of slots of the table once allocated */
+    static const size_t MinTableSize = 1024;
+
+    SnoopLineTable() : _maskWords(1), tableMask(0), tableBits(0),
+                       numLines(0)
+    {
+    }
+
+    /**
+     * Set the number of words per sharer mask. This can only be done
+     * while the table is empty.
+     */
+    void setMaskWords(unsigned mask_words);
+
+    /** Number of 64-bit words stored per sharer mask. */
+    unsigned maskWords() const { return _maskWords; }
+
+    /**
+     * Find the slot tracking a line.
+     *
+     * @param line_addr Line address.
+     * @return The slot of the line, or NoSlot if it is not tracked.
+     */
+    size_t find(Addr line_addr) const;
+
+    /**
+     * Start tracking a line that is not tracked yet, growing the table
+     * if needed.
+     *
+     * @param line_addr Line address.
+     * @return The slot of the line, whose masks are all zero.
+     */
+    size_t insert(Addr line_addr);
+
+    /**
+     * Stop tracking the line in a slot.
+     *
+     * @param slot Slot of the line.
+     */
+    void erase(size_t slot);
+
+    /** Line address tracked in a slot. */
+    Addr lineAddr(size_t slot) const { return lineAddrs[slot]; }
+
+    /** Mask words of a slot: requested ones first, then holder ones. */
+    uint64_t *
+    sharers(size_t slot)
+    {
+        return &sharerWords[slot * 2 * _maskWords];
+    }
+    const uint64_t *
+    sharers(size_t slot) const
+    {
+        return &sharerWords[slot * 2 * _maskWords];
+    }
+
+    /** Number of lines currently tracked. */
+    size_t size() const { return numLines; }
+
+    /** Number of slots of the table. */
+    size_t numSlots() const { return lineAddrs.size(); }
+
+    /** Host memory allocated for the table, in bytes. */
+    size_t
+    footprint() const
+    {
+        return lineAddrs.size() * sizeof(Addr) +
+            sharerWords.size() * sizeof(uint64_t);
+    }
+
+  private:
+    /** Double the size of the table, re-inserting all lines. */
+    void grow();
+
+    /** First slot probed for a line. */
+    size_t
+    homeSlot(Addr line_addr) const
+    {
+        return (line_addr * 0x9E3779B97F4A7C15ULL) >> (64 - tableBits);
+    }
+
+    /** Line address tracked in every slot of the table. */
+    std::vector<Addr> lineAddrs;
+
+    /** Sharer mask words of every slot of the table. */
+    std::vector<uint64_t> sharerWords;
+
+    /** Number of 64-bit words stored per sharer mask. */
+    unsigned _maskWords;
+
+    /** Number of slots of the table minus one. */
+    size_t tableMask;
+
+    /** Log2 of the number of slots of the table. */
+    unsigned tableBits;
+
+    /** Number of lines currently tracked. */
+    size_t numLines;
+};
+
+#endif //__MEM_SNOOP_LINE_TABLE_HH__
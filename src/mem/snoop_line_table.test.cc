@@ -0,0 +1,163 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "mem/snoop_line_table.hh"
+
+namespace {
+
+typedef std::unordered_map<Addr, std::vector<uint64_t>> RefTable;
+
+/** Checks that a table tracks exactly the lines of a reference map. */
+void
+checkTable(const SnoopLineTable &table, const RefTable &ref)
+{
+    ASSERT_EQ(table.size(), ref.size());
+    for (const auto &line : ref) {
+        const size_t slot = table.find(line.first);
+        ASSERT_NE(slot, SnoopLineTable::NoSlot) << "line " << line.first;
+        ASSERT_EQ(table.lineAddr(slot), line.first);
+        const std::vector<uint64_t> words(
+            table.sharers(slot), table.sharers(slot) + line.second.size());
+        ASSERT_EQ(words, line.second) << "line " << line.first;
+    }
+}
+
+/**
+ * Applies the same random inserts, sharer updates and erases to a table
+ * and to a reference map, growing the table through several sizes and
+ * shrinking it back, and checks that they agree. Line addresses are
+ * drawn from a small range, so that probe sequences are long and erases
+ * often have to move back lines.
+ */
+void
+checkAgainstMap(unsigned mask_words, Addr addr_range, std::mt19937_64 &rng)
+{
+    SnoopLineTable table;
+    table.setMaskWords(mask_words);
+    RefTable ref;
+
+    const size_t num_words = 2 * mask_words;
+    std::vector<Addr> lines;
+
+    for (int step = 0; step < 200000; step++) {
+        // Fill up for the first half, then mostly drain
+        const bool filling = step < 100000;
+        const int action = rng() % 8;
+        const Addr addr = (rng() % addr_range) * 64;
+
+        if (action < (filling ? 5 : 2)) {
+            const size_t slot = table.find(addr);
+            if (ref.count(addr)) {
+                ASSERT_NE(slot, SnoopLineTable::NoSlot);
+                continue;
+            }
+            ASSERT_EQ(slot, SnoopLineTable::NoSlot);
+            const size_t new_slot = table.insert(addr);
+            for (size_t w = 0; w < num_words; w++)
+                ASSERT_EQ(table.sharers(new_slot)[w], 0);
+
+            std::vector<uint64_t> words(num_words);
+            for (size_t w = 0; w < num_words; w++) {
+                words[w] = rng();
+                table.sharers(new_slot)[w] = words[w];
+            }
+            ref[addr] = words;
+            lines.push_back(addr);
+        } else if (action < 6 && !lines.empty()) {
+            // Erase a tracked line
+            const size_t pos = rng() % lines.size();
+            const Addr line = lines[pos];
+            lines[pos] = lines.back();
+            lines.pop_back();
+
+            const size_t slot = table.find(line);
+            ASSERT_NE(slot, SnoopLineTable::NoSlot);
+            table.erase(slot);
+            ref.erase(line);
+            ASSERT_EQ(table.find(line), SnoopLineTable::NoSlot);
+        } else if (!lines.empty()) {
+            // Update the sharers of a tracked line
+            const Addr line = lines[rng() % lines.size()];
+            const size_t slot = table.find(line);
+            ASSERT_NE(slot, SnoopLineTable::NoSlot);
+            const size_t w = rng() % num_words;
+            table.sharers(slot)[w] = rng();
+            ref[line][w] = table.sharers(slot)[w];
+        }
+
+        if (step % 10000 == 0)
+            checkTable(table, ref);
+    }
+
+    // The table went through several sizes
+    ASSERT_GT(table.numSlots(), 4 * SnoopLineTable::MinTableSize);
+    checkTable(table, ref);
+}
+
+} // anonymous namespace
+
+TEST(SnoopLineTableTest, Empty)
+{
+    SnoopLineTable table;
+    EXPECT_EQ(table.size(), 0);
+    EXPECT_EQ(table.numSlots(), 0);
+    EXPECT_EQ(table.find(0), SnoopLineTable::NoSlot);
+    EXPECT_EQ(table.footprint(), 0);
+}
+
+TEST(SnoopLineTableTest, SingleMaskWord)
+{
+    std::mt19937_64 rng(1);
+    checkAgainstMap(1, 1 << 16, rng);
+}
+
+TEST(SnoopLineTableTest, SeveralMaskWords)
+{
+    std::mt19937_64 rng(2);
+    checkAgainstMap(4, 1 << 16, rng);
+}
+
+TEST(SnoopLineTableTest, SparseAddresses)
+{
+    std::mt19937_64 rng(3);
+    checkAgainstMap(1, Addr(1) << 40, rng);
+}
+
+TEST(SnoopLineTableTest, Footprint)
+{
+    SnoopLineTable table;
+    table.setMaskWords(2);
+    table.insert(0x40);
+    EXPECT_EQ(table.numSlots(), SnoopLineTable::MinTableSize);
+    EXPECT_EQ(table.footprint(),
+              SnoopLineTable::MinTableSize * (sizeof(Addr) +
+                                              4 * sizeof(uint64_t)));
+}
@@ -183,15 +183,30 @@ def simulate(*args, **kwargs):
 
     return sim_out
 
-def drain():
+def drain(sim_objects=None):
     """Drain the simulator in preparation of a checkpoint or memory mode
     switch.
 
     This operation is a no-op if the simulator is already in the
     Drained state.
 
+    Arguments:
+      sim_objects -- Only drain these objects and leave the rest of the
+                     simulator running, e.g. to switch CPUs. Drain all
+                     objects if None.
     """
 
+    # Objects left running by a partial drain have to take part in
+    # this one, so start over from a running simulator.
+    if _drain_manager.isPartiallyDrained():
+        _drain_manager.resume()
+
+    if sim_objects is None:
+        try_drain = _drain_manager.tryDrain
+    else:
+        cc_objects = [ obj.getCCObject() for obj in sim_objects ]
+        try_drain = lambda: _drain_manager.tryDrain(cc_objects)
+
     # Try to drain all objects. Draining might not be completed unless
     # all objects return that they are drained on the first call. This
     # is because as objects drain they may cause other objects to no
@@ -200,7 +215,7 @@ def drain():
         # Try to drain the system. The drain is successful if all
         # objects are done without simulation. We need to simulate
         # more if not.
-        if _drain_manager.tryDrain():
+        if try_drain():
             return True
 
         # WARNING: if a valid exit event occurs while draining, it
@@ -298,7 +313,15 @@ def switchCpus(system, cpuList, verbose=True):
     except KeyError:
         raise RuntimeError("Invalid memory mode (%s)" % memory_mode_name)
 
-    drain()
+    # A change of memory mode has to be seen by the whole memory
+    # system, which then has to be drained. Otherwise, the CPUs being
+    # switched are the only objects involved, so leave the rest of the
+    # simulator running.
+    if system.getMemoryMode() == memory_mode:
+        drain([ obj for cpu in old_cpus + new_cpus
+                for obj in cpu.descendants() ])
+    else:
+        drain()
 
     # Now all of the CPUs are ready to be switched out
     for old_cpu, new_cpu in cpuList:
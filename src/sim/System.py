@@ -78,6 +78,18 @@ class System(SimObject):
     mmap_using_noreserve = Param.Bool(False, "mmap the backing store " \
                                           "without reserving swap")
 
+    # Large simulated memories spend a lot of host time on TLB misses,
+    # which can be reduced by backing them with huge pages, either
+    # explicitly from the hugetlb pool or through transparent huge
+    # pages. Prefaulting the backing store trades start-up time and
+    # host memory for not taking page faults during simulation.
+    mmap_using_hugetlb = Param.Bool(False, "mmap the backing store " \
+                                        "using hugetlb pages")
+    mmap_transparent_huge_pages = Param.Bool(False, "Advise the host to " \
+        "back the backing store with transparent huge pages")
+    mmap_prefault = Param.Bool(False, "Fault in the backing store at " \
+                                   "creation")
+
     # The memory ranges are to be populated when creating the system
     # such that these can be passed from the I/O subsystem through an
     # I/O bridge or cache
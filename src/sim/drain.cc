@@ -49,7 +49,8 @@ DrainManager DrainManager::_instance;
 
 DrainManager::DrainManager()
     : _count(0),
-      _state(DrainState::Running)
+      _state(DrainState::Running),
+      _partial(false)
 {
 }
 
@@ -59,6 +60,20 @@ DrainManager::~DrainManager()
 
 bool
 DrainManager::tryDrain()
+{
+    _partial = false;
+    return drainObjects(_allDrainable);
+}
+
+bool
+DrainManager::tryDrain(const std::vector<Drainable *> &objs)
+{
+    _partial = true;
+    return drainObjects(objs);
+}
+
+bool
+DrainManager::drainObjects(const std::vector<Drainable *> &objs)
 {
     panic_if(_state == DrainState::Drained,
              "Trying to drain a drained system\n");
@@ -66,9 +81,9 @@ DrainManager::tryDrain()
     panic_if(_count != 0,
              "Drain counter must be zero at the start of a drain cycle\n");
 
-    DPRINTF(Drain, "Trying to drain %u objects.\n", drainableCount());
+    DPRINTF(Drain, "Trying to drain %u objects.\n", objs.size());
     _state = DrainState::Draining;
-    for (auto *obj : _allDrainable) {
+    for (auto *obj : objs) {
         DrainState status = obj->dmDrain();
         if (DTRACE(Drain) && status != DrainState::Drained) {
             SimObject *temp = dynamic_cast<SimObject*>(obj);
@@ -84,7 +99,7 @@ DrainManager::tryDrain()
         return true;
     } else {
         DPRINTF(Drain, "Need another drain cycle. %u/%u objects not ready.\n",
-                _count, drainableCount());
+                _count, objs.size());
         return false;
     }
 }
@@ -126,6 +141,7 @@ DrainManager::resume()
     } while (!allInState(DrainState::Running));
 
     _state = DrainState::Running;
+    _partial = false;
 }
 
 void
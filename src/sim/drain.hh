@@ -104,6 +104,24 @@ class DrainManager
      */
     bool tryDrain();
 
+    /**
+     * Try to drain a subset of the simulator.
+     *
+     * Like tryDrain(), but only the given objects are drained while
+     * the rest of the simulator keeps running. This is enough to hand
+     * over CPUs when nothing else needs to observe the switch, such as
+     * when the memory mode does not change. The simulator is reported
+     * as drained until the next resume(), which only resumes these
+     * objects.
+     *
+     * @param objs Objects to drain.
+     * @return true if all the objects were drained successfully,
+     * false if more simulation is needed.
+     *
+     * @ingroup api_drain
+     */
+    bool tryDrain(const std::vector<Drainable *> &objs);
+
     /**
      * Resume normal simulation in a Drained system.
      *
@@ -140,6 +158,13 @@ class DrainManager
      */
     bool isDrained() const { return _state == DrainState::Drained; }
 
+    /**
+     * Check if only a subset of the system was drained
+     *
+     * @ingroup api_drain
+     */
+    bool isPartiallyDrained() const { return isDrained() && _partial; }
+
     /**
      * Get the simulators global drain state
      *
@@ -160,6 +185,9 @@ class DrainManager
     void unregisterDrainable(Drainable *obj);
 
   private:
+    /** Drain the given objects, see tryDrain(). */
+    bool drainObjects(const std::vector<Drainable *> &objs);
+
     /**
      * Helper function to check if all Drainable objects are in a
      * specific state.
@@ -188,6 +216,9 @@ class DrainManager
     /** Global simulator drain state */
     DrainState _state;
 
+    /** Set if only some of the objects have been drained */
+    bool _partial;
+
     /** Singleton instance of the drain manager */
     static DrainManager _instance;
 };
@@ -31,8 +31,10 @@
 #include <cassert>
 
 #include "arch/generic/mmu.hh"
+#include "cpu/base.hh"
 #include "debug/Vma.hh"
 #include "mem/se_translating_port_proxy.hh"
+#include "sim/eventq.hh"
 #include "sim/process.hh"
 #include "sim/syscall_debug_macros.hh"
 #include "sim/system.hh"
@@ -92,7 +94,7 @@ MemState::isUnmapped(Addr start_addr, Addr length)
      */
     for (auto start = start_addr; start < end_addr;
          start += _pageBytes) {
-        if (_ownerProcess->pTable->lookup(start) != nullptr) {
+        if (_ownerProcess->pTable->translate(start)) {
             panic("Someone allocated physical memory at VA %p without "
                   "creating a VMA!\n", start);
             return false;
@@ -258,6 +260,10 @@ MemState::unmapRegion(Addr start_addr, Addr length)
      * that can flush just part of the address space.
      */
     for (auto *tc: _ownerProcess->system->threads) {
+        // The TLBs of a core simulated by another host thread may only be
+        // touched from the queue of that core.
+        EventQueue::ScopedMigration migrate(tc->getCpuPtr()->eventQueue(),
+                                            inParallelMode);
         tc->getMMUPtr()->flushAll();
     }
 
@@ -359,6 +365,8 @@ MemState::remapRegion(Addr start_addr, Addr new_start_addr, Addr length)
      * that can flush just part of the address space.
      */
     for (auto *tc: _ownerProcess->system->threads) {
+        EventQueue::ScopedMigration migrate(tc->getCpuPtr()->eventQueue(),
+                                            inParallelMode);
         tc->getMMUPtr()->flushAll();
     }
 
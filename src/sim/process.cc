@@ -313,8 +313,7 @@ Process::allocateMem(Addr vaddr, int64_t size, bool clobber)
     // a physical page frame to map with the virtual page. Other cores can
     // return if the page has been mapped and `!clobber`.
     if (!clobber) {
-        const EmulationPageTable::Entry *pte = pTable->lookup(vaddr);
-        if (pte) {
+        if (pTable->translate(vaddr)) {
             warn("Process::allocateMem: addr %#x already mapped\n", vaddr);
             return;
         }
@@ -348,6 +347,7 @@ Process::replicatePage(Addr vaddr, Addr new_paddr, ThreadContext *old_tc,
 bool
 Process::fixupFault(Addr vaddr)
 {
+    System::SELock se_lock(system);
     return memState->fixupFault(vaddr);
 }
 
@@ -30,13 +30,20 @@
 #include "sim/syscall_desc.hh"
 
 #include "base/types.hh"
+#include "cpu/thread_context.hh"
 #include "sim/syscall_debug_macros.hh"
-
-class ThreadContext;
+#include "sim/system.hh"
 
 void
 SyscallDesc::doSyscall(ThreadContext *tc)
 {
+    // Syscalls update state shared by all the threads of the system, and
+    // access memory functionally from the queue servicing the memory
+    // system when cores are simulated by separate host threads.
+    System *sys = tc->getSystemPtr();
+    System::SELock se_lock(sys);
+    EventQueue::ScopedMigration migrate(sys->eventQueue(), inParallelMode);
+
     DPRINTF_SYSCALL(Base, "Calling %s...\n", dumper(name(), tc));
 
     SyscallReturn retval = executor(this, tc);
@@ -215,7 +215,8 @@ System::System(const Params &p)
       kvmVM(nullptr),
 #endif
       physmem(name() + ".physmem", p.memories, p.mmap_using_noreserve,
-              p.shared_backstore),
+              p.shared_backstore, p.mmap_using_hugetlb,
+              p.mmap_transparent_huge_pages, p.mmap_prefault),
       memoryMode(p.mem_mode),
       _cacheLineSize(p.cache_line_size),
       workItemsBegin(0),
@@ -261,6 +262,16 @@ System::System(const Params &p)
         params().memories[x]->system(this);
 }
 
+System::SELock::SELock(System *_sys)
+    : sys(*_sys)
+{
+    if (sys.seMutex.try_lock())
+        return;
+
+    EventQueue::ScopedRelease release(curEventQueue());
+    sys.seMutex.lock();
+}
+
 System::~System()
 {
     for (uint32_t j = 0; j < numWorkIds; j++)
@@ -42,6 +42,7 @@
 #ifndef __SYSTEM_HH__
 #define __SYSTEM_HH__
 
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -604,6 +605,31 @@ class System : public SimObject, public PCEventScope
 
     FutexMap futexMap;
 
+  private:
+    /**
+     * Serializes updates to the syscall emulation state shared by the
+     * threads of this system (memory layouts, file descriptors, futexes)
+     * when cores are simulated by separate host threads. Recursive since
+     * fixing up a fault may be needed while emulating a syscall.
+     */
+    std::recursive_mutex seMutex;
+
+  public:
+    /**
+     * Scoped holder of the syscall emulation lock. The current event queue
+     * is released while waiting for the lock since its holder may need to
+     * migrate to that queue, e.g., to wake up one of its threads.
+     */
+    class SELock
+    {
+      public:
+        SELock(System *sys);
+        ~SELock() { sys.seMutex.unlock(); }
+
+      private:
+        System &sys;
+    };
+
     static const int maxPID = 32768;
 
     /** Process set to track which PIDs have already been allocated */
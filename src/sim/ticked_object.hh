@@ -111,6 +111,25 @@ class Ticked : public Serializable
         }
     }
 
+    /** Start ticking in the current cycle, as an object that had kept
+     *  ticking through the stopped cycles would have, unless it was
+     *  stopped in this very cycle */
+    void
+    startThisCycle()
+    {
+        if (!running && object.curCycle() > lastStopped) {
+            if (!event.scheduled())
+                object.schedule(event, object.clockEdge());
+            running = true;
+            /* The evaluation in this cycle counts itself */
+            Cycles skipped = cyclesSinceLastStopped() - Cycles(1);
+            numCycles += skipped;
+            countCycles(skipped);
+        } else {
+            start();
+        }
+    }
+
     /** How long have we been stopped for? */
     Cycles
     cyclesSinceLastStopped() const
@@ -0,0 +1,121 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Records a branch trace of a binary with the BranchTrace probe and then
+# replays the trace with BranchTraceReplay. A process can only instantiate
+# a single simulated system, so the recording runs in a forked child.
+
+import argparse
+import os
+import sys
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser()
+parser.add_argument('binary', type = str)
+
+args = parser.parse_args()
+
+trace_file = 'branch.trace.gz'
+
+def record():
+    system = System()
+
+    system.workload = SEWorkload.init_compatible(args.binary)
+
+    system.clk_domain = SrcClockDomain()
+    system.clk_domain.clock = '1GHz'
+    system.clk_domain.voltage_domain = VoltageDomain()
+
+    system.mem_ranges = [AddrRange('512MB')]
+
+    system.cpu = AtomicSimpleCPU()
+    system.cpu.addBranchTraceProbe(trace_file)
+
+    system.membus = SystemXBar()
+    system.cpu.icache_port = system.membus.slave
+    system.cpu.dcache_port = system.membus.slave
+
+    system.cpu.createInterruptController()
+    if m5.defines.buildEnv['TARGET_ISA'] == "x86":
+        system.cpu.interrupts[0].pio = system.membus.master
+        system.cpu.interrupts[0].int_master = system.membus.slave
+        system.cpu.interrupts[0].int_slave = system.membus.master
+
+    system.mem_ctrl = SimpleMemory()
+    system.mem_ctrl.range = system.mem_ranges[0]
+    system.mem_ctrl.port = system.membus.master
+    system.system_port = system.membus.slave
+
+    process = Process()
+    process.cmd = [args.binary]
+    system.cpu.workload = process
+    system.cpu.createThreads()
+
+    root = Root(full_system = False, system = system)
+    m5.instantiate()
+
+    exit_event = m5.simulate()
+
+    if exit_event.getCause() != 'exiting with last active thread context':
+        sys.exit(1)
+
+def replay():
+    root = Root(full_system = False)
+    root.replay = BranchTraceReplay(
+        trace_file = os.path.join(m5.options.outdir, trace_file),
+        predictors = [ LocalBP(), TournamentBP() ])
+    m5.instantiate()
+
+    exit_event = m5.simulate()
+
+    if exit_event.getCause() != 'branch trace replay complete':
+        sys.exit(1)
+
+    # The trace must have recorded something for the round trip to mean
+    # anything.
+    m5.stats.dump()
+    with open(os.path.join(m5.options.outdir, 'stats.txt')) as stats:
+        for line in stats:
+            fields = line.split()
+            if fields and fields[0] == 'replay.branches':
+                if float(fields[1]) > 0:
+                    return
+    print("No branches were replayed", file=sys.stderr)
+    sys.exit(1)
+
+sys.stdout.flush()
+pid = os.fork()
+if pid == 0:
+    # The trace is flushed and closed by an exit callback, so leave
+    # through sys.exit rather than os._exit.
+    record()
+    sys.exit(0)
+
+_, status = os.waitpid(pid, 0)
+if status != 0:
+    print("Recording the branch trace failed", file=sys.stderr)
+    sys.exit(1)
+
+replay()
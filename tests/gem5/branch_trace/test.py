@@ -0,0 +1,55 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+'''
+Records a branch trace of hello world and replays it against branch
+predictors, checking that the trace written by the BranchTrace probe can be
+read back by BranchTraceReplay.
+'''
+
+from testlib import *
+
+isa_urls = {
+    constants.gcn3_x86_tag :
+        config.resource_url + '/test-progs/hello/bin/x86/linux',
+    constants.arm_tag :
+        config.resource_url + '/test-progs/hello/bin/arm/linux',
+}
+
+binary = 'hello64-static'
+
+for isa in isa_urls:
+    path = joinpath(config.bin_path, 'hello', isa.lower())
+    hello_program = DownloadedProgram(isa_urls[isa] + '/' + binary, path,
+                                      binary)
+
+    gem5_verify_config(
+        name='test-branch-trace-replay',
+        fixtures=(hello_program,),
+        verifiers=(),
+        config=joinpath(getcwd(), 'run.py'),
+        config_args=[joinpath(path, binary)],
+        valid_isas=(isa,),
+        valid_hosts=constants.supported_hosts,
+        length=constants.quick_tag,
+    )
@@ -0,0 +1,104 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Helpers for configurations that run several simulations and check that
+# they produce the same statistics.
+#
+# A process can only instantiate a single simulated system, so each
+# simulation is run by a forked child. The children leave through
+# sys.exit, so that the exit callbacks dump their statistics, and they
+# share the stats file of the parent, writing to it one after the other.
+
+import os
+import sys
+
+import m5
+
+def stats_dumps(fn):
+    """Split a text stats file into one dict per dump, ignoring the host
+    statistics which depend on the simulation speed."""
+    dumps = []
+    with open(fn) as stats:
+        for line in stats:
+            if line.startswith("---------- Begin"):
+                dumps.append({})
+                continue
+            fields = line.split()
+            if len(fields) < 2 or fields[0].startswith("host_") or \
+               fields[0].startswith("-"):
+                continue
+            dumps[-1][fields[0]] = fields[1]
+    return dumps
+
+def run_forked(name, run):
+    """Call run in a forked child, and exit with an error if it fails."""
+    sys.stdout.flush()
+    pid = os.fork()
+    if pid == 0:
+        run()
+        sys.exit(0)
+
+    _, status = os.waitpid(pid, 0)
+    if status != 0:
+        print("Run %s failed" % name, file=sys.stderr)
+        sys.exit(1)
+
+def compare_runs(runs, ignore=()):
+    """Run each of the (name, function) pairs in runs in a forked child,
+    and exit with an error unless every run dumps the same statistics as
+    the first one. Statistics whose name ends with one of the suffixes in
+    ignore are not compared. Return the dumps of every run."""
+    for name, run in runs:
+        run_forked(name, run)
+
+    dumps = stats_dumps(os.path.join(m5.options.outdir,
+                                     m5.options.stats_file))
+    if not dumps or len(dumps) % len(runs):
+        print("Unexpected number of stats dumps: %d" % len(dumps),
+              file=sys.stderr)
+        sys.exit(1)
+
+    per_run = len(dumps) // len(runs)
+    base_name = runs[0][0]
+    base = dumps[:per_run]
+
+    mismatches = 0
+    for i, (name, _) in enumerate(runs[1:], 1):
+        other = dumps[i * per_run:(i + 1) * per_run]
+        for dump, (b, o) in enumerate(zip(base, other)):
+            for stat in sorted(set(b) | set(o)):
+                if stat.endswith(tuple(ignore)):
+                    continue
+                if b.get(stat) != o.get(stat):
+                    print("Dump %d: %s is %s with %s but %s with %s" %
+                          (dump, stat, b.get(stat), base_name, o.get(stat),
+                           name), file=sys.stderr)
+                    mismatches += 1
+
+    if mismatches:
+        sys.exit(1)
+
+    print("Statistics of %s match over %d dumps" %
+          (", ".join(name for name, _ in runs), per_run))
+
+    return [dumps[i * per_run:(i + 1) * per_run] for i in range(len(runs))]
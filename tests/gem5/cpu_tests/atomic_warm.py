@@ -0,0 +1,156 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Fast-forwards a binary on the atomic CPU, once through the cache ports
+# and the normal branch prediction path and once with functional warming,
+# then switches to the timing CPU. The caches and the branch predictor
+# must be left in the same state, so both runs must produce the same
+# statistics, except that warming must not count towards the statistics
+# of the predictor it trains.
+
+import argparse
+import sys
+
+import m5
+from m5.objects import *
+
+m5.util.addToPath('../configs/')
+from stats_compare import compare_runs
+
+parser = argparse.ArgumentParser()
+parser.add_argument('binary', type = str)
+parser.add_argument('--warm-insts', type = int, default = 100000,
+                    help = "Instructions to fast-forward before switching")
+
+args = parser.parse_args()
+
+# Statistics that only the atomic CPU predicting through the normal path
+# updates while fast-forwarding
+bp_stats = ('lookups', 'condPredicted', 'condIncorrect', 'BTBLookups',
+            'BTBHits', 'BTBHitRatio', 'RASUsed', 'RASIncorrect',
+            'indirectLookups', 'indirectHits', 'indirectMisses',
+            'indirectMispredicted')
+fast_forward_only = tuple('branchPred.' + s for s in bp_stats) + \
+    ('numPredictedBranches', 'numBranchMispred')
+
+def run(warm):
+    system = System()
+
+    system.workload = SEWorkload.init_compatible(args.binary)
+
+    system.clk_domain = SrcClockDomain()
+    system.clk_domain.clock = '1GHz'
+    system.clk_domain.voltage_domain = VoltageDomain()
+
+    system.mem_mode = 'atomic'
+    system.mem_ranges = [AddrRange('512MB')]
+
+    system.cpu = AtomicSimpleCPU(cpu_id = 0,
+                                 max_insts_any_thread = args.warm_insts)
+    system.switch_cpu = TimingSimpleCPU(cpu_id = 0, switched_out = True)
+    system.switch_cpu.branchPred = LocalBP(indirectBranchPred = NULL)
+
+    # Small caches, so that the fast-forwarded phase exercises both hits
+    # and replacements
+    system.cpu.icache = Cache(size = '4kB', assoc = 2, tag_latency = 1,
+                              data_latency = 2, response_latency = 1,
+                              mshrs = 4, tgts_per_mshr = 8)
+    system.cpu.dcache = Cache(size = '4kB', assoc = 2, tag_latency = 1,
+                              data_latency = 2, response_latency = 1,
+                              mshrs = 4, tgts_per_mshr = 8)
+    system.cpu.icache.cpu_side = system.cpu.icache_port
+    system.cpu.dcache.cpu_side = system.cpu.dcache_port
+
+    if warm:
+        system.cpu.warm_icache = system.cpu.icache
+        system.cpu.warm_dcache = system.cpu.dcache
+        system.cpu.warm_branch_pred = system.switch_cpu.branchPred
+    else:
+        system.cpu.branchPred = system.switch_cpu.branchPred
+
+    system.membus = SystemXBar()
+    system.cpu.icache.mem_side = system.membus.slave
+    system.cpu.dcache.mem_side = system.membus.slave
+
+    system.cpu.createInterruptController()
+    if m5.defines.buildEnv['TARGET_ISA'] == "x86":
+        system.cpu.interrupts[0].pio = system.membus.master
+        system.cpu.interrupts[0].int_master = system.membus.slave
+        system.cpu.interrupts[0].int_slave = system.membus.master
+
+    system.mem_ctrl = SimpleMemory(range = system.mem_ranges[0])
+    system.mem_ctrl.port = system.membus.master
+    system.system_port = system.membus.slave
+
+    process = Process()
+    process.cmd = [args.binary]
+    system.cpu.workload = process
+    system.cpu.createThreads()
+    system.switch_cpu.workload = process
+    system.switch_cpu.isa = system.cpu.isa
+
+    root = Root(full_system = False, system = system)
+    m5.instantiate()
+
+    exit_event = m5.simulate()
+    if exit_event.getCause() != 'a thread reached the max instruction count':
+        sys.exit(1)
+
+    m5.switchCpus(system, [(system.cpu, system.switch_cpu)])
+    m5.stats.dump()
+    m5.stats.reset()
+
+    exit_event = m5.simulate()
+    if exit_event.getCause() != 'exiting with last active thread context':
+        sys.exit(1)
+
+port_dumps, warm_dumps = compare_runs([
+    ("normal atomic path", lambda: run(False)),
+    ("functional warming", lambda: run(True)),
+], ignore=fast_forward_only)
+
+# Once switched, the timing CPU predicts through the normal path in both
+# runs, so the predictor must behave the same after both kinds of warming
+switched = 1
+mismatches = 0
+for stat in sorted(set(port_dumps[switched]) | set(warm_dumps[switched])):
+    if not stat.endswith(fast_forward_only):
+        continue
+    port = port_dumps[switched].get(stat)
+    warm = warm_dumps[switched].get(stat)
+    if port != warm:
+        print("%s is %s after the normal atomic path but %s after "
+              "functional warming" % (stat, port, warm), file=sys.stderr)
+        mismatches += 1
+
+# Functional warming trains the predictor without counting lookups
+fast_forwarded = 0
+for stat, value in warm_dumps[fast_forwarded].items():
+    if stat.endswith(fast_forward_only) and value != 'nan' and \
+       float(value) != 0:
+        print("%s is %s after functional warming" % (stat, value),
+              file=sys.stderr)
+        mismatches += 1
+
+if mismatches:
+    sys.exit(1)
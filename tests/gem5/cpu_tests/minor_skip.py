@@ -0,0 +1,100 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Runs a binary on MinorCPU with and without skipping the evaluation of idle
+# pipeline stages, and with and without idling through memory stalls, and
+# checks that all the statistics match those of the pipeline evaluating
+# every stage in every cycle.
+
+import argparse
+import sys
+
+import m5
+from m5.objects import *
+
+m5.util.addToPath('../configs/')
+from stats_compare import compare_runs
+
+parser = argparse.ArgumentParser()
+parser.add_argument('binary', type = str)
+
+args = parser.parse_args()
+
+def run(skip_idle_stages, idle_on_memory_stalls):
+    system = System()
+
+    system.workload = SEWorkload.init_compatible(args.binary)
+
+    system.clk_domain = SrcClockDomain()
+    system.clk_domain.clock = '1GHz'
+    system.clk_domain.voltage_domain = VoltageDomain()
+
+    system.mem_mode = 'timing'
+    system.mem_ranges = [AddrRange('512MB')]
+
+    system.cpu = MinorCPU(skipIdleStages = skip_idle_stages,
+                          idleOnMemoryStalls = idle_on_memory_stalls,
+                          enableIdling = True)
+
+    # Small caches in front of DRAM, so that the pipeline spends cycles
+    # with idle stages, and with memory references that can't get into
+    # the LSQ, while waiting for memory
+    system.cpu.icache = Cache(size = '4kB', assoc = 2, tag_latency = 1,
+                              data_latency = 1, response_latency = 1,
+                              mshrs = 4, tgts_per_mshr = 8)
+    system.cpu.dcache = Cache(size = '4kB', assoc = 2, tag_latency = 1,
+                              data_latency = 1, response_latency = 1,
+                              mshrs = 4, tgts_per_mshr = 8)
+    system.cpu.icache.cpu_side = system.cpu.icache_port
+    system.cpu.dcache.cpu_side = system.cpu.dcache_port
+
+    system.membus = SystemXBar()
+    system.cpu.icache.mem_side = system.membus.slave
+    system.cpu.dcache.mem_side = system.membus.slave
+
+    system.cpu.createInterruptController()
+
+    system.mem_ctrl = MemCtrl(dram = DDR3_1600_8x8())
+    system.mem_ctrl.dram.range = system.mem_ranges[0]
+    system.mem_ctrl.port = system.membus.master
+    system.system_port = system.membus.slave
+
+    process = Process()
+    process.cmd = [args.binary]
+    system.cpu.workload = process
+    system.cpu.createThreads()
+
+    root = Root(full_system = False, system = system)
+    m5.instantiate()
+
+    exit_event = m5.simulate()
+
+    if exit_event.getCause() != 'exiting with last active thread context':
+        sys.exit(1)
+
+compare_runs([
+    ("every stage evaluated", lambda: run(False, False)),
+    ("skipIdleStages", lambda: run(True, False)),
+    ("idleOnMemoryStalls", lambda: run(False, True)),
+    ("skipIdleStages and idleOnMemoryStalls", lambda: run(True, True)),
+])
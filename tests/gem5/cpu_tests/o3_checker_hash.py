@@ -0,0 +1,106 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Runs a binary on the O3 CPU with a checker comparing register state
+# hashes at the end of sampled windows. Without injected errors the run
+# must complete; once the checker's registers are corrupted before a
+# hash check, the checker must detect the divergence and stop the run.
+
+import argparse
+import os
+import sys
+
+import m5
+from m5.objects import *
+
+m5.util.addToPath('../configs/')
+from stats_compare import run_forked
+
+parser = argparse.ArgumentParser()
+parser.add_argument('binary', type = str)
+
+args = parser.parse_args()
+
+def run(inject_divergence):
+    system = System()
+
+    system.workload = SEWorkload.init_compatible(args.binary)
+
+    system.clk_domain = SrcClockDomain()
+    system.clk_domain.clock = '1GHz'
+    system.clk_domain.voltage_domain = VoltageDomain()
+
+    system.mem_mode = 'timing'
+    system.mem_ranges = [AddrRange('512MB')]
+
+    system.cpu = DerivO3CPU(cpu_id = 0)
+
+    process = Process()
+    process.cmd = [args.binary]
+    system.cpu.workload = process
+
+    system.cpu.addCheckerCpu()
+    system.cpu.checker.sampleWindow = 1000
+    system.cpu.checker.samplePeriod = 10000
+    system.cpu.checker.hashCheck = True
+    system.cpu.checker.injectDivergence = inject_divergence
+
+    system.cpu.addPrivateSplitL1Caches(
+        Cache(size = '16kB', assoc = 2, tag_latency = 1, data_latency = 1,
+              response_latency = 1, mshrs = 4, tgts_per_mshr = 8),
+        Cache(size = '16kB', assoc = 2, tag_latency = 1, data_latency = 1,
+              response_latency = 1, mshrs = 4, tgts_per_mshr = 8))
+
+    system.membus = SystemXBar()
+    system.cpu.createInterruptController()
+    system.cpu.connectAllPorts(system.membus)
+
+    system.mem_ctrl = SimpleMemory(range = system.mem_ranges[0])
+    system.mem_ctrl.port = system.membus.master
+    system.system_port = system.membus.slave
+
+    system.cpu.createThreads()
+
+    root = Root(full_system = False, system = system)
+    m5.instantiate()
+
+    exit_event = m5.simulate()
+
+    if exit_event.getCause() != 'exiting with last active thread context':
+        sys.exit(1)
+
+# Sampled hash checks must not report errors on a correct execution
+run_forked("hash checks", lambda: run(0))
+
+# A corrupted register must be caught by the third hash check. The
+# checker panics on errors, so the run is expected to fail.
+sys.stdout.flush()
+pid = os.fork()
+if pid == 0:
+    run(3)
+    sys.exit(0)
+
+_, status = os.waitpid(pid, 0)
+if status == 0:
+    print("The checker missed an injected divergence", file=sys.stderr)
+    sys.exit(1)
@@ -0,0 +1,113 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Runs a binary while switching round-robin between two timing CPUs and an
+# atomic CPU. Switching between the timing CPUs keeps the memory mode, so
+# only the CPUs must be drained, while switching to and from the atomic CPU
+# must drain the whole system. The binary must produce the same output as
+# without switching.
+
+import argparse
+import sys
+
+import m5
+import _m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser()
+parser.add_argument('binary', type = str)
+parser.add_argument('--period', type = str, default = '100us',
+                    help = "Time to simulate between switches")
+
+args = parser.parse_args()
+
+system = System()
+
+system.workload = SEWorkload.init_compatible(args.binary)
+
+system.clk_domain = SrcClockDomain()
+system.clk_domain.clock = '1GHz'
+system.clk_domain.voltage_domain = VoltageDomain()
+
+system.mem_mode = 'timing'
+system.mem_ranges = [AddrRange('512MB')]
+
+system.cpu = TimingSimpleCPU(cpu_id = 0)
+system.timing_cpu = TimingSimpleCPU(cpu_id = 0, switched_out = True)
+system.atomic_cpu = AtomicSimpleCPU(cpu_id = 0, switched_out = True)
+
+system.cpu.icache = Cache(size = '4kB', assoc = 2, tag_latency = 1,
+                          data_latency = 2, response_latency = 1,
+                          mshrs = 4, tgts_per_mshr = 8)
+system.cpu.dcache = Cache(size = '4kB', assoc = 2, tag_latency = 1,
+                          data_latency = 2, response_latency = 1,
+                          mshrs = 4, tgts_per_mshr = 8)
+system.cpu.icache.cpu_side = system.cpu.icache_port
+system.cpu.dcache.cpu_side = system.cpu.dcache_port
+
+system.membus = SystemXBar()
+system.cpu.icache.mem_side = system.membus.slave
+system.cpu.dcache.mem_side = system.membus.slave
+
+system.cpu.createInterruptController()
+if m5.defines.buildEnv['TARGET_ISA'] == "x86":
+    system.cpu.interrupts[0].pio = system.membus.master
+    system.cpu.interrupts[0].int_master = system.membus.slave
+    system.cpu.interrupts[0].int_slave = system.membus.master
+
+system.mem_ctrl = SimpleMemory(range = system.mem_ranges[0])
+system.mem_ctrl.port = system.membus.master
+system.system_port = system.membus.slave
+
+process = Process()
+process.cmd = [args.binary]
+system.cpu.workload = process
+system.cpu.createThreads()
+for cpu in (system.timing_cpu, system.atomic_cpu):
+    cpu.workload = process
+    cpu.isa = system.cpu.isa
+
+root = Root(full_system = False, system = system)
+m5.instantiate()
+
+drain_manager = _m5.drain.DrainManager.instance()
+period = m5.ticks.fromSeconds(m5.util.convert.anyToLatency(args.period))
+cpus = [ system.cpu, system.timing_cpu, system.atomic_cpu ]
+cur = 0
+while True:
+    exit_event = m5.simulate(period)
+    if exit_event.getCause() == 'exiting with last active thread context':
+        break
+    if exit_event.getCause() != 'simulate() limit reached':
+        sys.exit(1)
+
+    old_cpu, new_cpu = cpus[cur], cpus[(cur + 1) % len(cpus)]
+    m5.switchCpus(system, [(old_cpu, new_cpu)], verbose = False)
+    cur = (cur + 1) % len(cpus)
+
+    partial = old_cpu.memory_mode() == new_cpu.memory_mode()
+    if drain_manager.isPartiallyDrained() != partial:
+        print("Switching from %s to %s drained %s" %
+              (old_cpu, new_cpu, "the CPUs only" if not partial else
+               "the whole system"), file=sys.stderr)
+        sys.exit(1)
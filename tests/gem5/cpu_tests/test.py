@@ -86,3 +86,99 @@ for isa in valid_isas:
                   valid_isas=(isa,),
                   fixtures=[workload_binary]
             )
+
+# MinorCPU must behave the same whether or not it skips the evaluation of
+# idle pipeline stages, and whether or not it idles through memory stalls
+for isa in valid_isas:
+    if 'MinorCPU' not in valid_isas[isa]:
+        continue
+    path = joinpath(base_path, isa.lower())
+    for workload in workloads:
+        url = isa_url[isa] + '/' + workload
+        workload_binary = DownloadedProgram(url, path, workload)
+        binary = joinpath(workload_binary.path, workload)
+
+        gem5_verify_config(
+              name='cpu_test_MinorCPU_idle_skipping_{}'.format(workload),
+              verifiers=(),
+              config=joinpath(getcwd(), 'minor_skip.py'),
+              config_args=[binary],
+              valid_isas=(isa,),
+              fixtures=[workload_binary]
+        )
+
+# The O3 CPU must produce the same statistics whether or not it skips the
+# cycles in which its pipeline is stalled on memory
+for isa in valid_isas:
+    path = joinpath(base_path, isa.lower())
+    for workload in workloads:
+        url = isa_url[isa] + '/' + workload
+        workload_binary = DownloadedProgram(url, path, workload)
+        binary = joinpath(workload_binary.path, workload)
+
+        gem5_verify_config(
+              name='cpu_test_DerivO3CPU_stall_skipping_{}'.format(workload),
+              verifiers=(),
+              config=joinpath(getcwd(), 'o3_skip.py'),
+              config_args=[binary],
+              valid_isas=(isa,),
+              fixtures=[workload_binary]
+        )
+
+# Functional warming while fast-forwarding on the atomic CPU must leave the
+# caches and the branch predictor in the state the normal atomic path does
+for isa in valid_isas:
+    path = joinpath(base_path, isa.lower())
+    for workload in workloads:
+        url = isa_url[isa] + '/' + workload
+        workload_binary = DownloadedProgram(url, path, workload)
+        binary = joinpath(workload_binary.path, workload)
+
+        gem5_verify_config(
+              name='cpu_test_AtomicSimpleCPU_warming_{}'.format(workload),
+              verifiers=(),
+              config=joinpath(getcwd(), 'atomic_warm.py'),
+              config_args=[binary],
+              valid_isas=(isa,),
+              fixtures=[workload_binary]
+        )
+
+# The O3 checker must catch a divergence in its register hash checks,
+# without reporting any on a correct execution. It is only supported on Arm.
+isa = constants.arm_tag
+path = joinpath(base_path, isa.lower())
+for workload in workloads:
+    url = isa_url[isa] + '/' + workload
+    workload_binary = DownloadedProgram(url, path, workload)
+    binary = joinpath(workload_binary.path, workload)
+
+    gem5_verify_config(
+          name='cpu_test_DerivO3CPU_checker_hash_{}'.format(workload),
+          verifiers=(
+              verifier.MatchRegex(
+                  r'^warn: \d+: Register state hashes do not match'),
+          ),
+          config=joinpath(getcwd(), 'o3_checker_hash.py'),
+          config_args=[binary],
+          valid_isas=(isa,),
+          fixtures=[workload_binary]
+    )
+
+# Switching CPUs, with and without changing the memory mode, must not
+# change the output of the workload
+for isa in valid_isas:
+    path = joinpath(base_path, isa.lower())
+    for workload in workloads:
+        ref_path = joinpath(getcwd(), 'ref', workload)
+        url = isa_url[isa] + '/' + workload
+        workload_binary = DownloadedProgram(url, path, workload)
+        binary = joinpath(workload_binary.path, workload)
+
+        gem5_verify_config(
+              name='cpu_test_switching_{}'.format(workload),
+              verifiers=(verifier.MatchStdout(ref_path),),
+              config=joinpath(getcwd(), 'switch.py'),
+              config_args=[binary],
+              valid_isas=(isa,),
+              fixtures=[workload_binary]
+        )
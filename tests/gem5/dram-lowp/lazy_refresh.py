@@ -0,0 +1,111 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Runs the same bursty traffic, with idle periods spanning many refresh
+# intervals, against a multi-rank DRAM with refreshes of idle ranks done
+# eagerly and lazily, and checks that all the statistics, including the
+# DRAMPower energy figures, match.
+
+import argparse
+
+import m5
+from m5.objects import *
+from m5.stats import periodicStatDump
+
+m5.util.addToPath('../configs/')
+from stats_compare import compare_runs
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--mem-ranks", "-r", type=int, default=2,
+                    help="Number of ranks")
+parser.add_argument("--rd-perc", type=int, default=70,
+                    help="Percentage of read commands")
+
+args = parser.parse_args()
+
+# traffic and idle periods, the latter span tens of refresh intervals
+busy_period = 20000000
+idle_period = 200000000
+num_bursts = 4
+
+# dump and reset the stats in the middle of idle periods as well
+dump_period = 50000000
+
+def run(lazy_refresh):
+    system = System(membus = IOXBar(width = 32))
+    system.clk_domain = SrcClockDomain(clock = '2.0GHz',
+                                       voltage_domain =
+                                       VoltageDomain(voltage = '1V'))
+
+    system.workload = SEWorkload()
+
+    mem_range = AddrRange('512MB')
+    system.mem_ranges = [mem_range]
+    system.mmap_using_noreserve = True
+
+    dram = DDR3_1600_8x8(range = mem_range,
+                         ranks_per_channel = args.mem_ranks,
+                         addr_mapping = 'RoRaBaCoCh',
+                         lazy_refresh = lazy_refresh,
+                         null = True)
+    system.mem_ctrl = MemCtrl(dram = dram)
+    system.mem_ctrl.port = system.membus.master
+
+    system.tgen = PyTrafficGen()
+    system.tgen.port = system.membus.slave
+    system.system_port = system.membus.slave
+
+    periodicStatDump(dump_period)
+
+    root = Root(full_system = False, system = system)
+    root.system.mem_mode = 'timing'
+
+    m5.instantiate()
+
+    nbr_banks = int(dram.banks_per_rank.value)
+    burst_size = int((dram.devices_per_rank.value *
+                      dram.device_bus_width.value *
+                      dram.burst_length.value) / 8)
+    page_size = int(dram.devices_per_rank.value *
+                    dram.device_rowbuffer_size.value)
+    itt = int(dram.tBURST.value * 1000000000000) * 4
+    addr_map = m5.objects.AddrMap.map['RoRaBaCoCh']
+
+    def trace():
+        for burst in range(num_bursts):
+            yield system.tgen.createDram(busy_period, 0, mem_range.end,
+                                         burst_size, itt, itt,
+                                         args.rd_perc, 0, 1, page_size,
+                                         nbr_banks, nbr_banks, addr_map,
+                                         args.mem_ranks)
+            yield system.tgen.createIdle(idle_period)
+        yield system.tgen.createExit(0)
+
+    system.tgen.start(trace())
+
+    exit_event = m5.simulate()
+    print("Exiting @ tick %i because %s" %
+          (m5.curTick(), exit_event.getCause()))
+
+compare_runs([("eager refresh", lambda: run(False)),
+              ("lazy refresh", lambda: run(True))])
@@ -49,3 +49,13 @@ gem5_verify_config(
     valid_isas=(constants.null_tag,),
     valid_hosts=constants.supported_hosts,
 )
+
+gem5_verify_config(
+    name='test-lazy_refresh',
+    fixtures=(),
+    verifiers=(),
+    config=joinpath(getcwd(), 'lazy_refresh.py'),
+    config_args=['-r', '2'],
+    valid_isas=(constants.null_tag,),
+    valid_hosts=constants.supported_hosts,
+)
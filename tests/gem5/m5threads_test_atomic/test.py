@@ -61,3 +61,22 @@ for cpu in cpu_types:
         valid_hosts=constants.supported_hosts,
         length = constants.long_tag,
     )
+
+# The same test on atomic CPUs, each simulated by its own host thread. The
+# threads take the lock in a different order from run to run, so only
+# check that the test passed.
+gem5_verify_config(
+    name='test-atomic-AtomicSimpleCPU-parallel-se',
+    verifiers=(verifier.MatchRegex(r'PASSED :-\)', match_stderr=False),),
+    fixtures=(test_atomic,),
+    config=joinpath(config.base_dir, 'configs', 'example', 'se.py'),
+    config_args=['--cpu-type', 'AtomicSimpleCPU',
+                 '--num-cpus', '8',
+                 '--caches',
+                 '--parallel-se',
+                 '--cmd', joinpath(base_path, binary),
+                 '--options', '8'],
+    valid_isas=(constants.sparc_tag,),
+    valid_hosts=constants.supported_hosts,
+    length = constants.long_tag,
+)
@@ -0,0 +1,126 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Runs a binary with and without a sparse memory, and checks that the
+# memory being sparse only shows in its page tracking statistics: the
+# reads served as zeros from unwritten pages, the zero writes skipped,
+# and the number of pages that had to be written.
+
+import argparse
+import sys
+
+import m5
+from m5.objects import *
+
+m5.util.addToPath('../configs/')
+from stats_compare import compare_runs
+
+parser = argparse.ArgumentParser()
+parser.add_argument('--cpu', type = str, default = 'AtomicSimpleCPU',
+                    choices = ('AtomicSimpleCPU', 'NonCachingSimpleCPU'))
+parser.add_argument('binary', type = str)
+
+args = parser.parse_args()
+
+mem_size = 512 * 1024 * 1024
+sparse_stats = ('pagesWritten', 'zeroPageReads', 'zeroPageWrites')
+
+def run(sparse):
+    system = System()
+
+    system.workload = SEWorkload.init_compatible(args.binary)
+
+    system.clk_domain = SrcClockDomain()
+    system.clk_domain.clock = '1GHz'
+    system.clk_domain.voltage_domain = VoltageDomain()
+
+    # The non-caching CPU fetches through the backdoor of the memory,
+    # which is read-only when the memory is sparse
+    if args.cpu == 'NonCachingSimpleCPU':
+        system.mem_mode = 'atomic_noncaching'
+        system.cpu = NonCachingSimpleCPU()
+    else:
+        system.mem_mode = 'atomic'
+        system.cpu = AtomicSimpleCPU()
+    system.mem_ranges = [AddrRange(mem_size)]
+
+    system.membus = SystemXBar()
+    system.cpu.icache_port = system.membus.slave
+    system.cpu.dcache_port = system.membus.slave
+
+    system.cpu.createInterruptController()
+    if m5.defines.buildEnv['TARGET_ISA'] == "x86":
+        system.cpu.interrupts[0].pio = system.membus.master
+        system.cpu.interrupts[0].int_master = system.membus.slave
+        system.cpu.interrupts[0].int_slave = system.membus.master
+
+    system.mem_ctrl = SimpleMemory(range = system.mem_ranges[0],
+                                   sparse = sparse)
+    system.mem_ctrl.port = system.membus.master
+    system.system_port = system.membus.slave
+
+    process = Process()
+    process.cmd = [args.binary]
+    system.cpu.workload = process
+    system.cpu.createThreads()
+
+    root = Root(full_system = False, system = system)
+    m5.instantiate()
+
+    exit_event = m5.simulate()
+
+    if exit_event.getCause() != 'exiting with last active thread context':
+        sys.exit(1)
+
+dumps = compare_runs([
+    ("dense memory", lambda: run(False)),
+    ("sparse memory", lambda: run(True)),
+], ignore = sparse_stats)
+
+def stat(dump, name):
+    return int(float(dump.get('system.mem_ctrl.' + name, 0)))
+
+# The statistics are only reported by the sparse memory
+dense, sparse = dumps[0][-1], dumps[1][-1]
+for name in sparse_stats:
+    if stat(dense, name):
+        print("%s reported by the dense memory" % name, file=sys.stderr)
+        sys.exit(1)
+
+pages = mem_size // 4096
+failed = False
+if not 0 < stat(sparse, 'pagesWritten') < pages:
+    print("%d of %d pages written" % (stat(sparse, 'pagesWritten'), pages),
+          file=sys.stderr)
+    failed = True
+for name in ('zeroPageReads', 'zeroPageWrites'):
+    if not stat(sparse, name):
+        print("No %s" % name, file=sys.stderr)
+        failed = True
+
+if failed:
+    sys.exit(1)
+
+print("%d of %d pages written, %d zero reads, %d zero writes skipped" %
+      tuple([stat(sparse, 'pagesWritten'), pages] +
+            [stat(sparse, name) for name in sparse_stats[1:]]))
@@ -67,6 +67,33 @@ gem5_verify_config(
     valid_isas=(constants.null_tag,),
 )
 
+# The DRAM controller checks each of its FR-FCFS decisions against a scan
+# of the whole queue, and panics on a mismatch
+for page_policy in ('open', 'open_adaptive', 'close', 'close_adaptive'):
+    gem5_verify_config(
+        name='memtest-dram-' + page_policy,
+        verifiers=(), # No need for verfiers this will return non-zero on fail
+        config=joinpath(getcwd(), 'memtest-dram-run.py'),
+        config_args = ['--page-policy', page_policy],
+        valid_isas=(constants.null_tag,),
+    )
+
+gem5_verify_config(
+    name='memtest-dram-bank-groups',
+    verifiers=(), # No need for verfiers this will return non-zero on fail
+    config=joinpath(getcwd(), 'memtest-dram-run.py'),
+    config_args = ['--dram-type', 'DDR4_2400_16x4'],
+    valid_isas=(constants.null_tag,),
+)
+
+gem5_verify_config(
+    name='memtest-dram-nvm',
+    verifiers=(), # No need for verfiers this will return non-zero on fail
+    config=joinpath(getcwd(), 'memtest-dram-run.py'),
+    config_args = ['--nvm'],
+    valid_isas=(constants.null_tag,),
+)
+
 null_tests = [
     ('garnet_synth_traffic', ['--sim-cycles', '5000000']),
     ('memcheck', ['--maxtick', '2000000000', '--prefetchers']),
@@ -87,3 +114,27 @@ for basename_noext, args in null_tests:
         valid_isas=(constants.null_tag,),
         valid_hosts=constants.supported_hosts,
     )
+
+# A sparse memory must behave as a dense one, whether it is accessed
+# through packets or through its read-only backdoor
+sparse_progs = {
+    constants.gcn3_x86_tag : ('x86', 'hello64-static'),
+    constants.arm_tag : ('arm', 'hello64-static'),
+    constants.riscv_tag : ('riscv', 'hello'),
+}
+
+for isa, (isa_dir, binary) in sparse_progs.items():
+    url = config.resource_url + '/test-progs/hello/bin/' + isa_dir + \
+        '/linux/' + binary
+    path = joinpath(config.bin_path, 'hello', isa.lower())
+    hello_program = DownloadedProgram(url, path, binary)
+
+    for cpu in ('AtomicSimpleCPU', 'NonCachingSimpleCPU'):
+        gem5_verify_config(
+            name='sparse_mem_' + cpu + '_' + binary,
+            fixtures=(hello_program,),
+            verifiers=(), # The config checks the stats and fails on error
+            config=joinpath(getcwd(), 'sparse.py'),
+            config_args=['--cpu', cpu, joinpath(path, binary)],
+            valid_isas=(isa,),
+        )
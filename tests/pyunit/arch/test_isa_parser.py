@@ -0,0 +1,165 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import os
+import sys
+import unittest
+
+_root = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                     os.pardir, os.pardir, os.pardir)
+for path in (('ext', 'ply'), ('src', 'arch')):
+    sys.path.insert(0, os.path.join(_root, *path))
+
+from isa_parser import ISAParser
+from isa_parser.util import matchingBrace
+
+header = '''
+    class Add : public RegRegOp
+    {
+      public:
+        Add(ExtMachInst machInst);
+        Fault execute(ExecContext *, Trace::InstRecord *) const override;
+    };
+
+    class Lr : public LoadReserved
+    {
+      public:
+        Lr(ExtMachInst machInst);
+
+      protected:
+        class LrMicro;
+    };
+
+    class Lr::LrMicro : public LoadReservedMicro
+    {
+      public:
+        LrMicro(ExtMachInst machInst, Lr *_p);
+        Fault execute(ExecContext *, Trace::InstRecord *) const override;
+    };
+
+    template <class Element>
+    class Ld : public MemOp
+    {
+      public:
+        Fault execute(ExecContext *, Trace::InstRecord *) const override;
+    };
+'''
+
+add_body = '''{
+        // Braces in comments: }
+        Rd = Rs1 + Rs2;
+        DPRINTF(Exec, "}{%d\\\\n", '}');
+        return NoFault;
+    }'''
+
+lr_body = '''{
+        if (true) {
+            return NoFault;
+        }
+        return NoFault;
+    }'''
+
+exec_code = '''
+    Fault
+    Add::execute(ExecContext *xc, Trace::InstRecord *traceData) const
+    %s
+
+    Fault
+    Lr::LrMicro::execute(
+        ExecContext *xc, Trace::InstRecord *traceData) const
+    %s
+
+    template <class Element>
+    Fault
+    Ld<Element>::execute(ExecContext *xc,
+            Trace::InstRecord *traceData) const
+    {
+        return NoFault;
+    }
+
+    Fault
+    Sub::execute(ExecContext *xc, Trace::InstRecord *traceData) const
+    {
+        return NoFault;
+    }
+''' % (add_body, lr_body)
+
+class SimpleExecuteTestSuite(unittest.TestCase):
+    """Test cases for the execute() variants generated for the simple CPUs"""
+
+    def parse(self, specialize=True):
+        parser = ISAParser('.', specialize)
+        return (parser.declareSimpleExecute(header),
+                parser.defineSimpleExecute(exec_code))
+
+    def test_disabled(self):
+        self.assertEqual(self.parse(False), (header, exec_code))
+
+    def test_declarations(self):
+        decls, _ = self.parse()
+
+        # One set of declarations per execute() declaration, indented
+        # alike, including in templates which then just go unused
+        for decl in ('Fault executeSimple(SimpleExecContext *, '
+                     'Trace::InstRecord *) const;',
+                     'static const bool simpleExecuteRegistered;',
+                     'const bool simpleExecuteSet = '
+                     'setSimpleExecute(typeid(*this));'):
+            self.assertEqual(decls.count('\n        ' + decl + '\n'), 3)
+
+    def test_definitions(self):
+        _, defs = self.parse()
+
+        # The variant gets a copy of the body of execute(), including
+        # braces in comments and literals
+        self.assertIn('\nFault\nAdd::executeSimple(SimpleExecContext *xc,\n'
+                      '        Trace::InstRecord *traceData) const\n' +
+                      add_body + '\n', defs)
+        self.assertIn('\nFault\nLr::LrMicro::executeSimple('
+                      'SimpleExecContext *xc,\n'
+                      '        Trace::InstRecord *traceData) const\n' +
+                      lr_body + '\n', defs)
+
+        # Nested classes are registered under their qualified name
+        self.assertIn('const bool Add::simpleExecuteRegistered =\n'
+                      '    StaticInst::registerSimpleExecute(typeid(Add),',
+                      defs)
+        self.assertIn('const bool Lr::LrMicro::simpleExecuteRegistered =\n'
+                      '    StaticInst::registerSimpleExecute('
+                      'typeid(Lr::LrMicro),', defs)
+
+        # Templates and classes without a declaration get no variant
+        self.assertEqual(defs.count('::executeSimple('), 2)
+        self.assertEqual(defs.count('::simpleExecuteRegistered ='), 2)
+
+        # The variants are only added after the original definitions
+        for class_name in ('Add', 'Lr::LrMicro'):
+            start = defs.index('\n\nFault\n%s::executeSimple(' % class_name)
+            end = defs.index('});\n', start) + len('});\n')
+            defs = defs[:start] + defs[end:]
+        self.assertEqual(defs, exec_code)
+
+    def test_matching_brace(self):
+        code = 'f() { a = "}"; /* } */ if (b) { c(); } // }\n}'
+        self.assertEqual(matchingBrace(code, code.index('{')), len(code) - 1)
+        self.assertIsNone(matchingBrace('{ { }', 0))
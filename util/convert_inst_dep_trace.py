@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script converts a protobuf trace of the instruction dependency
+# graph, as written by the ElasticTrace probe, into the uncompressed
+# binary format that the TraceCPU can memory map instead of decoding
+# protobuf messages.
+#
+# All fields are little endian. The file starts with a 24-byte header:
+#
+#   uint32 magic ("gEDT"), uint32 version (1), uint32 window_size,
+#   uint32 reserved, uint64 tick_freq
+#
+# followed by one record per instruction, each made of a 64-byte fixed
+# part and the dependency lists:
+#
+#   uint64 seq_num, p_addr, v_addr, pc, comp_delay
+#   uint32 size, flags, weight
+#   uint16 num_rob_dep, num_reg_dep
+#   uint8 type, 7 reserved bytes
+#   uint64 rob_dep[num_rob_dep], reg_dep[num_reg_dep]
+#
+# Optional fields that are absent in the protobuf record are written as
+# zero, which is also the value the TraceCPU assumes for them.
+
+import protolib
+import struct
+import sys
+
+# Import the packet proto definitions. If they are not found, attempt
+# to generate them automatically. This assumes that the script is
+# executed from the gem5 root.
+try:
+    import inst_dep_record_pb2
+except:
+    print("Did not find proto definition, attempting to generate")
+    from subprocess import call
+    error = call(['protoc', '--python_out=util', '--proto_path=src/proto',
+                  'src/proto/inst_dep_record.proto'])
+    if not error:
+        import inst_dep_record_pb2
+        print("Generated proto definitions for instruction dependency record")
+    else:
+        print("Failed to import proto definitions")
+        exit(-1)
+
+binary_magic = b'gEDT'
+binary_version = 1
+
+header_fmt = struct.Struct('<4sIIIQ')
+record_fmt = struct.Struct('<QQQQQIIIHHB7x')
+
+def main():
+    if len(sys.argv) != 3:
+        print("Usage: ", sys.argv[0], " <protobuf input> <binary output>")
+        exit(-1)
+
+    # Open the file on read mode
+    proto_in = protolib.openFileRd(sys.argv[1])
+
+    try:
+        binary_out = open(sys.argv[2], 'wb')
+    except IOError:
+        print("Failed to open ", sys.argv[2], " for writing")
+        exit(-1)
+
+    # Read the magic number in 4-byte Little Endian
+    magic_number = proto_in.read(4)
+
+    if magic_number != b"gem5":
+        print("Unrecognized file")
+        exit(-1)
+
+    print("Parsing packet header")
+
+    header = inst_dep_record_pb2.InstDepRecordHeader()
+    protolib.decodeMessage(proto_in, header)
+
+    print("Window size:", header.window_size)
+    print("Tick frequency:", header.tick_freq)
+
+    binary_out.write(header_fmt.pack(binary_magic, binary_version,
+                                     header.window_size, 0,
+                                     header.tick_freq))
+
+    print("Converting packets")
+
+    num_packets = 0
+    packet = inst_dep_record_pb2.InstDepRecord()
+
+    # Decode the packet messages until we hit the end of the file
+    while protolib.decodeMessage(proto_in, packet):
+        num_packets += 1
+
+        if len(packet.rob_dep) > 0xffff or len(packet.reg_dep) > 0xffff:
+            print("Seq. num", packet.seq_num, "has too many dependencies")
+            exit(-1)
+
+        binary_out.write(record_fmt.pack(packet.seq_num, packet.p_addr,
+                                         packet.v_addr, packet.pc,
+                                         packet.comp_delay, packet.size,
+                                         packet.flags, packet.weight,
+                                         len(packet.rob_dep),
+                                         len(packet.reg_dep),
+                                         packet.type))
+        deps = list(packet.rob_dep) + list(packet.reg_dep)
+        binary_out.write(struct.pack('<%dQ' % len(deps), *deps))
+
+    print("Converted packets:", num_packets)
+
+    # We're done
+    proto_in.close()
+    binary_out.close()
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script converts the binary basic block vector (BBV) profile
+# written by the SimPoint probe (binary_profile = True) back to the text
+# format read by the SimPoint tool.
+#
+# The file starts with a 16-byte little endian header:
+#
+#   uint32 magic ("gBBV"), uint32 version (1), uint64 interval_size
+#
+# followed by one record per interval, made of LEB128 varints: the
+# number of basic blocks executed in the interval, then a (basic block
+# ID delta, instruction count) pair per block, in increasing ID order.
+#
+# Usage: decode_simpoint_bbv.py <binary BBV file> <text BBV file>
+# Both files are gzipped if their name ends in .gz.
+
+import gzip
+import struct
+import sys
+
+magic = 0x56424267
+version = 1
+
+def open_file(name, mode):
+    if name.endswith('.gz'):
+        return gzip.open(name, mode)
+    return open(name, mode)
+
+def read_varint(data, pos):
+    val = 0
+    shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        val |= (byte & 0x7f) << shift
+        if not byte & 0x80:
+            return val, pos
+        shift += 7
+
+def main():
+    if len(sys.argv) != 3:
+        print("Usage: ", sys.argv[0], " <binary BBV file> <text BBV file>")
+        exit(-1)
+
+    with open_file(sys.argv[1], 'rb') as f:
+        data = f.read()
+
+    file_magic, file_version, interval = struct.unpack_from('<IIQ', data)
+    if file_magic != magic:
+        print("Not a binary BBV file")
+        exit(-1)
+    if file_version != version:
+        print("Unsupported binary BBV version", file_version)
+        exit(-1)
+    print("Interval size:", interval)
+
+    num_intervals = 0
+    pos = struct.calcsize('<IIQ')
+    with open_file(sys.argv[2], 'wt') as out:
+        while pos < len(data):
+            num_bbs, pos = read_varint(data, pos)
+            line = ["T"]
+            bb_id = 0
+            for i in range(num_bbs):
+                delta, pos = read_varint(data, pos)
+                count, pos = read_varint(data, pos)
+                bb_id += delta
+                line.append(":%d:%d " % (bb_id, count))
+            out.write("".join(line) + "\n")
+            num_intervals += 1
+
+    print("Converted", num_intervals, "intervals")
+
+if __name__ == "__main__":
+    main()